@@ -408,6 +408,28 @@
 #define EFI_PERF_METRICS FALSE
 #endif
 
+// per engine module callback timing, "moduleprofile" console command and module* output channels
+// about 2K of RAM and two cycle counter reads per module call, enable in board configuration when needed
+#ifndef EFI_MODULE_PROFILER
+#define EFI_MODULE_PROFILER FALSE
+#endif
+
+// scheduled event lateness and callback duration histograms, "eventtiming" console command
+#ifndef EFI_EVENT_TIMING_STATS
+#define EFI_EVENT_TIMING_STATS TRUE
+#endif
+
+// software PWMs on the main scheduler share timer events, "pwmgroupinfo" console command
+// not validated on hardware yet, enable in board configuration
+#ifndef EFI_PWM_GROUP
+#define EFI_PWM_GROUP FALSE
+#endif
+
+// fast callback recomputes slow moving corrections only once their inputs move
+#ifndef EFI_INCREMENTAL_ENGINE_STATE
+#define EFI_INCREMENTAL_ENGINE_STATE TRUE
+#endif
+
 #ifndef DL_OUTPUT_BUFFER
 #define DL_OUTPUT_BUFFER 6500
 #endif
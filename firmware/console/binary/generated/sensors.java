@@ -330,54 +330,45 @@ hp("hp", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 802, 1.0, -1.0, -1.0, ""
 torque("torque", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 804, 1.0, -1.0, -1.0, ""),
 alignmentFill_at_806("need 4 byte alignment", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 806, 1.0, -20.0, 100.0, "units"),
 mcuSerial("mcuSerial", SensorCategory.SENSOR_INPUTS, FieldType.INT, 808, 1.0, 0.0, 4.294967295E9, ""),
-unusedAtTheEnd1("unusedAtTheEnd 1", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 812, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd2("unusedAtTheEnd 2", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 813, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd3("unusedAtTheEnd 3", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 814, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd4("unusedAtTheEnd 4", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 815, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd5("unusedAtTheEnd 5", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 816, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd6("unusedAtTheEnd 6", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 817, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd7("unusedAtTheEnd 7", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 818, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd8("unusedAtTheEnd 8", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 819, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd9("unusedAtTheEnd 9", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 820, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd10("unusedAtTheEnd 10", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 821, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd11("unusedAtTheEnd 11", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 822, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd12("unusedAtTheEnd 12", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 823, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd13("unusedAtTheEnd 13", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 824, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd14("unusedAtTheEnd 14", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 825, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd15("unusedAtTheEnd 15", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 826, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd16("unusedAtTheEnd 16", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 827, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd17("unusedAtTheEnd 17", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 828, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd18("unusedAtTheEnd 18", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 829, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd19("unusedAtTheEnd 19", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 830, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd20("unusedAtTheEnd 20", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 831, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd21("unusedAtTheEnd 21", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 832, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd22("unusedAtTheEnd 22", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 833, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd23("unusedAtTheEnd 23", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 834, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd24("unusedAtTheEnd 24", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 835, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd25("unusedAtTheEnd 25", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 836, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd26("unusedAtTheEnd 26", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 837, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd27("unusedAtTheEnd 27", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 838, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd28("unusedAtTheEnd 28", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 839, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd29("unusedAtTheEnd 29", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 840, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd30("unusedAtTheEnd 30", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 841, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd31("unusedAtTheEnd 31", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 842, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd32("unusedAtTheEnd 32", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 843, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd33("unusedAtTheEnd 33", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 844, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd34("unusedAtTheEnd 34", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 845, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd35("unusedAtTheEnd 35", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 846, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd36("unusedAtTheEnd 36", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 847, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd37("unusedAtTheEnd 37", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 848, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd38("unusedAtTheEnd 38", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 849, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd39("unusedAtTheEnd 39", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 850, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd40("unusedAtTheEnd 40", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 851, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd41("unusedAtTheEnd 41", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 852, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd42("unusedAtTheEnd 42", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 853, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd43("unusedAtTheEnd 43", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 854, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd44("unusedAtTheEnd 44", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 855, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd45("unusedAtTheEnd 45", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 856, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd46("unusedAtTheEnd 46", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 857, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd47("unusedAtTheEnd 47", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 858, 1.0, 0.0, 0.0, ""),
-unusedAtTheEnd48("unusedAtTheEnd 48", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 859, 1.0, 0.0, 0.0, ""),
+canListenerHitCounter("CAN: listener hits", SensorCategory.SENSOR_INPUTS, FieldType.INT, 812, 1.0, 0.0, 0.0, "count"),
+canListenersById("CAN: listeners by ID", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 816, 1.0, 0.0, 255.0, "count"),
+canListenersMasked("CAN: listeners by mask", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 817, 1.0, 0.0, 255.0, "count"),
+canListenersLastVisited("CAN: listeners offered last frame", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 818, 1.0, 0.0, 255.0, "count"),
+luaCanRxQueueHighWater("Lua: CAN RX queue high water", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 819, 1.0, 0.0, 255.0, "frames"),
+luaCanRxDropCounter("Lua: CAN RX dropped frames", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 820, 1.0, 0.0, 65535.0, "count"),
+luaCanRxOverflowCounter("Lua: CAN RX queue overflows", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 822, 1.0, 0.0, 65535.0, "count"),
+moduleFastPassMaxUs("Modules: fast pass max", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 824, 1.0, 0.0, 65535.0, "us"),
+moduleSlowPassMaxUs("Modules: slow pass max", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 826, 1.0, 0.0, 65535.0, "us"),
+moduleOverrunCount("Modules: overruns", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 828, 1.0, 0.0, 65535.0, "count"),
+moduleSlowestMaxUs("Modules: slowest module max", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 830, 1.0, 0.0, 65535.0, "us"),
+moduleSlowestIndex("Modules: slowest module", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 832, 1.0, 0.0, 255.0, "index"),
+unusedAtTheEnd1("unusedAtTheEnd 1", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 833, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd2("unusedAtTheEnd 2", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 834, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd3("unusedAtTheEnd 3", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 835, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd4("unusedAtTheEnd 4", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 836, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd5("unusedAtTheEnd 5", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 837, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd6("unusedAtTheEnd 6", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 838, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd7("unusedAtTheEnd 7", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 839, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd8("unusedAtTheEnd 8", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 840, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd9("unusedAtTheEnd 9", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 841, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd10("unusedAtTheEnd 10", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 842, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd11("unusedAtTheEnd 11", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 843, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd12("unusedAtTheEnd 12", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 844, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd13("unusedAtTheEnd 13", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 845, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd14("unusedAtTheEnd 14", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 846, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd15("unusedAtTheEnd 15", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 847, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd16("unusedAtTheEnd 16", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 848, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd17("unusedAtTheEnd 17", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 849, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd18("unusedAtTheEnd 18", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 850, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd19("unusedAtTheEnd 19", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 851, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd20("unusedAtTheEnd 20", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 852, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd21("unusedAtTheEnd 21", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 853, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd22("unusedAtTheEnd 22", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 854, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd23("unusedAtTheEnd 23", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 855, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd24("unusedAtTheEnd 24", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 856, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd25("unusedAtTheEnd 25", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 857, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd26("unusedAtTheEnd 26", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 858, 1.0, 0.0, 0.0, ""),
+unusedAtTheEnd27("unusedAtTheEnd 27", SensorCategory.SENSOR_INPUTS, FieldType.INT8, 859, 1.0, 0.0, 0.0, ""),
 totalFuelCorrection("Fuel: Total correction", SensorCategory.SENSOR_INPUTS, FieldType.INT, 860, 1.0, 0.0, 3.0, "mult"),
 running("running", SensorCategory.SENSOR_INPUTS, FieldType.INT, 864, 1.0, -1.0, -1.0, ""),
 afrTableYAxis("afrTableYAxis", SensorCategory.SENSOR_INPUTS, FieldType.INT16, 884, 0.01, 0.0, 0.0, "%"),
@@ -0,0 +1,192 @@
+/**
+ * @file live_data_delta.h
+ *
+ * Delta compressed output channels for slow links: instead of the whole requested range
+ * we only send the bytes which have changed since the previous response on the same link.
+ * The baseline is what one particular client has seen, a user switching to another client has to
+ * reset() it.
+ *
+ * Response payload is [type][sequence] followed by
+ *   LIVE_DATA_KEYFRAME: all requested bytes
+ *   LIVE_DATA_DELTA: runs of [unchanged byte count][changed byte count][changed bytes],
+ *   everything past the last run is unchanged
+ * Run lengths are one byte each, longer gaps or changes are split in to several runs.
+ *
+ * We send a keyframe on the first request, whenever the requested range was not sent
+ * before, every LIVE_DATA_KEYFRAME_PERIOD responses, on client request (after a lost response for
+ * instance), and whenever the delta would not be smaller than a keyframe. A response never
+ * exceeds a keyframe in size.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#define LIVE_DATA_KEYFRAME 0
+#define LIVE_DATA_DELTA 1
+
+#define LIVE_DATA_DELTA_HEADER_SIZE 2
+
+// request flag: client has lost track, send everything
+#define LIVE_DATA_FORCE_KEYFRAME 1
+
+#ifndef LIVE_DATA_KEYFRAME_PERIOD
+#define LIVE_DATA_KEYFRAME_PERIOD 50
+#endif
+
+template<size_t TTotalSize>
+class LiveDataDelta {
+public:
+	/**
+	 * @param read fills (uint8_t* destination, size_t offset, size_t size) with current live data
+	 * @param out at least LIVE_DATA_DELTA_HEADER_SIZE + count bytes
+	 * @return payload size
+	 */
+	template<typename TRead>
+	size_t encode(size_t offset, size_t count, uint16_t flags, TRead read, uint8_t* out) {
+		out[1] = m_sequence++;
+
+		bool needKeyframe = (flags & LIVE_DATA_FORCE_KEYFRAME) || ++m_sinceKeyframe >= LIVE_DATA_KEYFRAME_PERIOD;
+		for (size_t i = offset; i < offset + count && !needKeyframe; i++) {
+			needKeyframe = !isKnown(i);
+		}
+
+		if (needKeyframe) {
+			return writeKeyframe(offset, count, read, out);
+		}
+
+		size_t deltaSize = writeDelta(offset, count, read, out);
+		if (deltaSize == 0) {
+			// delta would not be any smaller, m_previous is up to date by now
+			fallbackCounter++;
+			return writeKeyframeFromPrevious(offset, count, out);
+		}
+
+		deltaCounter++;
+		return deltaSize;
+	}
+
+	/**
+	 * forget what the client has seen, next response is a keyframe
+	 */
+	void reset() {
+		memset(m_known, 0, sizeof(m_known));
+		m_sinceKeyframe = 0;
+	}
+
+	uint32_t keyframeCounter = 0;
+	uint32_t deltaCounter = 0;
+	// deltas which turned in to a keyframe since too much has changed
+	uint32_t fallbackCounter = 0;
+
+private:
+	static constexpr size_t chunkSize = 32;
+
+	template<typename TRead>
+	size_t writeKeyframe(size_t offset, size_t count, TRead read, uint8_t* out) {
+		read(&m_previous[offset], offset, count);
+		return writeKeyframeFromPrevious(offset, count, out);
+	}
+
+	size_t writeKeyframeFromPrevious(size_t offset, size_t count, uint8_t* out) {
+		out[0] = LIVE_DATA_KEYFRAME;
+		memcpy(out + LIVE_DATA_DELTA_HEADER_SIZE, &m_previous[offset], count);
+
+		for (size_t i = offset; i < offset + count; i++) {
+			m_known[i / 8] |= 1 << (i % 8);
+		}
+
+		m_sinceKeyframe = 0;
+		keyframeCounter++;
+		return LIVE_DATA_DELTA_HEADER_SIZE + count;
+	}
+
+	// returns 0 if the delta would not be smaller than a keyframe, m_previous is updated either way
+	template<typename TRead>
+	size_t writeDelta(size_t offset, size_t count, TRead read, uint8_t* out) {
+		out[0] = LIVE_DATA_DELTA;
+
+		// anything as large as a keyframe is not worth it
+		const size_t limit = LIVE_DATA_DELTA_HEADER_SIZE + count;
+		size_t position = LIVE_DATA_DELTA_HEADER_SIZE;
+		bool overflow = false;
+
+		size_t gap = 0;
+		// position of the length byte of the run we are in, 0 if not in a run
+		size_t runLengthPosition = 0;
+
+		uint8_t chunk[chunkSize];
+		for (size_t chunkStart = offset; chunkStart < offset + count; chunkStart += chunkSize) {
+			size_t size = offset + count - chunkStart;
+			if (size > chunkSize) {
+				size = chunkSize;
+			}
+			read(chunk, chunkStart, size);
+
+			for (size_t i = 0; i < size; i++) {
+				uint8_t& previous = m_previous[chunkStart + i];
+				bool isChanged = chunk[i] != previous;
+				previous = chunk[i];
+
+				if (overflow) {
+					// keep scanning so that m_previous holds all of the current data
+					continue;
+				}
+
+				if (!isChanged) {
+					runLengthPosition = 0;
+					gap++;
+					continue;
+				}
+
+				if (runLengthPosition == 0) {
+					// start a new run: header plus at least one byte
+					while (gap > 255) {
+						if (position + 2 > limit) {
+							overflow = true;
+							break;
+						}
+						out[position++] = 255;
+						out[position++] = 0;
+						gap -= 255;
+					}
+
+					if (overflow || position + 3 > limit) {
+						overflow = true;
+						continue;
+					}
+
+					out[position++] = gap;
+					runLengthPosition = position;
+					out[position++] = 0;
+					gap = 0;
+				} else if (position + 1 > limit) {
+					overflow = true;
+					continue;
+				}
+
+				out[position++] = chunk[i];
+				if (++out[runLengthPosition] == 255) {
+					// run is full, next changed byte starts a new one right away
+					runLengthPosition = 0;
+				}
+			}
+		}
+
+		return overflow ? 0 : position;
+	}
+
+	bool isKnown(size_t index) const {
+		return m_known[index / 8] & (1 << (index % 8));
+	}
+
+	uint8_t m_sequence = 0;
+	uint16_t m_sinceKeyframe = 0;
+
+	// what the client has as of our last response
+	uint8_t m_previous[TTotalSize];
+	// which bytes of m_previous the client has ever received
+	uint8_t m_known[(TTotalSize + 7) / 8] = {};
+};
@@ -0,0 +1,87 @@
+/**
+ * @file live_data_subscription.cpp
+ */
+
+#include "pch.h"
+
+#include "live_data_subscription.h"
+#include "live_data.h"
+
+#define TIMESTAMP_SIZE 4
+
+// same packing as highSpeedOffsets: type in the top 3 bits, size is 1 << (type - 1)
+static size_t getEntrySize(uint16_t packed) {
+	uint16_t type = packed >> 13;
+	return type == 0 ? 0 : 1 << (type - 1);
+}
+
+static uint16_t getEntryOffset(uint16_t packed) {
+	return packed & 0x1FFF;
+}
+
+bool LiveDataSubscription::subscribe(const uint8_t* request, size_t size, efitick_t nowNt) {
+	m_count = 0;
+
+	if (size < 2 || size % 2 != 0) {
+		return false;
+	}
+
+	const uint16_t* request16 = reinterpret_cast<const uint16_t*>(request);
+	uint16_t periodMs = request16[0];
+	size_t count = size / 2 - 1;
+
+	if (count > HIGH_SPEED_COUNT) {
+		return false;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		uint16_t packed = request16[1 + i];
+		size_t entrySize = getEntrySize(packed);
+		if (entrySize > 8 || getEntryOffset(packed) + entrySize > TS_TOTAL_OUTPUT_SIZE) {
+			return false;
+		}
+
+		m_entries[i] = packed;
+	}
+
+	if (periodMs == 0) {
+		// that's an unsubscribe
+		return true;
+	}
+
+	m_count = count;
+	m_period = MS2NT(periodMs);
+	m_nextPushNt = nowNt;
+	m_lastRequestNt = nowNt;
+
+	return true;
+}
+
+size_t LiveDataSubscription::getPayloadSize() const {
+	size_t size = TIMESTAMP_SIZE;
+	for (size_t i = 0; i < m_count; i++) {
+		size += getEntrySize(m_entries[i]);
+	}
+	return size;
+}
+
+size_t LiveDataSubscription::writeSnapshot(uint8_t* out, efitick_t nowNt) {
+	uint32_t timestampUs = NT2US(nowNt);
+	memcpy(out, &timestampUs, TIMESTAMP_SIZE);
+
+	size_t position = TIMESTAMP_SIZE;
+	for (size_t i = 0; i < m_count; i++) {
+		size_t entrySize = getEntrySize(m_entries[i]);
+		copyRange(out + position, getLiveDataFragments(), getEntryOffset(m_entries[i]), entrySize);
+		position += entrySize;
+	}
+
+	// keep the cadence, but don't try to catch up after a long command
+	m_nextPushNt += m_period;
+	if (m_nextPushNt < nowNt) {
+		m_nextPushNt = nowNt + m_period;
+	}
+
+	pushCounter++;
+	return position;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file live_data_subscription.h
+ *
+ * Push mode output channels: the client subscribes once with a scatter list (same encoding as
+ * highSpeedOffsets) and a period, after that the TS thread sends a TS_RESPONSE_OUTPUT_PUSH frame
+ * every period without any further requests. Nothing is pushed unless the client has subscribed.
+ * A push only goes out once the link has been quiet until it is due, never while a request is
+ * being received or answered, so that half-duplex links do not see collisions. A busy client
+ * therefore delays pushes rather than interleaving with them.
+ *
+ * Subscribe request: [TS_OUTPUT_SUBSCRIBE_COMMAND][period ms, uint16][packed offset, uint16]...
+ * zero period or no entries cancel the subscription.
+ * Pushed payload: [timestamp us, uint32][values in the order of the scatter list]
+ *
+ * Subscription is dropped if the client did not send anything for LIVE_DATA_SUBSCRIPTION_TIMEOUT_MS,
+ * any valid command, including another subscribe, keeps it alive.
+ */
+
+#pragma once
+
+#include "efitime.h"
+
+#ifndef LIVE_DATA_SUBSCRIPTION_TIMEOUT_MS
+#define LIVE_DATA_SUBSCRIPTION_TIMEOUT_MS 3000
+#endif
+
+class LiveDataSubscription {
+public:
+	/**
+	 * @return false if the request is malformed, the subscription is cancelled in that case
+	 */
+	bool subscribe(const uint8_t* request, size_t size, efitick_t nowNt);
+
+	void cancel() {
+		m_count = 0;
+	}
+
+	// Client has sent a valid command
+	void onRequest(efitick_t nowNt) {
+		m_lastRequestNt = nowNt;
+	}
+
+	bool isActive(efitick_t nowNt) const {
+		return m_count > 0 && nowNt - m_lastRequestNt < MS2NT(LIVE_DATA_SUBSCRIPTION_TIMEOUT_MS);
+	}
+
+	bool isDue(efitick_t nowNt) const {
+		return isActive(nowNt) && nowNt >= m_nextPushNt;
+	}
+
+	efitick_t getTimeUntilDue(efitick_t nowNt) const {
+		return nowNt >= m_nextPushNt ? 0 : m_nextPushNt - nowNt;
+	}
+
+	size_t getPayloadSize() const;
+
+	/**
+	 * Fills out with one snapshot and schedules the next one
+	 * @return payload size
+	 */
+	size_t writeSnapshot(uint8_t* out, efitick_t nowNt);
+
+	uint32_t pushCounter = 0;
+
+private:
+	uint16_t m_entries[HIGH_SPEED_COUNT];
+	size_t m_count = 0;
+
+	efitick_t m_period = 0;
+	efitick_t m_nextPushNt = 0;
+	efitick_t m_lastRequestNt = 0;
+};
@@ -77,6 +77,7 @@
 #include "electronic_throttle.h"
 #include "live_data.h"
 #include "efi_quote.h"
+#include "crc32_fast.h"
 
 #include <string.h>
 #include "bench_test.h"
@@ -137,6 +138,7 @@ static void printTsStats(void) {
 	printErrorCounters();
 
 	printScatterList();
+	printLiveDataDeltaInfo();
 }
 
 static void setTsSpeed(int value) {
@@ -227,6 +229,7 @@ void TunerStudio::handleWriteChunkCommand(TsChannelBase* tsChannel, uint16_t pag
 		if (!wasPresetJustApplied()) {
 			uint8_t * addr = (uint8_t *) (getWorkingPageAddr() + offset);
 			memcpy(addr, content, count);
+			engine->tuneVersion++;
 		}
 		// Force any board configuration options that humans shouldn't be able to change
 		setBoardConfigOverrides();
@@ -264,7 +267,7 @@ void TunerStudio::handleCrc32Check(TsChannelBase *tsChannel, uint16_t offset, ui
 
 	const uint8_t* start = getWorkingPageAddr() + offset;
 
-	uint32_t crc = SWAP_UINT32(crc32(start, count));
+	uint32_t crc = SWAP_UINT32(crc32Fast(start, count));
 	tsChannel->sendResponse(TS_CRC, (const uint8_t *) &crc, 4);
 	efiPrintf("TS <- Get CRC offset %d count %d result %08x", offset, count, (unsigned int)crc);
 }
@@ -303,7 +306,7 @@ void TunerStudio::handleScatteredReadCommand(TsChannelBase* tsChannel) {
 		// write each data point and CRC incrementally
 		copyRange(dataBuffer, getLiveDataFragments(), offset, size);
 		tsChannel->write(dataBuffer, size, false);
-		crc = crc32inc((void*)dataBuffer, crc, size);
+		crc = crc32FastInc(dataBuffer, crc, size);
 	}
 #if EFI_SIMULATOR
 //	printf("CRC %x\n", crc);
@@ -382,6 +385,9 @@ static void handleBurnCommand(TsChannelBase* tsChannel) {
 
 static bool isKnownCommand(char command) {
 	return command == TS_HELLO_COMMAND || command == TS_READ_COMMAND || command == TS_OUTPUT_COMMAND
+			|| command == TS_OUTPUT_DELTA_COMMAND
+			|| command == TS_OUTPUT_SUBSCRIBE_COMMAND
+			|| command == TS_EVENT_TIMING_COMMAND
 			|| command == TS_BURN_COMMAND || command == TS_SINGLE_WRITE_COMMAND
 			|| command == TS_CHUNK_WRITE_COMMAND || command == TS_EXECUTE
 			|| command == TS_IO_TEST_COMMAND
@@ -398,6 +404,7 @@ static bool isKnownCommand(char command) {
 			|| command == TS_GET_FIRMWARE_VERSION
 			|| command == TS_PERF_TRACE_BEGIN
 			|| command == TS_PERF_TRACE_GET_BUFFER
+			|| command == TS_PERF_TRACE_STREAM
 			|| command == TS_GET_CONFIG_ERROR
 			|| command == TS_QUERY_BOOTLOADER;
 }
@@ -484,22 +491,47 @@ bool TunerStudio::handlePlainCommand(TsChannelBase* tsChannel, uint8_t command)
 
 TunerStudio tsInstance;
 
+// tsProcessOne result: no request has arrived, the link was idle and a subscription push went out instead
+#define TS_PROCESS_PUSHED 1
+
 static int tsProcessOne(TsChannelBase* tsChannel) {
 	assertStack("communication", ObdCode::STACK_USAGE_COMMUNICATION, EXPECTED_REMAINING_STACK, -1);
 
 	if (!tsChannel->isReady()) {
+#if ENABLE_PERF_TRACE
+		// link is gone, so is whoever was reading the stream
+		perfTraceStreamStop(tsChannel);
+#endif /* ENABLE_PERF_TRACE */
 		chThdSleepMilliseconds(10);
 		return -1;
 	}
 
+#if ENABLE_PERF_TRACE
+	perfTraceStreamStopIfIdle(tsChannel);
+#endif /* ENABLE_PERF_TRACE */
+
 	tsState.totalCounter++;
 
+	// while pushing output channels only wait for the client until the next push is due
+	efitick_t nowNt = getTimeNowNt();
+	bool isPushing = tsChannel->subscription.isActive(nowNt);
+	sysinterval_t firstByteTimeout = isPushing
+		? TIME_US2I(NT2US(tsChannel->subscription.getTimeUntilDue(nowNt)))
+		: TS_COMMUNICATION_TIMEOUT;
+
 	uint8_t firstByte;
-	size_t received = tsChannel->readTimeout(&firstByte, 1, TS_COMMUNICATION_TIMEOUT);
+	size_t received = tsChannel->readTimeout(&firstByte, 1, firstByteTimeout);
 #if EFI_SIMULATOR
 		logMsg("received %d\r\n", received);
 #endif // EFI_SIMULATOR
 
+	if (received != 1 && isPushing) {
+		// Nothing came in until the push was due: no request is in flight, so even on a half-duplex
+		// link our frame does not collide with the client. Pushes never go out anywhere else.
+		tsInstance.pushSubscription(tsChannel);
+		return TS_PROCESS_PUSHED;
+	}
+
 	if (received != 1) {
 //			tunerStudioError("ERROR: no command");
 #if EFI_BLUETOOTH_SETUP
@@ -590,7 +622,7 @@ static int tsProcessOne(TsChannelBase* tsChannel) {
 
 	expectedCrc = SWAP_UINT32(expectedCrc);
 
-	uint32_t actualCrc = crc32(tsChannel->scratchBuffer, incomingPacketSize);
+	uint32_t actualCrc = crc32Fast(tsChannel->scratchBuffer, incomingPacketSize);
 	if (actualCrc != expectedCrc) {
 		/* send error only if previously we were in sync */
 		if (tsChannel->in_sync) {
@@ -606,6 +638,8 @@ static int tsProcessOne(TsChannelBase* tsChannel) {
 	/* we were able to receive known command with correct crc and size! */
 	tsChannel->in_sync = true;
 
+	tsChannel->subscription.onRequest(getTimeNowNt());
+
 	int success = tsInstance.handleCrcCommand(tsChannel, tsChannel->scratchBuffer, incomingPacketSize);
 
 	if (!success) {
@@ -626,11 +660,13 @@ void TunerstudioThread::ThreadTask() {
 
 	// Until the end of time, process incoming messages.
 	while (true) {
-		if (tsProcessOne(channel) == 0) {
-			onDataArrived(true);
-		} else {
-			onDataArrived(false);
+		int result = tsProcessOne(channel);
+		if (result == TS_PROCESS_PUSHED) {
+			// nothing has arrived, that's neither good nor bad news about the link
+			continue;
 		}
+
+		onDataArrived(result == 0);
 	}
 }
 
@@ -717,6 +753,16 @@ int TunerStudio::handleCrcCommand(TsChannelBase* tsChannel, char *data, int inco
 		}
 		cmdOutputChannels(tsChannel, offset, count);
 		break;
+	case TS_OUTPUT_DELTA_COMMAND:
+		// optional third field: LIVE_DATA_FORCE_KEYFRAME
+		cmdOutputChannelsDelta(tsChannel, offset, count, incomingPacketSize >= 7 ? data16[2] : 0);
+		break;
+	case TS_OUTPUT_SUBSCRIBE_COMMAND:
+		handleSubscribeCommand(tsChannel, reinterpret_cast<const uint8_t*>(data), incomingPacketSize - 1);
+		break;
+	case TS_EVENT_TIMING_COMMAND:
+		handleEventTimingCommand(tsChannel, reinterpret_cast<const uint8_t*>(data), incomingPacketSize - 1);
+		break;
 	case TS_OUTPUT_ALL_COMMAND:
 		offset = 0;
 		count = TS_TOTAL_OUTPUT_SIZE;
@@ -862,8 +908,11 @@ int TunerStudio::handleCrcCommand(TsChannelBase* tsChannel, char *data, int inco
 #endif /* EFI_TOOTH_LOGGER */
 #if ENABLE_PERF_TRACE
 	case TS_PERF_TRACE_BEGIN:
-		perfTraceEnable();
-		sendOkResponse(tsChannel);
+		if (perfTraceEnable()) {
+			sendOkResponse(tsChannel);
+		} else {
+			sendErrorCode(tsChannel, TS_RESPONSE_OUT_OF_RANGE, "perf trace is streaming");
+		}
 		break;
 	case TS_PERF_TRACE_GET_BUFFER:
 		{
@@ -871,6 +920,37 @@ int TunerStudio::handleCrcCommand(TsChannelBase* tsChannel, char *data, int inco
 			tsChannel->sendResponse(TS_CRC, trace.get<uint8_t>(), trace.size(), true);
 		}
 
+		break;
+	case TS_PERF_TRACE_STREAM:
+		switch (incomingPacketSize > 1 ? data[0] : 0) {
+		// this channel owns the stream, SD card perf trace or another link is turned away
+		case TS_PERF_TRACE_STREAM_START:
+			if (perfTraceStreamStart(tsChannel)) {
+				sendOkResponse(tsChannel);
+			} else {
+				sendErrorCode(tsChannel, TS_RESPONSE_OUT_OF_RANGE, "perf trace stream busy");
+			}
+			break;
+		case TS_PERF_TRACE_STREAM_STOP:
+			perfTraceStreamStop(tsChannel);
+			sendOkResponse(tsChannel);
+			break;
+		case TS_PERF_TRACE_STREAM_READ:
+			if (!perfTraceStreamIsOwner(tsChannel)) {
+				sendErrorCode(tsChannel, TS_RESPONSE_OUT_OF_RANGE, "perf trace not streaming here");
+			} else {
+				// same records as TS_PERF_TRACE_GET_BUFFER, sent right out of the ring
+				const uint8_t* trace = nullptr;
+				size_t size = perfTraceStreamPeek(tsChannel, trace);
+				tsChannel->sendResponse(TS_CRC, trace, size, true);
+				perfTraceStreamRelease(tsChannel, size);
+			}
+			break;
+		default:
+			// dunno what that was, send NAK
+			return false;
+		}
+
 		break;
 #else
 	case TS_PERF_TRACE_BEGIN:
@@ -879,6 +959,9 @@ int TunerStudio::handleCrcCommand(TsChannelBase* tsChannel, char *data, int inco
 	case TS_PERF_TRACE_GET_BUFFER:
     criticalError("TS_PERF_TRACE_GET_BUFFER not supported");
     break;
+	case TS_PERF_TRACE_STREAM:
+		sendErrorCode(tsChannel, TS_RESPONSE_UNRECOGNIZED_COMMAND, "perf_trace_stream");
+		break;
 #endif /* ENABLE_PERF_TRACE */
 	case TS_GET_CONFIG_ERROR: {
 	  const char* configError = hasFirmwareError()? getCriticalErrorMessage() : getConfigErrorMessage();
@@ -21,6 +21,9 @@ typedef struct {
 	int totalCounter;
 	int textCommandCounter;
 	int testCommandCounter;
+	// TS_OUTPUT_DELTA_COMMAND responses by type
+	int deltaKeyframeCounter;
+	int deltaCounter;
 
 	// overall counter, not all of this errors are reported back to TS
 	int errorCounter;
@@ -51,6 +54,8 @@ int getSecondsSinceChannelsRequest();
 #include "thread_priority.h"
 
 void updateTunerStudioState();
+// keyframe/delta statistics of TS_OUTPUT_DELTA_COMMAND
+void printLiveDataDeltaInfo();
 
 void startTunerStudioConnectivity();
 bool wasPresetJustApplied();
@@ -7,6 +7,7 @@ TUNERSTUDIO_SRC_CPP = $(PROJECT_DIR)/console/binary/tunerstudio_io.cpp \
 	$(PROJECT_DIR)/console/binary/serial_can.cpp \
 	$(PROJECT_DIR)/console/binary/tunerstudio.cpp \
 	$(PROJECT_DIR)/console/binary/tunerstudio_commands.cpp \
+	$(PROJECT_DIR)/console/binary/live_data_subscription.cpp \
 	$(PROJECT_DIR)/console/binary/bluetooth.cpp \
 	$(PROJECT_DIR)/console/binary/signature.cpp \
 	$(PROJECT_DIR)/console/binary/trigger_scope.cpp \
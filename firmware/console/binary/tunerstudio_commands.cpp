@@ -5,8 +5,10 @@
 #include "tunerstudio_io.h"
 
 #include "live_data.h"
+#include "live_data_delta.h"
 
 #include "status_loop.h"
+#include "event_timing_stats.h"
 
 #if EFI_TUNER_STUDIO
 
@@ -63,4 +65,110 @@ void TunerStudio::cmdOutputChannels(TsChannelBase* tsChannel, uint16_t offset, u
 	tsChannel->crcAndWriteBuffer(TS_RESPONSE_OK, count);
 }
 
+/**
+ * @brief Same as cmdOutputChannels but only sends what has changed since the previous response, see live_data_delta.h
+ */
+void TunerStudio::cmdOutputChannelsDelta(TsChannelBase* tsChannel, uint16_t offset, uint16_t count, uint16_t flags) {
+	if (offset + count > TS_TOTAL_OUTPUT_SIZE || count > BLOCKING_FACTOR) {
+		efiPrintf("TS: Version Mismatch? Too much delta outputs requested offset=%d + count=%d/total=%d", offset, count,
+				TS_TOTAL_OUTPUT_SIZE);
+		sendErrorCode(tsChannel, TS_RESPONSE_OUT_OF_RANGE, "cmd_size");
+		return;
+	}
+
+	tsState.outputChannelsCommandCounter++;
+	updateTunerStudioState();
+
+	uint8_t * scratchBuffer = (uint8_t *)tsChannel->scratchBuffer;
+	uint8_t * payload = scratchBuffer + TS_PACKET_HEADER_SIZE;
+
+	bool isBaselineAvailable;
+	{
+		chibios_rt::CriticalSectionLocker csl;
+		isBaselineAvailable = !m_isLiveDataDeltaBusy;
+		m_isLiveDataDeltaBusy = true;
+	}
+
+	size_t size;
+	if (isBaselineAvailable) {
+		if (m_liveDataDeltaOwner != tsChannel) {
+			// baseline is what the previous link has seen
+			m_liveDataDelta.reset();
+			m_liveDataDeltaOwner = tsChannel;
+		}
+
+		size = m_liveDataDelta.encode(offset, count, flags,
+			[](uint8_t* destination, size_t rangeOffset, size_t rangeSize) {
+				copyRange(destination, getLiveDataFragments(), rangeOffset, rangeSize);
+			},
+			payload);
+
+		chibios_rt::CriticalSectionLocker csl;
+		m_isLiveDataDeltaBusy = false;
+	} else {
+		// another link is encoding right now, a keyframe is always valid
+		payload[0] = LIVE_DATA_KEYFRAME;
+		payload[1] = 0;
+		copyRange(payload + LIVE_DATA_DELTA_HEADER_SIZE, getLiveDataFragments(), offset, count);
+		size = LIVE_DATA_DELTA_HEADER_SIZE + count;
+	}
+
+	if (payload[0] == LIVE_DATA_KEYFRAME) {
+		tsState.deltaKeyframeCounter++;
+	} else {
+		tsState.deltaCounter++;
+	}
+
+	tsChannel->crcAndWriteBuffer(TS_RESPONSE_OK, size);
+}
+
+void TunerStudio::handleSubscribeCommand(TsChannelBase* tsChannel, const uint8_t* data, size_t size) {
+	if (!tsChannel->subscription.subscribe(data, size, getTimeNowNt())) {
+		efiPrintf("TS: invalid output channels subscription of %d bytes", size);
+		sendErrorCode(tsChannel, TS_RESPONSE_OUT_OF_RANGE, "subscribe");
+		return;
+	}
+
+	tsChannel->writeCrcResponse(TS_RESPONSE_OK);
+}
+
+void TunerStudio::pushSubscription(TsChannelBase* tsChannel) {
+	efitick_t nowNt = getTimeNowNt();
+	if (!tsChannel->subscription.isDue(nowNt)) {
+		return;
+	}
+
+	// one snapshot in the scratch buffer so that CRC is computed once on stable data
+	uint8_t * scratchBuffer = (uint8_t *)tsChannel->scratchBuffer;
+	size_t size = tsChannel->subscription.writeSnapshot(scratchBuffer + TS_PACKET_HEADER_SIZE, nowNt);
+
+	tsChannel->crcAndWriteBuffer(TS_RESPONSE_OUTPUT_PUSH, size);
+}
+
+void TunerStudio::handleEventTimingCommand(TsChannelBase* tsChannel, const uint8_t* data, size_t size) {
+#if EFI_EVENT_TIMING_STATS
+	static_assert(sizeof(event_timing_report_s) + 3 <= BLOCKING_FACTOR);
+
+	// optional payload byte, non-zero resets the histograms once read
+	bool reset = size >= 1 && data[0] != 0;
+
+	// snapshot wants word alignment while the payload starts right after the 3 byte header
+	uint8_t* payload = reinterpret_cast<uint8_t*>(tsChannel->scratchBuffer) + TS_PACKET_HEADER_SIZE;
+	uint8_t* aligned = reinterpret_cast<uint8_t*>(((uintptr_t)payload + 3) & ~(uintptr_t)3);
+	getEventTimingReport(*reinterpret_cast<event_timing_report_s*>(aligned), reset);
+	memmove(payload, aligned, sizeof(event_timing_report_s));
+
+	tsChannel->crcAndWriteBuffer(TS_RESPONSE_OK, sizeof(event_timing_report_s));
+#else
+	UNUSED(data);
+	UNUSED(size);
+	sendErrorCode(tsChannel, TS_RESPONSE_UNRECOGNIZED_COMMAND, "event_timing");
+#endif // EFI_EVENT_TIMING_STATS
+}
+
+void printLiveDataDeltaInfo() {
+	efiPrintf("TS delta outputs, all links: %d keyframes, %d deltas",
+		tsState.deltaKeyframeCounter, tsState.deltaCounter);
+}
+
 #endif // EFI_TUNER_STUDIO
@@ -6,6 +6,8 @@
 
 #include <cstdint>
 
+#include "live_data_delta.h"
+
 class TsChannelBase;
 
 typedef enum {
@@ -26,6 +28,13 @@ public:
 	bool handlePlainCommand(TsChannelBase* tsChannel, uint8_t command);
 
 	void cmdOutputChannels(TsChannelBase* tsChannel, uint16_t offset, uint16_t count) override;
+	void cmdOutputChannelsDelta(TsChannelBase* tsChannel, uint16_t offset, uint16_t count, uint16_t flags);
+	void handleSubscribeCommand(TsChannelBase* tsChannel, const uint8_t* data, size_t size);
+	/**
+	 * sends a TS_RESPONSE_OUTPUT_PUSH frame if one is due on this link
+	 */
+	void pushSubscription(TsChannelBase* tsChannel);
+	void handleEventTimingCommand(TsChannelBase* tsChannel, const uint8_t* data, size_t size);
 	/**
 	 * this command is part of protocol initialization
 	 */
@@ -39,4 +48,9 @@ public:
 
 private:
 	void sendErrorCode(TsChannelBase* tsChannel, uint8_t code, /*empty line by default, use nullptr not to log*/const char *msg="");
+
+	// one baseline for all links to save RAM, it follows whichever link has asked last, see cmdOutputChannelsDelta
+	LiveDataDelta<TS_TOTAL_OUTPUT_SIZE> m_liveDataDelta;
+	TsChannelBase* m_liveDataDeltaOwner = nullptr;
+	bool m_isLiveDataDeltaBusy = false;
 };
@@ -9,6 +9,7 @@
 #pragma once
 #include "global.h"
 #include "tunerstudio_impl.h"
+#include "live_data_subscription.h"
 
 #if EFI_USB_SERIAL
 #include "usbconsole.h"
@@ -79,6 +80,9 @@ public:
 	 * command and check if it is supported. */
 	bool in_sync = false;
 
+	// push mode output channels of this link, see TS_OUTPUT_SUBSCRIBE_COMMAND
+	LiveDataSubscription subscription;
+
 private:
 	bool isBigPacket(size_t size);
 	void writeCrcPacketLarge(uint8_t responseCode, const uint8_t* buf, size_t size);
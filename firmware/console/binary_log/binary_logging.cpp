@@ -10,6 +10,10 @@
 #include "buffered_writer.h"
 #include "tunerstudio.h"
 
+#if !EFI_PROD_CODE
+#include <vector>
+#endif
+
 #if EFI_FILE_LOGGING || EFI_UNIT_TEST
 
 #define TIME_PRECISION 1000
@@ -24,6 +28,10 @@ int getSdCardFieldsCount() {
 	return efi::size(fields);
 }
 
+const LogField& getSdLogField(size_t index) {
+	return fields[index];
+}
+
 static constexpr uint16_t computeFieldsRecordLength() {
 	uint16_t recLength = 0;
 	for (size_t i = 0; i < efi::size(fields); i++) {
@@ -89,77 +97,128 @@ static size_t writeFileHeader(Writer& outBuffer) {
 
 static uint8_t blockRollCounter = 0;
 
-static size_t writeSdBlock(Writer& outBuffer) {
-	size_t writen = 0;
-	static char buffer[16];
+/**
+ * "CRC" at the end of the record is just the sum of all field bytes,
+ * summed a word at a time in two 16 bit lanes per byte position
+ */
+static uint8_t sumBytes(const uint8_t* data, size_t size) {
+	uint32_t sum = 0;
+
+	while (size >= 4) {
+		uint32_t lanes = 0;
+		// 128 words is as much as a 16 bit lane takes without carrying in to the next one
+		size_t words = size / 4 > 128 ? 128 : size / 4;
+		for (size_t i = 0; i < words; i++) {
+			uint32_t word;
+			memcpy(&word, data, sizeof(word));
+			lanes += (word & 0x00FF00FF) + ((word >> 8) & 0x00FF00FF);
+			data += 4;
+		}
+		sum += lanes + (lanes >> 16);
+		size -= words * 4;
+	}
 
+	while (size--) {
+		sum += *data++;
+	}
+
+	return sum;
+}
+
+/**
+ * Builds the whole record in place: fields go one after another in the order of the fields table,
+ * so every offset in the record is fixed by that table.
+ */
+static size_t writeSdBlock(uint8_t* out) {
 	// Offset 0 = Block type, standard data block in this case
-	buffer[0] = 0;
+	out[0] = 0;
 
 	// Offset 1 = rolling counter sequence number
-	buffer[1] = blockRollCounter++;
+	out[1] = blockRollCounter++;
 
 	// Offset 2, size 2 = Timestamp at 10us resolution
 	efitimeus_t nowUs = getTimeNowUs();
 	uint16_t timestamp = nowUs / 10;
-	buffer[2] = timestamp >> 8;
-	buffer[3] = timestamp & 0xFF;
-
-	// TODO: check ret value!
-	outBuffer.write(buffer, 4);
-	writen += 4;
+	out[2] = timestamp >> 8;
+	out[3] = timestamp & 0xFF;
 
 	// todo: add a log field for SD card period
 //	prevSdCardLineTime = nowUs;
 
 	packedTime = getTimeNowMs() * 1.0 / TIME_PRECISION;
 
-	uint8_t sum = 0;
+	uint8_t* const fieldsStart = out + 4;
+	uint8_t* position = fieldsStart;
 	for (size_t fieldIndex = 0; fieldIndex < efi::size(fields); fieldIndex++) {
 		#if EFI_UNIT_TEST
 			// dark magic: all elements of log_fields_generated.h were const-evaluated against 'nullptr' engine, let's add it!
-			void *offset = fieldIndex == 0 ? nullptr : engine;
+			uintptr_t offset = fieldIndex == 0 ? 0 : reinterpret_cast<uintptr_t>(engine);
 		#else
-			void *offset = nullptr;
+			uintptr_t offset = 0;
 		#endif
 
-		size_t entrySize = fields[fieldIndex].writeData(buffer, offset);
-
-		for (size_t byteIndex = 0; byteIndex < entrySize; byteIndex++) {
-			// "CRC" at the end is just the sum of all bytes
-			sum += buffer[byteIndex];
-		}
-		// TODO: check ret value!
-		outBuffer.write(buffer, entrySize);
-		writen += entrySize;
+		position += fields[fieldIndex].writeRecordData(position, offset);
 	}
 
-	buffer[0] = sum;
 	// 1 byte checksum footer
-	outBuffer.write(buffer, 1);
-	writen += 1;
+	*position = sumBytes(fieldsStart, position - fieldsStart);
+	position++;
 
-	return writen;
+	return position - out;
 }
 
-size_t writeSdLogLine(Writer& bufferedWriter) {
+size_t getSdLogRecordSize() {
+	// block header, all fields, checksum footer
+	return 4 + recordLength + 1;
+}
+
+size_t writeSdLogHeader(Writer& outBuffer) {
+	return writeFileHeader(outBuffer);
+}
+
+size_t serializeSdLogRecord(uint8_t* out, size_t size) {
+	if (size < getSdLogRecordSize()) {
+		return 0;
+	}
+
+	return writeSdBlock(out);
+}
+
+size_t captureSdLogRecord(uint8_t* out, size_t size) {
 #if EFI_PROD_CODE
 extern bool main_loop_started;
 	if (!main_loop_started)
 		return 0;
 #endif //EFI_PROD_CODE
 
+	updateTunerStudioState();
+	return serializeSdLogRecord(out, size);
+}
+
+#if !EFI_PROD_CODE
+size_t captureSdLogRecord(Writer& outBuffer) {
+	// Exactly one record: computeFieldsRecordLength() is constexpr but the fields table is not, so there
+	// is no compile time size. Firmware serializes straight in to the MLG ring instead, see mmc_card.cpp
+	static std::vector<uint8_t> record(getSdLogRecordSize());
+
+	size_t size = captureSdLogRecord(record.data(), record.size());
+	// one write for the whole record
+	outBuffer.write(reinterpret_cast<const char*>(record.data()), size);
+	return size;
+}
+
+size_t writeSdLogLine(Writer& bufferedWriter) {
 	if (binaryLogCount == 0) {
 		binaryLogCount++;
 
-		return writeFileHeader(bufferedWriter);
+		return writeSdLogHeader(bufferedWriter);
 	} else {
 		binaryLogCount++;
 
-		updateTunerStudioState();
-		return writeSdBlock(bufferedWriter);
+		return captureSdLogRecord(bufferedWriter);
 	}
 }
+#endif // EFI_PROD_CODE
 
 void resetFileLogging() {
 	binaryLogCount = 0;
@@ -6,7 +6,24 @@
 
 #include "buffered_writer.h"
 
+class LogField;
+
 int getSdCardFieldsCount();
+const LogField& getSdLogField(size_t index);
 
-size_t writeSdLogLine(Writer& buffer);
+// Size of every data record, file header not included
+size_t getSdLogRecordSize();
+size_t writeSdLogHeader(Writer& buffer);
+// One data record with current values straight in to memory, out should fit getSdLogRecordSize() bytes,
+// 0 if there is nothing to log yet
+size_t captureSdLogRecord(uint8_t* out, size_t size);
+// Record of output channels as they are right now, without refreshing them first
+size_t serializeSdLogRecord(uint8_t* out, size_t size);
 void resetFileLogging();
+
+#if !EFI_PROD_CODE
+// Same as captureSdLogRecord above through a Writer
+size_t captureSdLogRecord(Writer& buffer);
+// File header on the first call, a data record on every next one
+size_t writeSdLogLine(Writer& buffer);
+#endif
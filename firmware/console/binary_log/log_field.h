@@ -4,14 +4,32 @@
 #include "rusefi_types.h"
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 struct Writer;
+
+/**
+ * How eagerly a field needs a new MLG row when it changes, see mlg_row_filter.h
+ * Set by 'log_medium'/'log_slow' modifiers in output_channels.txt, Fast if not specified
+ */
+enum class LogRateClass : uint8_t {
+	// RPM, MAP, TPS, AFR... a change is always written right away
+	Fast,
+	// pressures, trims, error flags: at most every MLG_MEDIUM_PERIOD_MS
+	Medium,
+	// temperatures, fuel level, counters: only with the MLG_SLOW_PERIOD_MS heartbeat
+	Slow,
+	// changes all the time and carries no information, for instance the time field
+	Ignore,
+};
+
 class LogField {
 public:
 	// Scaled channels, memcpys data directly and describes format in header
 	template <typename TValue, int TMult, int TDiv>
 	constexpr LogField(const scaled_channel<TValue, TMult, TDiv>& toRead,
-			   const char* name, const char* units, int8_t digits, const char* category = "none")
+			   const char* name, const char* units, int8_t digits, const char* category = "none",
+			   LogRateClass rateClass = LogRateClass::Fast)
 		: m_multiplier(float(TDiv) / TMult)
 		, m_addr(toRead.getFirstByteAddr())
 		, m_type(resolveType<TValue>())
@@ -20,6 +38,7 @@ public:
 		, m_name(name)
 		, m_units(units)
 		, m_category(category)
+		, m_rateClass(rateClass)
 		, m_isBitField(false)
 		, m_bitsBlockOffset(0)
 		, m_bitNumber(0)
@@ -29,7 +48,8 @@ public:
 	// Non-scaled channel, works for plain arithmetic types (int, float, uint8_t, etc)
 	template <typename TValue, typename = typename std::enable_if<std::is_arithmetic_v<TValue>>::type>
 	constexpr LogField(TValue& toRead,
-			   const char* name, const char* units, int8_t digits, const char* category = "none")
+			   const char* name, const char* units, int8_t digits, const char* category = "none",
+			   LogRateClass rateClass = LogRateClass::Fast)
 		: m_multiplier(1)
 		, m_addr(&toRead)
 		, m_type(resolveType<TValue>())
@@ -38,6 +58,7 @@ public:
 		, m_name(name)
 		, m_units(units)
 		, m_category(category)
+		, m_rateClass(rateClass)
 		, m_isBitField(false)
 		, m_bitsBlockOffset(0)
 		, m_bitNumber(0)
@@ -52,7 +73,8 @@ public:
 		const uint8_t bitNumber,
 		const char* name,
 		const char* units,
-		const char* category = "none"
+		const char* category = "none",
+		LogRateClass rateClass = LogRateClass::Fast
 	): m_multiplier(1)
 		, m_addr(&toRead)
 		, m_type(Type::U08)
@@ -61,6 +83,7 @@ public:
 		, m_name(name)
 		, m_units(units)
 		, m_category(category)
+		, m_rateClass(rateClass)
 		, m_isBitField(true)
 		, m_bitsBlockOffset(bitsBlockOffset)
 		, m_bitNumber(bitNumber)
@@ -81,6 +104,14 @@ public:
 		return m_size;
 	}
 
+	constexpr const char* getName() const {
+		return m_name;
+	}
+
+	constexpr LogRateClass getRateClass() const {
+		return m_rateClass;
+	}
+
 	// Write the header data describing this field.
 	// Returns the number of bytes written.
 	size_t writeHeader(Writer& outBuffer) const;
@@ -89,6 +120,40 @@ public:
 	// Returns the number of bytes written.
 	size_t writeData(char* buffer, void *offset) const;
 
+	// Same bytes as writeData, straight in to the record being built: no per byte loop, no scratch buffer
+	size_t writeRecordData(uint8_t* out, uintptr_t offset) const {
+		const uint8_t* src = static_cast<const uint8_t*>(m_addr) + offset;
+
+		if (m_isBitField) {
+			uint8_t byteWithBit = src[m_bitsBlockOffset + m_bitNumber / 8];
+			out[0] = (byteWithBit >> (m_bitNumber % 8)) & 1;
+			return 1;
+		}
+
+		// MLG is big endian
+		switch (m_size) {
+		case 1:
+			out[0] = src[0];
+			return 1;
+		case 2: {
+			uint16_t value;
+			memcpy(&value, src, sizeof(value));
+			value = __builtin_bswap16(value);
+			memcpy(out, &value, sizeof(value));
+			return 2;
+		}
+		case 4: {
+			uint32_t value;
+			memcpy(&value, src, sizeof(value));
+			value = __builtin_bswap32(value);
+			memcpy(out, &value, sizeof(value));
+			return 4;
+		}
+		default:
+			return writeData(reinterpret_cast<char*>(out), reinterpret_cast<void*>(offset));
+		}
+	}
+
 private:
 	template<typename T>
 	static constexpr Type resolveType();
@@ -116,6 +181,7 @@ private:
 	const char* const m_name;
 	const char* const m_units;
 	const char* const m_category;
+	const LogRateClass m_rateClass;
 
 	const bool m_isBitField;
 	const uint32_t m_bitsBlockOffset; // only for bit log fields
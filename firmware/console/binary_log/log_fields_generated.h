@@ -1,135 +1,135 @@
 // generated by class com.rusefi.output.SdCardFieldsContent
 #include "board_lookup.h"
 static const LogField fields[] = {
-{packedTime, GAUGE_NAME_TIME, "sec", 0},
-	{engine->outputChannels, 0, 0, "SD: Present", ""},
-	{engine->outputChannels, 0, 1, "SD: Logging", ""},
-	{engine->outputChannels, 0, 2, "triggerScopeReady", ""},
+{packedTime, GAUGE_NAME_TIME, "sec", 0, "none", LogRateClass::Ignore},
+	{engine->outputChannels, 0, 0, "SD: Present", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 1, "SD: Logging", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 2, "triggerScopeReady", "", "none", LogRateClass::Slow},
 	{engine->outputChannels, 0, 3, "antilagTriggered", ""},
-	{engine->outputChannels, 0, 4, "isO2HeaterOn", ""},
-	{engine->outputChannels, 0, 5, "checkEngine", ""},
-	{engine->outputChannels, 0, 6, "needBurn", ""},
-	{engine->outputChannels, 0, 7, "SD: MSD", ""},
-	{engine->outputChannels, 0, 8, "Tooth Logger Ready", ""},
-	{engine->outputChannels, 0, 9, "Error: TPS", ""},
-	{engine->outputChannels, 0, 10, "Error: CLT", ""},
-	{engine->outputChannels, 0, 11, "Error: MAP", ""},
-	{engine->outputChannels, 0, 12, "Error: IAT", ""},
-	{engine->outputChannels, 0, 13, "Error: Trigger", ""},
-	{engine->outputChannels, 0, 14, "Error: Active", ""},
-	{engine->outputChannels, 0, 15, "Warning: Active", ""},
-	{engine->outputChannels, 0, 16, "Error: Pedal", ""},
+	{engine->outputChannels, 0, 4, "isO2HeaterOn", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 5, "checkEngine", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 6, "needBurn", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 7, "SD: MSD", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 8, "Tooth Logger Ready", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 9, "Error: TPS", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 10, "Error: CLT", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 11, "Error: MAP", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 12, "Error: IAT", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 13, "Error: Trigger", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 14, "Error: Active", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 15, "Warning: Active", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 16, "Error: Pedal", "", "none", LogRateClass::Medium},
 	{engine->outputChannels, 0, 17, "isKnockChipOk", ""},
 	{engine->outputChannels, 0, 18, "Launch Control Triggered", ""},
-	{engine->outputChannels, 0, 19, "Error: TPS2", ""},
-	{engine->outputChannels, 0, 20, "Injector Fault", ""},
-	{engine->outputChannels, 0, 21, "Ignition Fault", ""},
-	{engine->outputChannels, 0, 22, "isUsbConnected", ""},
+	{engine->outputChannels, 0, 19, "Error: TPS2", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 20, "Injector Fault", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 21, "Ignition Fault", "", "none", LogRateClass::Medium},
+	{engine->outputChannels, 0, 22, "isUsbConnected", "", "none", LogRateClass::Slow},
 	{engine->outputChannels, 0, 23, "dfcoActive", ""},
-	{engine->outputChannels, 0, 24, "SD card writing", ""},
-	{engine->outputChannels, 0, 25, "SD card reading", ""},
+	{engine->outputChannels, 0, 24, "SD card writing", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 25, "SD card reading", "", "none", LogRateClass::Slow},
 	{engine->outputChannels, 0, 26, "MAP from sensor seems valid", ""},
-	{engine->outputChannels, 0, 27, "triggerPageRefreshFlag", ""},
-	{engine->outputChannels, 0, 28, "hasFaultReportFile", ""},
-	{engine->outputChannels, 0, 29, "Analog sensors supply failure", ""},
+	{engine->outputChannels, 0, 27, "triggerPageRefreshFlag", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 28, "hasFaultReportFile", "", "none", LogRateClass::Slow},
+	{engine->outputChannels, 0, 29, "Analog sensors supply failure", "", "none", LogRateClass::Medium},
 	{engine->outputChannels.RPMValue, "RPM", "RPM", 0},
 	{engine->outputChannels.rpmAcceleration, "dRPM", "RPM acceleration/Rate of Change/ROC", 2},
 	{engine->outputChannels.speedToRpmRatio, "Gearbox Ratio", "value", 2},
-	{engine->outputChannels.internalMcuTemperature, "CPU Temperature", "deg C", 0},
-	{engine->outputChannels.coolant, "CLT", "deg C", 1},
-	{engine->outputChannels.intake, "IAT", "deg C", 1},
-	{engine->outputChannels.auxTemp1, "auxTemp1", "deg C", 1},
-	{engine->outputChannels.auxTemp2, "auxTemp2", "deg C", 1},
+	{engine->outputChannels.internalMcuTemperature, "CPU Temperature", "deg C", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.coolant, "CLT", "deg C", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.intake, "IAT", "deg C", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.auxTemp1, "auxTemp1", "deg C", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.auxTemp2, "auxTemp2", "deg C", 1, "none", LogRateClass::Slow},
 	{engine->outputChannels.TPSValue, "TPS", "%", 2},
 	{engine->outputChannels.throttlePedalPosition, "Throttle pedal position", "%", 2},
 	{engine->outputChannels.tpsADC, "tpsADC", "ADC", 0},
 	{engine->outputChannels.rawMaf, "rawMaf", "V", 3},
 	{engine->outputChannels.mafMeasured, "MAF", "kg/h", 1},
 	{engine->outputChannels.MAPValue, "MAP", "kPa", 1},
-	{engine->outputChannels.baroPressure, "baroPressure", "kPa", 1},
+	{engine->outputChannels.baroPressure, "baroPressure", "kPa", 1, "none", LogRateClass::Slow},
 	{engine->outputChannels.lambdaValue, "Lambda", "", 3},
-	{engine->outputChannels.VBatt, "VBatt", "V", 2},
-	{engine->outputChannels.oilPressure, "Oil Pressure", "kPa", 0},
+	{engine->outputChannels.VBatt, "VBatt", "V", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.oilPressure, "Oil Pressure", "kPa", 0, "none", LogRateClass::Medium},
 	{engine->outputChannels.vvtPositionB1I, "VVT: bank 1 intake", "deg", 1},
 	{engine->outputChannels.actualLastInjection, "Fuel: Last inj pulse width", "ms", 3},
 	{engine->outputChannels.injectorDutyCycle, "Fuel: injector duty cycle", "%", 0},
-	{engine->outputChannels.tempLogging1, "tempLogging1", "", 0},
+	{engine->outputChannels.tempLogging1, "tempLogging1", "", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.injectionOffset, "Fuel: Injection timing SOI", "deg", 0},
-	{engine->outputChannels.engineMakeCodeNameCrc16, "Engine CRC16", "crc16", 0},
+	{engine->outputChannels.engineMakeCodeNameCrc16, "Engine CRC16", "crc16", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.wallFuelAmount, "Fuel: wall amount", "mg", 3},
 	{engine->outputChannels.wallFuelCorrectionValue, "Fuel: wall correction", "mg", 3},
-	{engine->outputChannels.revolutionCounterSinceStart, "revolutionCounterSinceStart", "", 0},
-	{engine->outputChannels.canReadCounter, "CAN: Rx", "", 0},
+	{engine->outputChannels.revolutionCounterSinceStart, "revolutionCounterSinceStart", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.canReadCounter, "CAN: Rx", "", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.tpsAccelFuel, "Fuel: TPS AE add fuel ms", "ms", 3},
 	{engine->outputChannels.currentIgnitionMode, "Ignition: Mode", "", 0},
 	{engine->outputChannels.currentInjectionMode, "Fuel: Injection mode", "", 0},
 	{engine->outputChannels.coilDutyCycle, "Ignition: coil duty cycle", "%", 0},
 	{engine->outputChannels.etb1DutyCycle, "ETB: Duty", "%", 1},
-	{engine->outputChannels.fuelTankLevel, "Fuel level", "%", 0},
-	{engine->outputChannels.totalFuelConsumption, "Fuel: Total consumed", "grams", 1},
+	{engine->outputChannels.fuelTankLevel, "Fuel level", "%", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.totalFuelConsumption, "Fuel: Total consumed", "grams", 1, "none", LogRateClass::Slow},
 	{engine->outputChannels.fuelFlowRate, "Fuel: Flow rate", "gram/s", 3},
 	{engine->outputChannels.TPS2Value, "TPS2", "%", 2},
-	{engine->outputChannels.tuneCrc16, "Tune CRC16", "crc16", 0},
+	{engine->outputChannels.tuneCrc16, "Tune CRC16", "crc16", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.veValue, "Fuel: VE", "ratio", 1},
-	{engine->outputChannels.seconds, "Uptime", "sec", 0},
+	{engine->outputChannels.seconds, "Uptime", "sec", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.engineMode, "Engine Mode", "em", 0},
-	{engine->outputChannels.firmwareVersion, "firmware", "version_f", 0},
+	{engine->outputChannels.firmwareVersion, "firmware", "version_f", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.rawIdlePositionSensor, "rawIdlePositionSensor", "V", 3},
 	{engine->outputChannels.rawWastegatePosition, "rawWastegatePosition", "V", 3},
 	{engine->outputChannels.accelerationLat, "Accel: Lateral", "G", 0},
 	{engine->outputChannels.accelerationLon, "Accel: Longitudinal", "G", 0},
-	{engine->outputChannels.detectedGear, "Detected Gear", "", 0},
-	{engine->outputChannels.maxTriggerReentrant, "maxTriggerReentrant", "", 0},
-	{engine->outputChannels.rawLowFuelPressure, "rawLowFuelPressure", "V", 3},
-	{engine->outputChannels.rawHighFuelPressure, "rawHighFuelPressure", "V", 3},
-	{engine->outputChannels.lowFuelPressure, "Fuel pressure (low)", "kpa", 0},
-	{engine->outputChannels.tcuDesiredGear, "TCU: Desired Gear", "gear", 0},
-	{engine->outputChannels.flexPercent, "Flex Ethanol %", "%", 1},
+	{engine->outputChannels.detectedGear, "Detected Gear", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.maxTriggerReentrant, "maxTriggerReentrant", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.rawLowFuelPressure, "rawLowFuelPressure", "V", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.rawHighFuelPressure, "rawHighFuelPressure", "V", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.lowFuelPressure, "Fuel pressure (low)", "kpa", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.tcuDesiredGear, "TCU: Desired Gear", "gear", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.flexPercent, "Flex Ethanol %", "%", 1, "none", LogRateClass::Medium},
 	{engine->outputChannels.wastegatePositionSensor, "Wastegate position sensor", "%", 2},
-	{engine->outputChannels.highFuelPressure, "Fuel pressure (high)", "bar", 0},
-	{engine->outputChannels.tempLogging3, "tempLogging3", "", 0},
-	{engine->outputChannels.tempLogging4, "tempLogging4", "", 0},
+	{engine->outputChannels.highFuelPressure, "Fuel pressure (high)", "bar", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.tempLogging3, "tempLogging3", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.tempLogging4, "tempLogging4", "", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.calibrationValue, "calibrationValue", "", 0},
 	{engine->outputChannels.calibrationMode, "calibrationMode", "", 0},
 	{engine->outputChannels.idleStepperTargetPosition, "Idle: Stepper target position", "", 0},
-	{engine->outputChannels.totalTriggerErrorCounter, "Trigger Error Counter", "counter", 0},
-	{engine->outputChannels.orderingErrorCounter, "orderingErrorCounter", "", 0},
-	{engine->outputChannels.warningCounter, "Warning: counter", "count", 0},
-	{engine->outputChannels.lastErrorCode, "Warning: last", "error", 0},
-	{engine->outputChannels.recentErrorCode[0], "Warning code 1", "error", 0},
-	{engine->outputChannels.recentErrorCode[1], "Warning code 2", "error", 0},
-	{engine->outputChannels.recentErrorCode[2], "Warning code 3", "error", 0},
-	{engine->outputChannels.recentErrorCode[3], "Warning code 4", "error", 0},
-	{engine->outputChannels.recentErrorCode[4], "Warning code 5", "error", 0},
-	{engine->outputChannels.recentErrorCode[5], "Warning code 6", "error", 0},
-	{engine->outputChannels.recentErrorCode[6], "Warning code 7", "error", 0},
-	{engine->outputChannels.recentErrorCode[7], "Warning code 8", "error", 0},
-	{engine->outputChannels.debugFloatField1, "debugFloatField1", "val", 3},
-	{engine->outputChannels.debugFloatField2, "debugFloatField2", "val", 3},
-	{engine->outputChannels.debugFloatField3, "debugFloatField3", "val", 3},
-	{engine->outputChannels.debugFloatField4, "debugFloatField4", "val", 3},
-	{engine->outputChannels.debugFloatField5, "debugFloatField5", "val", 3},
-	{engine->outputChannels.debugFloatField6, "debugFloatField6", "val", 3},
-	{engine->outputChannels.debugFloatField7, "debugFloatField7", "val", 3},
-	{engine->outputChannels.debugIntField1, "debugIntField1", "val", 0},
-	{engine->outputChannels.debugIntField2, "debugIntField2", "val", 0},
-	{engine->outputChannels.debugIntField3, "debugIntField3", "val", 0},
-	{engine->outputChannels.debugIntField4, "debugIntField4", "val", 0},
-	{engine->outputChannels.debugIntField5, "debugIntField5", "val", 0},
-	{engine->outputChannels.egt[0], "EGT 1", "deg C", 2},
-	{engine->outputChannels.egt[1], "EGT 2", "deg C", 2},
-	{engine->outputChannels.egt[2], "EGT 3", "deg C", 2},
-	{engine->outputChannels.egt[3], "EGT 4", "deg C", 2},
-	{engine->outputChannels.egt[4], "EGT 5", "deg C", 2},
-	{engine->outputChannels.egt[5], "EGT 6", "deg C", 2},
-	{engine->outputChannels.egt[6], "EGT 7", "deg C", 2},
-	{engine->outputChannels.egt[7], "EGT 8", "deg C", 2},
+	{engine->outputChannels.totalTriggerErrorCounter, "Trigger Error Counter", "counter", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.orderingErrorCounter, "orderingErrorCounter", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.warningCounter, "Warning: counter", "count", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.lastErrorCode, "Warning: last", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[0], "Warning code 1", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[1], "Warning code 2", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[2], "Warning code 3", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[3], "Warning code 4", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[4], "Warning code 5", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[5], "Warning code 6", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[6], "Warning code 7", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.recentErrorCode[7], "Warning code 8", "error", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugFloatField1, "debugFloatField1", "val", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugFloatField2, "debugFloatField2", "val", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugFloatField3, "debugFloatField3", "val", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugFloatField4, "debugFloatField4", "val", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugFloatField5, "debugFloatField5", "val", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugFloatField6, "debugFloatField6", "val", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugFloatField7, "debugFloatField7", "val", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugIntField1, "debugIntField1", "val", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugIntField2, "debugIntField2", "val", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugIntField3, "debugIntField3", "val", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugIntField4, "debugIntField4", "val", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.debugIntField5, "debugIntField5", "val", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.egt[0], "EGT 1", "deg C", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.egt[1], "EGT 2", "deg C", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.egt[2], "EGT 3", "deg C", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.egt[3], "EGT 4", "deg C", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.egt[4], "EGT 5", "deg C", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.egt[5], "EGT 6", "deg C", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.egt[6], "EGT 7", "deg C", 2, "none", LogRateClass::Slow},
+	{engine->outputChannels.egt[7], "EGT 8", "deg C", 2, "none", LogRateClass::Slow},
 	{engine->outputChannels.rawTps1Primary, "rawTps1Primary", "V", 3},
-	{engine->outputChannels.rawClt, "rawClt", "V", 3},
-	{engine->outputChannels.rawIat, "rawIat", "V", 3},
-	{engine->outputChannels.rawOilPressure, "rawOilPressure", "V", 3},
+	{engine->outputChannels.rawClt, "rawClt", "V", 3, "none", LogRateClass::Slow},
+	{engine->outputChannels.rawIat, "rawIat", "V", 3, "none", LogRateClass::Slow},
+	{engine->outputChannels.rawOilPressure, "rawOilPressure", "V", 3, "none", LogRateClass::Medium},
 	{engine->outputChannels.rawAcPressure, "rawAcPressure", "V", 3},
-	{engine->outputChannels.rawFuelLevel, "rawFuelLevel", "V", 3},
+	{engine->outputChannels.rawFuelLevel, "rawFuelLevel", "V", 3, "none", LogRateClass::Slow},
 	{engine->outputChannels.fuelClosedLoopBinIdx, "fuelClosedLoopBinIdx", "", 0},
 	{engine->outputChannels.rawPpsPrimary, "rawPpsPrimary", "V", 3},
 	{engine->outputChannels.rawPpsSecondary, "rawPpsSecondary", "V", 3},
@@ -143,8 +143,8 @@ static const LogField fields[] = {
 	{engine->outputChannels.vvtPositionB1E, "VVT: bank 1 exhaust", "deg", 1},
 	{engine->outputChannels.vvtPositionB2I, "VVT: bank 2 intake", "deg", 1},
 	{engine->outputChannels.vvtPositionB2E, "VVT: bank 2 exhaust", "deg", 1},
-	{engine->outputChannels.fuelPidCorrection[0], "Fuel: Trim bank 1", "%", 2},
-	{engine->outputChannels.fuelPidCorrection[1], "Fuel: Trim bank 2", "%", 2},
+	{engine->outputChannels.fuelPidCorrection[0], "Fuel: Trim bank 1", "%", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.fuelPidCorrection[1], "Fuel: Trim bank 2", "%", 2, "none", LogRateClass::Medium},
 	{engine->outputChannels.rawTps1Secondary, "rawTps1Secondary", "V", 3},
 	{engine->outputChannels.rawTps2Primary, "rawTps2Primary", "V", 3},
 	{engine->outputChannels.rawTps2Secondary, "rawTps2Secondary", "V", 3},
@@ -178,61 +178,61 @@ static const LogField fields[] = {
 	{engine->outputChannels.rawMap, "rawMap", "V", 3},
 	{engine->outputChannels.rawAfr, "rawAfr", "V", 3},
 	{engine->outputChannels.calibrationValue2, "calibrationValue2", "", 0},
-	{engine->outputChannels.luaInvocationCounter, "Lua: Tick counter", "count", 0},
-	{engine->outputChannels.luaLastCycleDuration, "Lua: Last tick duration", "nt", 0},
-	{engine->outputChannels.vssEdgeCounter, "vssEdgeCounter", "", 0},
-	{engine->outputChannels.issEdgeCounter, "issEdgeCounter", "", 0},
+	{engine->outputChannels.luaInvocationCounter, "Lua: Tick counter", "count", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.luaLastCycleDuration, "Lua: Last tick duration", "nt", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.vssEdgeCounter, "vssEdgeCounter", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.issEdgeCounter, "issEdgeCounter", "", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.auxLinear1, "Aux linear #1", "", 2},
 	{engine->outputChannels.auxLinear2, "Aux linear #2", "", 2},
 	{engine->outputChannels.auxLinear3, "Aux linear #3", "", 2},
 	{engine->outputChannels.auxLinear4, "Aux linear #4", "", 2},
 	{engine->outputChannels.fallbackMap, "fallbackMap", "kPa", 1},
 	{engine->outputChannels.instantMAPValue, "Instant MAP", "kPa", 2},
-	{engine->outputChannels.maxLockedDuration, "maxLockedDuration", "us", 0},
-	{engine->outputChannels.canWriteOk, "CAN: Tx OK", "", 0},
-	{engine->outputChannels.canWriteNotOk, "CAN: Tx err", "", 0},
-	{engine->outputChannels.triggerPrimaryFall, "triggerPrimaryFall", "", 3},
-	{engine->outputChannels.triggerPrimaryRise, "triggerPrimaryRise", "", 3},
-	{engine->outputChannels.triggerSecondaryFall, "triggerSecondaryFall", "", 3},
-	{engine->outputChannels.triggerSecondaryRise, "triggerSecondaryRise", "", 3},
-	{engine->outputChannels.triggerVvtFall, "triggerVvtFall", "", 0},
-	{engine->outputChannels.triggerVvtRise, "triggerVvtRise", "", 0},
-	{engine->outputChannels.triggerVvt2Fall, "triggerVvt2Fall", "", 0, "Sync"},
-	{engine->outputChannels.triggerVvt2Rise, "triggerVvt2Rise", "", 0, "Sync"},
+	{engine->outputChannels.maxLockedDuration, "maxLockedDuration", "us", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.canWriteOk, "CAN: Tx OK", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.canWriteNotOk, "CAN: Tx err", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.triggerPrimaryFall, "triggerPrimaryFall", "", 3, "none", LogRateClass::Slow},
+	{engine->outputChannels.triggerPrimaryRise, "triggerPrimaryRise", "", 3, "none", LogRateClass::Slow},
+	{engine->outputChannels.triggerSecondaryFall, "triggerSecondaryFall", "", 3, "none", LogRateClass::Slow},
+	{engine->outputChannels.triggerSecondaryRise, "triggerSecondaryRise", "", 3, "none", LogRateClass::Slow},
+	{engine->outputChannels.triggerVvtFall, "triggerVvtFall", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.triggerVvtRise, "triggerVvtRise", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.triggerVvt2Fall, "triggerVvt2Fall", "", 0, "Sync", LogRateClass::Slow},
+	{engine->outputChannels.triggerVvt2Rise, "triggerVvt2Rise", "", 0, "Sync", LogRateClass::Slow},
 	{engine->outputChannels.starterState, "starterState", "", 3},
 	{engine->outputChannels.starterRelayDisable, "starterRelayDisable", "", 3},
 	{engine->outputChannels.multiSparkCounter, "Ign: Multispark count", "", 3},
-	{engine->outputChannels.extiOverflowCount, "extiOverflowCount", "", 0},
-	{engine->outputChannels.alternatorStatus.pTerm, "alternatorStatus.pTerm", "", 2},
-	{engine->outputChannels.alternatorStatus.iTerm, "alternatorStatus.iTerm", "", 2},
-	{engine->outputChannels.alternatorStatus.dTerm, "alternatorStatus.dTerm", "", 2},
-	{engine->outputChannels.alternatorStatus.output, "alternatorStatus.output", "", 2},
-	{engine->outputChannels.alternatorStatus.error, "alternatorStatus.error", "", 2},
-	{engine->outputChannels.alternatorStatus.resetCounter, "alternatorStatus.resetCounter", "", 0},
-	{engine->outputChannels.idleStatus.pTerm, "idleStatus.pTerm", "", 2},
-	{engine->outputChannels.idleStatus.iTerm, "idleStatus.iTerm", "", 2},
-	{engine->outputChannels.idleStatus.dTerm, "idleStatus.dTerm", "", 2},
-	{engine->outputChannels.idleStatus.output, "idleStatus.output", "", 2},
-	{engine->outputChannels.idleStatus.error, "idleStatus.error", "", 2},
-	{engine->outputChannels.idleStatus.resetCounter, "idleStatus.resetCounter", "", 0},
+	{engine->outputChannels.extiOverflowCount, "extiOverflowCount", "", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.alternatorStatus.pTerm, "alternatorStatus.pTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.alternatorStatus.iTerm, "alternatorStatus.iTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.alternatorStatus.dTerm, "alternatorStatus.dTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.alternatorStatus.output, "alternatorStatus.output", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.alternatorStatus.error, "alternatorStatus.error", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.alternatorStatus.resetCounter, "alternatorStatus.resetCounter", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.idleStatus.pTerm, "idleStatus.pTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.idleStatus.iTerm, "idleStatus.iTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.idleStatus.dTerm, "idleStatus.dTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.idleStatus.output, "idleStatus.output", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.idleStatus.error, "idleStatus.error", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.idleStatus.resetCounter, "idleStatus.resetCounter", "", 0, "none", LogRateClass::Medium},
 	{engine->outputChannels.etbStatus.pTerm, "etbStatus.pTerm", "", 2},
 	{engine->outputChannels.etbStatus.iTerm, "etbStatus.iTerm", "", 2},
 	{engine->outputChannels.etbStatus.dTerm, "etbStatus.dTerm", "", 2},
 	{engine->outputChannels.etbStatus.output, "etbStatus.output", "", 2},
 	{engine->outputChannels.etbStatus.error, "etbStatus.error", "", 2},
 	{engine->outputChannels.etbStatus.resetCounter, "etbStatus.resetCounter", "", 0},
-	{engine->outputChannels.boostStatus.pTerm, "boostStatus.pTerm", "", 2},
-	{engine->outputChannels.boostStatus.iTerm, "boostStatus.iTerm", "", 2},
-	{engine->outputChannels.boostStatus.dTerm, "boostStatus.dTerm", "", 2},
-	{engine->outputChannels.boostStatus.output, "boostStatus.output", "", 2},
-	{engine->outputChannels.boostStatus.error, "boostStatus.error", "", 2},
-	{engine->outputChannels.boostStatus.resetCounter, "boostStatus.resetCounter", "", 0},
-	{engine->outputChannels.wastegateDcStatus.pTerm, "wastegateDcStatus.pTerm", "", 2},
-	{engine->outputChannels.wastegateDcStatus.iTerm, "wastegateDcStatus.iTerm", "", 2},
-	{engine->outputChannels.wastegateDcStatus.dTerm, "wastegateDcStatus.dTerm", "", 2},
-	{engine->outputChannels.wastegateDcStatus.output, "wastegateDcStatus.output", "", 2},
-	{engine->outputChannels.wastegateDcStatus.error, "wastegateDcStatus.error", "", 2},
-	{engine->outputChannels.wastegateDcStatus.resetCounter, "wastegateDcStatus.resetCounter", "", 0},
+	{engine->outputChannels.boostStatus.pTerm, "boostStatus.pTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.boostStatus.iTerm, "boostStatus.iTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.boostStatus.dTerm, "boostStatus.dTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.boostStatus.output, "boostStatus.output", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.boostStatus.error, "boostStatus.error", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.boostStatus.resetCounter, "boostStatus.resetCounter", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.wastegateDcStatus.pTerm, "wastegateDcStatus.pTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.wastegateDcStatus.iTerm, "wastegateDcStatus.iTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.wastegateDcStatus.dTerm, "wastegateDcStatus.dTerm", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.wastegateDcStatus.output, "wastegateDcStatus.output", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.wastegateDcStatus.error, "wastegateDcStatus.error", "", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.wastegateDcStatus.resetCounter, "wastegateDcStatus.resetCounter", "", 0, "none", LogRateClass::Medium},
 	{engine->outputChannels.auxSpeed1, "Aux speed 1", "s", 0},
 	{engine->outputChannels.auxSpeed2, "Aux speed 2", "s", 0},
 	{engine->outputChannels.ISSValue, "TCU: Input Shaft Speed", "RPM", 0},
@@ -244,19 +244,19 @@ static const LogField fields[] = {
 	{engine->outputChannels.rawAnalogInput[5], "rawAnalogInput 6", "V", 3},
 	{engine->outputChannels.rawAnalogInput[6], "rawAnalogInput 7", "V", 3},
 	{engine->outputChannels.rawAnalogInput[7], "rawAnalogInput 8", "V", 3},
-	{engine->outputChannels.gppwmOutput[0], "GPPWM Output 1", "%", 2},
-	{engine->outputChannels.gppwmOutput[1], "GPPWM Output 2", "%", 2},
-	{engine->outputChannels.gppwmOutput[2], "GPPWM Output 3", "%", 2},
-	{engine->outputChannels.gppwmOutput[3], "GPPWM Output 4", "%", 2},
-	{engine->outputChannels.gppwmXAxis[0], "gppwmXAxis 1", "", 0},
-	{engine->outputChannels.gppwmXAxis[1], "gppwmXAxis 2", "", 0},
-	{engine->outputChannels.gppwmXAxis[2], "gppwmXAxis 3", "", 0},
-	{engine->outputChannels.gppwmXAxis[3], "gppwmXAxis 4", "", 0},
-	{engine->outputChannels.gppwmYAxis[0], "gppwmYAxis 1", "", 1},
-	{engine->outputChannels.gppwmYAxis[1], "gppwmYAxis 2", "", 1},
-	{engine->outputChannels.gppwmYAxis[2], "gppwmYAxis 3", "", 1},
-	{engine->outputChannels.gppwmYAxis[3], "gppwmYAxis 4", "", 1},
-	{engine->outputChannels.rawBattery, "rawBattery", "V", 3},
+	{engine->outputChannels.gppwmOutput[0], "GPPWM Output 1", "%", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmOutput[1], "GPPWM Output 2", "%", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmOutput[2], "GPPWM Output 3", "%", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmOutput[3], "GPPWM Output 4", "%", 2, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmXAxis[0], "gppwmXAxis 1", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmXAxis[1], "gppwmXAxis 2", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmXAxis[2], "gppwmXAxis 3", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmXAxis[3], "gppwmXAxis 4", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmYAxis[0], "gppwmYAxis 1", "", 1, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmYAxis[1], "gppwmYAxis 2", "", 1, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmYAxis[2], "gppwmYAxis 3", "", 1, "none", LogRateClass::Medium},
+	{engine->outputChannels.gppwmYAxis[3], "gppwmYAxis 4", "", 1, "none", LogRateClass::Medium},
+	{engine->outputChannels.rawBattery, "rawBattery", "V", 3, "none", LogRateClass::Slow},
 	{engine->outputChannels.ignBlendParameter[0], "ignBlendParameter 1", "", 1},
 	{engine->outputChannels.ignBlendParameter[1], "ignBlendParameter 2", "", 1},
 	{engine->outputChannels.ignBlendParameter[2], "ignBlendParameter 3", "", 1},
@@ -329,46 +329,46 @@ static const LogField fields[] = {
 	{engine->outputChannels, 656, 27, "bank 1 exhaust cam input", ""},
 	{engine->outputChannels, 656, 28, "bank 2 intake cam input", ""},
 	{engine->outputChannels, 656, 29, "bank 2 exhaust cam input", ""},
-	{engine->outputChannels.outputRequestPeriod, "outputRequestPeriod", "", 0},
+	{engine->outputChannels.outputRequestPeriod, "outputRequestPeriod", "", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.mapFast, "mapFast", "", 0},
-	{engine->outputChannels.luaGauges[0], "Lua: Gauge 1", "value", 3},
-	{engine->outputChannels.luaGauges[1], "Lua: Gauge 2", "value", 3},
-	{engine->outputChannels.luaGauges[2], "Lua: Gauge 3", "value", 3},
-	{engine->outputChannels.luaGauges[3], "Lua: Gauge 4", "value", 3},
-	{engine->outputChannels.luaGauges[4], "Lua: Gauge 5", "value", 3},
-	{engine->outputChannels.luaGauges[5], "Lua: Gauge 6", "value", 3},
-	{engine->outputChannels.luaGauges[6], "Lua: Gauge 7", "value", 3},
-	{engine->outputChannels.luaGauges[7], "Lua: Gauge 8", "value", 3},
+	{engine->outputChannels.luaGauges[0], "Lua: Gauge 1", "value", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.luaGauges[1], "Lua: Gauge 2", "value", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.luaGauges[2], "Lua: Gauge 3", "value", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.luaGauges[3], "Lua: Gauge 4", "value", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.luaGauges[4], "Lua: Gauge 5", "value", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.luaGauges[5], "Lua: Gauge 6", "value", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.luaGauges[6], "Lua: Gauge 7", "value", 3, "none", LogRateClass::Medium},
+	{engine->outputChannels.luaGauges[7], "Lua: Gauge 8", "value", 3, "none", LogRateClass::Medium},
 	{engine->outputChannels.rawMaf2, "rawMaf2", "V", 3},
 	{engine->outputChannels.mafMeasured2, "MAF #2", "kg/h", 1},
-	{engine->outputChannels.schedulingUsedCount, "schedulingUsedCount", "", 0},
+	{engine->outputChannels.schedulingUsedCount, "schedulingUsedCount", "", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.vehicleSpeedKph, "Vehicle Speed", "kph", 2},
 	{engine->outputChannels.Gego, "Gego", "%", 2},
-	{engine->outputChannels.testBenchIter, "testBenchIter", "count", 0},
-	{engine->outputChannels.oilTemp, "oilTemp", "deg C", 1},
-	{engine->outputChannels.fuelTemp, "fuelTemp", "deg C", 1},
-	{engine->outputChannels.ambientTemp, "ambientTemp", "deg C", 1},
-	{engine->outputChannels.compressorDischargeTemp, "compressorDischargeTemp", "deg C", 1},
+	{engine->outputChannels.testBenchIter, "testBenchIter", "count", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.oilTemp, "oilTemp", "deg C", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.fuelTemp, "fuelTemp", "deg C", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.ambientTemp, "ambientTemp", "deg C", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.compressorDischargeTemp, "compressorDischargeTemp", "deg C", 1, "none", LogRateClass::Slow},
 	{engine->outputChannels.compressorDischargePressure, "compressorDischargePressure", "kPa", 1},
 	{engine->outputChannels.throttleInletPressure, "throttleInletPressure", "kPa", 1},
-	{engine->outputChannels.ignitionOnTime, "ignitionOnTime", "sec", 1},
-	{engine->outputChannels.engineRunTime, "engineRunTime", "sec", 1},
-	{engine->outputChannels.distanceTraveled, "distanceTraveled", "km", 1},
+	{engine->outputChannels.ignitionOnTime, "ignitionOnTime", "sec", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.engineRunTime, "engineRunTime", "sec", 1, "none", LogRateClass::Slow},
+	{engine->outputChannels.distanceTraveled, "distanceTraveled", "km", 1, "none", LogRateClass::Slow},
 	{engine->outputChannels.afrGasolineScale, "Air/Fuel Ratio (Gas Scale)", "AFR", 2},
 	{engine->outputChannels.afr2GasolineScale, "Air/Fuel Ratio 2 (Gas Scale)", "AFR", 2},
 	{engine->outputChannels.wheelSlipRatio, "wheelSlipRatio", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[0], "ignitorDiagnostic 1", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[1], "ignitorDiagnostic 2", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[2], "ignitorDiagnostic 3", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[3], "ignitorDiagnostic 4", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[4], "ignitorDiagnostic 5", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[5], "ignitorDiagnostic 6", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[6], "ignitorDiagnostic 7", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[7], "ignitorDiagnostic 8", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[8], "ignitorDiagnostic 9", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[9], "ignitorDiagnostic 10", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[10], "ignitorDiagnostic 11", "", 0},
-	{engine->outputChannels.ignitorDiagnostic[11], "ignitorDiagnostic 12", "", 0},
+	{engine->outputChannels.ignitorDiagnostic[0], "ignitorDiagnostic 1", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[1], "ignitorDiagnostic 2", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[2], "ignitorDiagnostic 3", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[3], "ignitorDiagnostic 4", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[4], "ignitorDiagnostic 5", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[5], "ignitorDiagnostic 6", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[6], "ignitorDiagnostic 7", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[7], "ignitorDiagnostic 8", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[8], "ignitorDiagnostic 9", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[9], "ignitorDiagnostic 10", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[10], "ignitorDiagnostic 11", "", 0, "none", LogRateClass::Medium},
+	{engine->outputChannels.ignitorDiagnostic[11], "ignitorDiagnostic 12", "", 0, "none", LogRateClass::Medium},
 	{engine->outputChannels.injectorDiagnostic[0], "injectorDiagnostic 1", "", 0},
 	{engine->outputChannels.injectorDiagnostic[1], "injectorDiagnostic 2", "", 0},
 	{engine->outputChannels.injectorDiagnostic[2], "injectorDiagnostic 3", "", 0},
@@ -389,7 +389,7 @@ static const LogField fields[] = {
 	{engine->outputChannels.mc33810spiErrorCounter, "mc33810spiErrorCounter", "", 0},
 	{engine->outputChannels.sadDwellRatioCounter, "sadDwellRatioCounter", "", 0},
 	{engine->outputChannels.injectionPrimingCounter, "injectionPrimingCounter", "", 0},
-	{engine->outputChannels.tempLogging2, "tempLogging2", "", 0},
+	{engine->outputChannels.tempLogging2, "tempLogging2", "", 0, "none", LogRateClass::Slow},
 	{engine->outputChannels.acPressure, "A/C pressure", "kPa", 0},
 	{engine->outputChannels.rawAuxAnalog1, "rawAuxAnalog1", "V", 3},
 	{engine->outputChannels.rawAuxAnalog2, "rawAuxAnalog2", "V", 3},
@@ -406,6 +406,18 @@ static const LogField fields[] = {
 	{engine->outputChannels.hp, "hp", "", 0},
 	{engine->outputChannels.torque, "torque", "", 0},
 	{engine->outputChannels.mcuSerial, "mcuSerial", "", 0},
+	{engine->outputChannels.canListenerHitCounter, "CAN: listener hits", "count", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.canListenersById, "CAN: listeners by ID", "count", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.canListenersMasked, "CAN: listeners by mask", "count", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.canListenersLastVisited, "CAN: listeners offered last frame", "count", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.luaCanRxQueueHighWater, "Lua: CAN RX queue high water", "frames", 0},
+	{engine->outputChannels.luaCanRxDropCounter, "Lua: CAN RX dropped frames", "count", 0},
+	{engine->outputChannels.luaCanRxOverflowCounter, "Lua: CAN RX queue overflows", "count", 0},
+	{engine->outputChannels.moduleFastPassMaxUs, "Modules: fast pass max", "us", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.moduleSlowPassMaxUs, "Modules: slow pass max", "us", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.moduleOverrunCount, "Modules: overruns", "count", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.moduleSlowestMaxUs, "Modules: slowest module max", "us", 0, "none", LogRateClass::Slow},
+	{engine->outputChannels.moduleSlowestIndex, "Modules: slowest module", "index", 0, "none", LogRateClass::Slow},
 #if EFI_ENGINE_CONTROL
 	{engine->fuelComputer.totalFuelCorrection, "Fuel: Total correction", "mult", 2, "Fuel: math"},
 #endif
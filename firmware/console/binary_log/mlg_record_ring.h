@@ -0,0 +1,146 @@
+/**
+ * @file mlg_record_ring.h
+ *
+ * Ring of pre-serialized MLG data records between the capture thread, which snapshots
+ * live data at a fixed rate, and the SD writer thread, which only ever sees finished bytes.
+ * SD latency spikes are absorbed by the ring instead of turning in to missing or jittered rows.
+ *
+ * One producer, one consumer. Records are all of the same size, set once per log file.
+ */
+
+#pragma once
+
+#include "buffered_writer.h"
+
+template <size_t TBytes>
+class MlgRecordRing {
+public:
+	/**
+	 * Drops whatever is pending, should only be called while capture is stopped
+	 * @return false if not even one record fits
+	 */
+	bool setRecordSize(size_t recordSize) {
+		m_recordSize = recordSize;
+		m_capacity = recordSize == 0 ? 0 : TBytes / recordSize;
+		m_head = 0;
+		m_tail = 0;
+		highWaterMark = 0;
+		return m_capacity > 0;
+	}
+
+	size_t getCapacity() const {
+		return m_capacity;
+	}
+
+	size_t getRecordSize() const {
+		return m_recordSize;
+	}
+
+	size_t getPendingCount() const {
+		return m_head - m_tail;
+	}
+
+	/**
+	 * Producer side: slot for the next record, nullptr if the writer has fallen too far behind
+	 */
+	uint8_t* beginWrite() {
+		if (m_capacity == 0 || getPendingCount() >= m_capacity) {
+			droppedCounter++;
+			return nullptr;
+		}
+
+		return slot(m_head);
+	}
+
+	/**
+	 * Producer side: the record committed last, the writer may already be done with it but nobody
+	 * overwrites it before the next commit. nullptr if there is none or the ring is too small to tell.
+	 */
+	const uint8_t* getLastWrite() const {
+		if (m_head == 0 || m_capacity < 2) {
+			return nullptr;
+		}
+
+		return slot(m_head - 1);
+	}
+
+	void commitWrite() {
+		size_t pending;
+		{
+			chibios_rt::CriticalSectionLocker csl;
+			m_head = m_head + 1;
+			pending = m_head - m_tail;
+		}
+
+		capturedCounter++;
+		if (pending > highWaterMark) {
+			highWaterMark = pending;
+		}
+	}
+
+	/**
+	 * Consumer side: oldest record, nullptr if there is nothing to write
+	 */
+	const uint8_t* peek() const {
+		return getPendingCount() == 0 ? nullptr : slot(m_tail);
+	}
+
+	void release() {
+		chibios_rt::CriticalSectionLocker csl;
+		m_tail = m_tail + 1;
+	}
+
+	// records which found the ring full
+	uint32_t droppedCounter = 0;
+	uint32_t capturedCounter = 0;
+	// most records ever waiting for the writer, times capture period is the worst writer lag
+	size_t highWaterMark = 0;
+
+private:
+	uint8_t* slot(size_t index) const {
+		return const_cast<uint8_t*>(&m_storage[(index % m_capacity) * m_recordSize]);
+	}
+
+	uint8_t m_storage[TBytes];
+	size_t m_recordSize = 0;
+	size_t m_capacity = 0;
+
+	// free running, only producer moves head and only consumer moves tail
+	volatile size_t m_head = 0;
+	volatile size_t m_tail = 0;
+};
+
+/**
+ * Writer on top of one fixed size record slot
+ */
+class MlgRecordWriter final : public Writer {
+public:
+	MlgRecordWriter(uint8_t* buffer, size_t size)
+		: m_buffer(buffer)
+		, m_size(size)
+	{
+	}
+
+	size_t write(const char* buffer, size_t count) override {
+		if (m_position + count > m_size) {
+			count = m_size - m_position;
+		}
+
+		memcpy(m_buffer + m_position, buffer, count);
+		m_position += count;
+		return count;
+	}
+
+	size_t flush() override {
+		return 0;
+	}
+
+	size_t size() const {
+		return m_position;
+	}
+
+private:
+	uint8_t* const m_buffer;
+	const size_t m_size;
+	size_t m_position = 0;
+};
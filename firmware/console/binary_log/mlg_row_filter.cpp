@@ -0,0 +1,93 @@
+/**
+ * @file mlg_row_filter.cpp
+ */
+
+#include "pch.h"
+
+#include "mlg_row_filter.h"
+#include "binary_logging.h"
+#include "log_field.h"
+
+#if EFI_FILE_LOGGING || EFI_UNIT_TEST
+
+// [block type][rolling counter][timestamp, 2 bytes] then fields then checksum
+#define MLG_BLOCK_HEADER_SIZE 4
+#define MLG_BLOCK_COUNTER_OFFSET 1
+
+void MlgRowFilter::addSpan(size_t offset, size_t size, LogRateClass rateClass) {
+	if (m_spanCount > 0) {
+		Span& last = m_spans[m_spanCount - 1];
+		bool isAdjacent = last.offset + last.size == offset;
+
+		if (isAdjacent && last.rateClass == rateClass) {
+			last.size += size;
+			return;
+		}
+
+		if (m_spanCount == MLG_ROW_FILTER_MAX_SPANS) {
+			// out of spans: the rest is lumped in to the last one as fast, more rows but nothing lost
+			last.size = offset + size - last.offset;
+			last.rateClass = LogRateClass::Fast;
+			return;
+		}
+	}
+
+	m_spans[m_spanCount++] = { (uint16_t)offset, (uint16_t)size, rateClass };
+}
+
+void MlgRowFilter::init() {
+	m_spanCount = 0;
+	m_sequence = 0;
+
+	size_t offset = MLG_BLOCK_HEADER_SIZE;
+	for (int i = 0; i < getSdCardFieldsCount(); i++) {
+		const LogField& field = getSdLogField(i);
+		LogRateClass rateClass = field.getRateClass();
+		if (rateClass == LogRateClass::Ignore) {
+			// skipped fields break adjacency so that they are never compared
+			offset += field.getSize();
+			continue;
+		}
+
+		addSpan(offset, field.getSize(), rateClass);
+		offset += field.getSize();
+	}
+}
+
+bool MlgRowFilter::shouldWrite(uint8_t* record, const uint8_t* previous, efitick_t nowNt) {
+	bool isWrite = !previous;
+
+	if (!isWrite) {
+		efitick_t sinceLastWrite = nowNt - m_lastWriteNt;
+		bool isMediumDue = sinceLastWrite >= MS2NT(MLG_MEDIUM_PERIOD_MS);
+		bool isSlowDue = sinceLastWrite >= MS2NT(MLG_SLOW_PERIOD_MS);
+
+		// heartbeat, slow channels simply ride along with it
+		isWrite = isSlowDue;
+
+		for (size_t i = 0; i < m_spanCount && !isWrite; i++) {
+			const Span& span = m_spans[i];
+
+			if (span.rateClass == LogRateClass::Slow || (span.rateClass == LogRateClass::Medium && !isMediumDue)) {
+				// would not be written yet even if changed
+				continue;
+			}
+
+			isWrite = memcmp(record + span.offset, previous + span.offset, span.size) != 0;
+		}
+	}
+
+	if (!isWrite) {
+		skippedCounter++;
+		return false;
+	}
+
+	// gap-free rolling counter for the reader
+	record[MLG_BLOCK_COUNTER_OFFSET] = m_sequence++;
+
+	m_lastWriteNt = nowNt;
+	writtenCounter++;
+	return true;
+}
+
+#endif /* EFI_FILE_LOGGING */
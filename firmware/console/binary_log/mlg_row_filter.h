@@ -0,0 +1,73 @@
+/**
+ * @file mlg_row_filter.h
+ *
+ * Variable rate MLG logging, see sdCardLogVariableRate: capture runs at full rate but a row is only
+ * written when it has something new to say. Each LogField carries a rate class:
+ *  - fast channels (RPM, MAP, TPS, AFR...) get a row as soon as any of them changes
+ *  - medium channels (pressures, trims, error flags) at most every MLG_MEDIUM_PERIOD_MS
+ *  - slow channels (temperatures, fuel level, counters) at most every MLG_SLOW_PERIOD_MS
+ * plus a heartbeat row every MLG_SLOW_PERIOD_MS no matter what.
+ *
+ * MLVLG v2 rows always carry every field, so what we save is rows. That pays off while fast channels
+ * are steady, i.e. key on with the engine off. With the engine running RPM and MAP move between
+ * almost any two captures and nearly every row is written, see test_mlg_row_filter.cpp for numbers
+ * from a real log. Written rows are renumbered so the reader never sees a gap in the rolling counter.
+ *
+ * No copy of the previous row is kept here, the caller passes in the last written record which is
+ * still sitting in the MLG record ring.
+ */
+
+#pragma once
+
+#include "efitime.h"
+#include "log_field.h"
+
+#ifndef MLG_MEDIUM_PERIOD_MS
+#define MLG_MEDIUM_PERIOD_MS 100
+#endif
+
+// keep this below 655ms, block timestamp is 10us resolution uint16
+#ifndef MLG_SLOW_PERIOD_MS
+#define MLG_SLOW_PERIOD_MS 500
+#endif
+
+#ifndef MLG_ROW_FILTER_MAX_SPANS
+#define MLG_ROW_FILTER_MAX_SPANS 128
+#endif
+
+class MlgRowFilter {
+public:
+	/**
+	 * Builds the rate class layout of the current log fields
+	 */
+	void init();
+
+	/**
+	 * @param record one full data record as written by captureSdLogRecord
+	 * @param previous last record this filter has let through, nullptr if there is none
+	 * @return true if the record should be written, its sequence number is updated in that case
+	 */
+	bool shouldWrite(uint8_t* record, const uint8_t* previous, efitick_t nowNt);
+
+	size_t getSpanCount() const {
+		return m_spanCount;
+	}
+
+	uint32_t writtenCounter = 0;
+	uint32_t skippedCounter = 0;
+
+private:
+	void addSpan(size_t offset, size_t size, LogRateClass rateClass);
+
+	struct Span {
+		uint16_t offset;
+		uint16_t size;
+		LogRateClass rateClass;
+	};
+
+	Span m_spans[MLG_ROW_FILTER_MAX_SPANS];
+	size_t m_spanCount = 0;
+
+	efitick_t m_lastWriteNt = 0;
+	uint8_t m_sequence = 0;
+};
@@ -1,6 +1,7 @@
 CONSOLE_COMMON_SRC_CPP = 	$(PROJECT_DIR)/console/binary/tooth_logger.cpp \
                          	$(PROJECT_DIR)/console/binary_log/log_field.cpp \
 	                        $(PROJECT_DIR)/console/binary_log/binary_logging.cpp \
+	                        $(PROJECT_DIR)/console/binary_log/mlg_row_filter.cpp \
                          	$(PROJECT_DIR)/console/status_loop.cpp \
 
 
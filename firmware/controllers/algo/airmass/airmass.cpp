@@ -29,7 +29,7 @@ float AirmassVeModelBase::getVe(float rpm, float load, bool postState) const {
 		tps && engineConfiguration->useSeparateVeForIdle) {
 		float idleVeLoad = getVeLoadAxis(engineConfiguration->idleVeOverrideMode, load);
 
-		percent_t idleVe = interpolate3d(
+		percent_t idleVe = engine->axisLookupCache.interpolate3d(
 			config->idleVeTable,
 			config->idleVeLoadBins, idleVeLoad,
 			config->idleVeRpmBins, rpm
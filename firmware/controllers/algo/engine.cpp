@@ -34,6 +34,7 @@
 #include "ac_control.h"
 #include "vr_pwm.h"
 #include "max3185x.h"
+#include "engine_module_profiler.h"
 #if EFI_MC33816
  #include "mc33816.h"
 #endif // EFI_MC33816
@@ -173,7 +174,14 @@ void Engine::periodicSlowCallback() {
 
 	updateGppwm();
 
-	engine->engineModules.apply_all([](auto & m) { m.onSlowCallback(); });
+	{
+		ModuleCallbackPass pass(ModuleCallback::Slow);
+		engine->engineModules.apply_all([](auto & m) { CALL_ENGINE_MODULE(ModuleCallback::Slow, m, onSlowCallback); });
+	}
+
+#if EFI_MODULE_PROFILER
+	publishModuleProfiles();
+#endif /* EFI_MODULE_PROFILER */
 
 #if (BOARD_TLE8888_COUNT > 0)
 	tle8888startup();
@@ -556,7 +564,8 @@ void Engine::periodicFastCallback() {
 	tachUpdate();
 	speedoUpdate();
 
-	engineModules.apply_all([](auto & m) { m.onFastCallback(); });
+	ModuleCallbackPass pass(ModuleCallback::Fast);
+	engineModules.apply_all([](auto & m) { CALL_ENGINE_MODULE(ModuleCallback::Fast, m, onFastCallback); });
 }
 
 EngineRotationState * getEngineRotationState() {
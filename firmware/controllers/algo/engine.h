@@ -13,6 +13,7 @@
 #include "rpm_calculator.h"
 #include "event_registry.h"
 #include "table_helper.h"
+#include "axis_lookup_cache.h"
 #include "listener_array.h"
 #include "accel_enrichment.h"
 #include "trigger_central.h"
@@ -225,6 +226,8 @@ public:
 #endif // EFI_ENGINE_CONTROL
 
 	IgnitionState ignitionState;
+	// RPM/load axis positions shared by all tables looked up within one fast callback
+	AxisLookupCache axisLookupCache;
 	void resetLua();
 
 #if EFI_SHAFT_POSITION_INPUT
@@ -301,6 +304,12 @@ public:
 	 */
 	int globalConfigurationVersion = 0;
 
+	/**
+	 * Unlike globalConfigurationVersion this one also counts online tuning of maps, anything caching
+	 * values derived from the tune should watch this one
+	 */
+	int tuneVersion = 0;
+
 #if EFI_SHAFT_POSITION_INPUT
 	TriggerCentral triggerCentral;
 #endif // EFI_SHAFT_POSITION_INPUT
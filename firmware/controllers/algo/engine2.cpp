@@ -96,6 +96,21 @@ void EngineState::updateSparkSkip() {
 #endif // EFI_LAUNCH_CONTROL
 }
 
+/**
+ * @return true if the value derived from these inputs has to be recomputed
+ */
+template <size_t TInputCount>
+static bool isStale(InputTracker<TInputCount>& tracker, const float (&inputs)[TInputCount]) {
+#if EFI_INCREMENTAL_ENGINE_STATE
+	return tracker.update(engine->tuneVersion, inputs);
+#else
+	// unit tests write the tune directly, bypassing tuneVersion
+	UNUSED(tracker);
+	UNUSED(inputs);
+	return true;
+#endif // EFI_INCREMENTAL_ENGINE_STATE
+}
+
 #define MAKE_HUMAN_READABLE_ADVANCE(advance) (advance > getEngineState()->engineCycle / 2 ? advance - getEngineState()->engineCycle : advance)
 
 void EngineState::periodicFastCallback() {
@@ -116,35 +131,51 @@ void EngineState::periodicFastCallback() {
 
 	engine->fuelComputer.running.timeSinceCrankingInSecs = crankingTimer.getElapsedSeconds(nowNt);
 
+	// from here on every table on the same RPM/load axes reuses the bin search
+	engine->axisLookupCache.beginCycle(engine->tuneVersion);
+
 #if EFI_AUX_VALVES
 	recalculateAuxValveTiming();
 #endif //EFI_AUX_VALVES
 
 	engine->ignitionState.updateDwell(rpm, isCranking);
 
-	// todo: move this into slow callback, no reason for IAT corr to be here
-	engine->fuelComputer.running.intakeTemperatureCoefficient = getIatFuelCorrection();
-	// todo: move this into slow callback, no reason for CLT corr to be here
-	engine->fuelComputer.running.coolantTemperatureCoefficient = getCltFuelCorrection();
+	if (isStale(iatCorrectionInputs, { Sensor::get(SensorType::Iat).value_or(NAN) })) {
+		engine->fuelComputer.running.intakeTemperatureCoefficient = getIatFuelCorrection();
+	}
+	if (isStale(cltCorrectionInputs, { Sensor::get(SensorType::Clt).value_or(NAN) })) {
+		engine->fuelComputer.running.coolantTemperatureCoefficient = getCltFuelCorrection();
+	}
 
 	engine->module<DfcoController>()->update();
 	// should be called before getInjectionMass() and getLimitingTimingRetard()
 	getLimpManager()->updateRevLimit(rpm);
 
 	// post-cranking fuel enrichment.
-	float m_postCrankingFactor = interpolate3d(
-		config->postCrankingFactor,
-		config->postCrankingCLTBins, Sensor::getOrZero(SensorType::Clt),
-		config->postCrankingDurationBins, engine->rpmCalculator.getRevolutionCounterSinceStart()
-	);
-	// for compatibility reasons, apply only if the factor is greater than unity (only allow adding fuel)
-	// if the engine run time is past the last bin, disable ASE in case the table is filled with values more than 1.0, helps with compatibility
-	if ((m_postCrankingFactor < 1.0f) || (engine->rpmCalculator.getRevolutionCounterSinceStart() > config->postCrankingDurationBins[efi::size(config->postCrankingDurationBins)-1])) {
-		m_postCrankingFactor = 1.0f;
+	float lastPostCrankingBin = config->postCrankingDurationBins[efi::size(config->postCrankingDurationBins)-1];
+	// past the last bin it's all the same, no need to keep recomputing
+	float postCrankingRevolutions = std::min<float>(engine->rpmCalculator.getRevolutionCounterSinceStart(), lastPostCrankingBin + 1);
+	if (isStale(postCrankingInputs, { Sensor::getOrZero(SensorType::Clt), postCrankingRevolutions })) {
+		float m_postCrankingFactor = interpolate3d(
+			config->postCrankingFactor,
+			config->postCrankingCLTBins, Sensor::getOrZero(SensorType::Clt),
+			config->postCrankingDurationBins, postCrankingRevolutions
+		);
+		// for compatibility reasons, apply only if the factor is greater than unity (only allow adding fuel)
+		// if the engine run time is past the last bin, disable ASE in case the table is filled with values more than 1.0, helps with compatibility
+		if ((m_postCrankingFactor < 1.0f) || (postCrankingRevolutions > lastPostCrankingBin)) {
+			m_postCrankingFactor = 1.0f;
+		}
+		engine->fuelComputer.running.postCrankingFuelCorrection = m_postCrankingFactor;
 	}
-	engine->fuelComputer.running.postCrankingFuelCorrection = m_postCrankingFactor;
 
-	baroCorrection = getBaroCorrection();
+	// without baro sensor the correction is constant
+	bool hasBaroSensor = Sensor::hasSensor(SensorType::BarometricPressure);
+	if (isStale(baroCorrectionInputs, {
+			hasBaroSensor ? Sensor::get(SensorType::BarometricPressure).value_or(101.325f) : NAN,
+			hasBaroSensor ? rpm : NAN })) {
+		baroCorrection = getBaroCorrection();
+	}
 
 	auto tps = Sensor::get(SensorType::Tps1);
 	updateTChargeK(rpm, tps.value_or(0));
@@ -216,6 +247,8 @@ void EngineState::periodicFastCallback() {
 #if EFI_ANTILAG_SYSTEM
 	engine->antilagController.update();
 #endif //EFI_ANTILAG_SYSTEM
+
+	engine->axisLookupCache.endCycle();
 #endif // EFI_SHAFT_POSITION_INPUT
 }
 
@@ -11,6 +11,7 @@
 #include "global.h"
 #include "engine_parts.h"
 #include "engine_state_generated.h"
+#include "input_tracker.h"
 
 class EngineState : public engine_state_s {
 public:
@@ -90,6 +91,18 @@ public:
 	multispark_state multispark;
 
 	bool shouldUpdateInjectionTiming = true;
+
+	/**
+	 * Slow moving corrections are only recomputed once their inputs move, see EFI_INCREMENTAL_ENGINE_STATE
+	 */
+	// IAT
+	InputTracker<1> iatCorrectionInputs{{0.1f}};
+	// CLT
+	InputTracker<1> cltCorrectionInputs{{0.1f}};
+	// CLT, revolutions since start
+	InputTracker<2> postCrankingInputs{{0.1f, 0}};
+	// baro pressure, RPM
+	InputTracker<2> baroCorrectionInputs{{0.1f, 0}};
 };
 
 EngineState * getEngineState();
@@ -12,14 +12,24 @@
 #include "scheduler.h"
 #include "fl_stack.h"
 #include "trigger_structure.h"
+#include "event_phase_index.h"
 
 struct AngleBasedEvent {
 	scheduling_s eventScheduling;
 	action_s action;
 	/**
-	 * Trigger-based scheduler maintains a linked list of all pending tooth-based events.
+	 * Trigger-based scheduler maintains a linked list of pending tooth-based events per angle bucket.
 	 */
 	AngleBasedEvent *nextToothEvent = nullptr;
+	static constexpr uint8_t NOT_QUEUED = 0xFF;
+	/**
+	 * Index of the TriggerScheduler bucket this event is queued into, NOT_QUEUED if not pending
+	 */
+	uint8_t toothBucket = NOT_QUEUED;
+#if EFI_UNIT_TEST
+	// global insertion order across all buckets, only used to inspect the queue in unit tests
+	uint32_t queueOrder = 0;
+#endif // EFI_UNIT_TEST
 
   // angular position of this event
   angle_t getAngle() const {
@@ -98,6 +108,8 @@ public:
 	 */
 	IgnitionEvent elements[MAX_CYLINDER_COUNT];
 	bool isReady = false;
+	// dwell start angles, see onTriggerEventSparkLogic
+	EventPhaseIndex<MAX_CYLINDER_COUNT> phaseIndex;
 };
 
 class AuxActor {
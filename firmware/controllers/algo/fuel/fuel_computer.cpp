@@ -58,7 +58,7 @@ float FuelComputer::getStoichiometricRatio() const {
 
 
 float FuelComputer::getTargetLambda(float rpm, float load) const {
-	float target = interpolate3d(
+	float target = engine->axisLookupCache.interpolate3d(
 		config->lambdaTable,
 		config->lambdaLoadBins, load,
 		config->lambdaRpmBins, rpm
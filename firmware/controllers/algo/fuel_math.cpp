@@ -218,7 +218,7 @@ angle_t getInjectionOffset(float rpm, float load) {
 		return 0; // error already reported
 	}
 
-	angle_t value = interpolate3d(
+	angle_t value = engine->axisLookupCache.interpolate3d(
 		config->injectionPhase,
 		config->injPhaseLoadBins, load,
 		config->injPhaseRpmBins, rpm
@@ -438,7 +438,7 @@ float getStandardAirCharge() {
 
 PUBLIC_API_WEAK_SOMETHING_WEIRD
 float getCylinderFuelTrim(size_t cylinderNumber, float rpm, float fuelLoad) {
-	auto trimPercent = interpolate3d(
+	auto trimPercent = engine->axisLookupCache.interpolate3d(
 		config->fuelTrims[cylinderNumber].table,
 		config->fuelTrimLoadBins, fuelLoad,
 		config->fuelTrimRpmBins, rpm
@@ -457,7 +457,7 @@ float getStage2InjectionFraction(float rpm, float load) {
 		return 0;
 	}
 
-	float frac = 0.01f * interpolate3d(
+	float frac = 0.01f * engine->axisLookupCache.interpolate3d(
 		config->injectorStagingTable,
 		config->injectorStagingLoadBins, load,
 		config->injectorStagingRpmBins, rpm
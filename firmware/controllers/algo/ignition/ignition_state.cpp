@@ -47,7 +47,7 @@ angle_t getRunningAdvance(float rpm, float engineLoad) {
 	efiAssert(ObdCode::CUSTOM_ERR_ASSERT, !std::isnan(engineLoad), "invalid el", NAN);
 
 	// compute base ignition angle from main table
-	float advanceAngle = interpolate3d(
+	float advanceAngle = engine->axisLookupCache.interpolate3d(
 		config->ignitionTable,
 		config->ignitionLoadBins, engineLoad,
 		config->ignitionRpmBins, rpm
@@ -242,7 +242,7 @@ angle_t IgnitionState::getWrappedAdvance(const float rpm, const float engineLoad
 }
 
 angle_t getCylinderIgnitionTrim(size_t cylinderNumber, float rpm, float ignitionLoad) {
-	return interpolate3d(
+	return engine->axisLookupCache.interpolate3d(
 		config->ignTrims[cylinderNumber].table,
 		config->ignTrimLoadBins, ignitionLoad,
 		config->ignTrimRpmBins, rpm
@@ -339,7 +339,7 @@ floatms_t IgnitionState::getDwell() const {
 		// default value from: https://github.com/rusefi/rusefi/commit/86683afca22ed1a8af8fd5ac9231442e2124646e#diff-6e80cdd8c55add68105618ad9e8954170a47f59814201dadd2b888509d6b2e39R176
 		return 10;
 	}
-	return interpolate3d(
+	return engine->axisLookupCache.interpolate3d(
 			config->trailingSparkTable,
 			config->trailingSparkLoadBins, engineLoad,
 			config->trailingSparkRpmBins, rpm
@@ -50,6 +50,8 @@ class CanSensorBase;
 
 #if EFI_CAN_SUPPORT
 void processCanRxMessage(const size_t busIndex, const CANRxFrame& msg, efitick_t nowNt);
+// registered listeners with their hit counters, see 'canlisteners' console command
+void printCanListeners();
 #endif // EFI_CAN_SUPPORT
 
 void registerCanListener(CanListener& listener);
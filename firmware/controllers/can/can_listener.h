@@ -9,25 +9,63 @@
 
 #include "can.h"
 
+// mask which compares every bit of a standard or extended ID
+#define CAN_LISTENER_EXACT_MASK 0x1FFFFFFF
+
 class CanListener {
 public:
-	CanListener(uint32_t id)
+	/**
+	 * Frames whose ID matches id in all bits of mask are offered to acceptFrame, this is what
+	 * the RX dispatch index is built from. Pass a narrower mask (0 for any ID) if acceptFrame
+	 * takes anything but exactly this ID.
+	 */
+	CanListener(uint32_t id, uint32_t mask = CAN_LISTENER_EXACT_MASK)
 		: m_id(id)
+		, m_mask(mask)
 	{
 	}
 
 	CanListener* processFrame(const CANRxFrame& frame, efitick_t nowNt) {
-		if (acceptFrame(frame)) {
-			decodeFrame(frame, nowNt);
-		}
+		tryDecode(frame, nowNt);
 
 		return m_next;
 	}
 
-	uint32_t getId() {
+	/**
+	 * @return true if the frame was accepted and decoded
+	 */
+	bool tryDecode(const CANRxFrame& frame, efitick_t nowNt) {
+		if (!acceptFrame(frame)) {
+			return false;
+		}
+
+		m_hitCounter++;
+		decodeFrame(frame, nowNt);
+		return true;
+	}
+
+	uint32_t getId() const {
 		return m_id;
 	}
 
+	uint32_t getMask() const {
+		return m_mask;
+	}
+
+	bool isIdMatch(uint32_t id) const {
+		return ((id ^ m_id) & m_mask) == 0;
+	}
+
+	// Only frames with getId() get past the mask
+	bool isIdExactMatch() const {
+		return (m_mask & CAN_LISTENER_EXACT_MASK) == CAN_LISTENER_EXACT_MASK;
+	}
+
+	// How many frames this listener has accepted and decoded
+	uint32_t getHitCounter() const {
+		return m_hitCounter;
+	}
+
 	void setNext(CanListener* next) {
 		m_next = next;
 	}
@@ -36,14 +74,19 @@ public:
 		return m_next;
 	}
 
+	CanListener* getNext() const {
+		return m_next;
+	}
+
 	bool hasNext() const {
 		return m_next;
 	}
 
 	// Return true if the provided frame should be accepted for processing by the listener.
-	// Override if you need more complex logic than comparing to a single ID.
+	// Override if you need more complex logic than comparing to a single ID, an override
+	// only ever sees frames which passed the ID and mask given to the constructor.
 	virtual bool acceptFrame(const CANRxFrame& frame) const {
-		return CAN_ID(frame) == m_id;
+		return isIdMatch(CAN_ID(frame));
 	}
 
 protected:
@@ -51,6 +94,8 @@ protected:
 
 private:
 	CanListener* m_next = nullptr;
+	uint32_t m_hitCounter = 0;
 
 	const uint32_t m_id;
+	const uint32_t m_mask;
 };
@@ -0,0 +1,96 @@
+/**
+ * @file	can_listener_index.cpp
+ */
+
+#include "pch.h"
+
+#include "can_listener_index.h"
+
+size_t CanListenerIndex::lowerBound(uint32_t id) const {
+	size_t low = 0;
+	size_t high = m_indexedCount;
+
+	while (low < high) {
+		size_t middle = (low + high) / 2;
+		if (m_indexed[middle].id < id) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+bool CanListenerIndex::add(CanListener& listener) {
+	if (!listener.isIdExactMatch()) {
+		if (m_fallbackCount >= CAN_LISTENER_FALLBACK_SIZE) {
+			return false;
+		}
+
+		m_fallback[m_fallbackCount++] = &listener;
+		return true;
+	}
+
+	if (m_indexedCount >= CAN_LISTENER_INDEX_SIZE) {
+		return false;
+	}
+
+	uint32_t id = listener.getId();
+
+	// insert after all listeners with the same id
+	size_t position = lowerBound(id + 1);
+	if (id == UINT32_MAX) {
+		position = m_indexedCount;
+	}
+
+	for (size_t i = m_indexedCount; i > position; i--) {
+		m_indexed[i] = m_indexed[i - 1];
+	}
+
+	m_indexed[position] = { id, &listener };
+	m_indexedCount++;
+
+	return true;
+}
+
+void CanListenerIndex::offer(CanListener& listener, const CANRxFrame& frame, efitick_t nowNt) {
+	if (listener.tryDecode(frame, nowNt)) {
+		hitCounter++;
+	}
+}
+
+void CanListenerIndex::dispatch(const CANRxFrame& frame, efitick_t nowNt) {
+	uint32_t id = CAN_ID(frame);
+	size_t visited = 0;
+
+	// add() may shift the table while a listener decodes, so the next listener is looked up again
+	// under the lock add() holds. New listeners only go behind those with the same id, so the
+	// n-th listener of this id stays the same one.
+	for (size_t offered = 0; ; offered++) {
+		CanListener* listener = nullptr;
+		{
+			chibios_rt::CriticalSectionLocker csl;
+			size_t i = lowerBound(id) + offered;
+			if (i < m_indexedCount && m_indexed[i].id == id) {
+				listener = m_indexed[i].listener;
+			}
+		}
+		if (!listener) {
+			break;
+		}
+
+		offer(*listener, frame, nowNt);
+		visited++;
+	}
+
+	// append only, a listener added meanwhile is either seen or not
+	for (size_t i = 0; i < m_fallbackCount; i++) {
+		if (m_fallback[i]->isIdMatch(id)) {
+			offer(*m_fallback[i], frame, nowNt);
+			visited++;
+		}
+	}
+
+	visitedCounter = visited;
+}
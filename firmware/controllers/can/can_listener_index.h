@@ -0,0 +1,60 @@
+/**
+ * @file	can_listener_index.h
+ *
+ * Finds the CAN listeners interested in a frame without offering the frame to each of them.
+ * Listeners registered with a full ID mask sit in a table sorted by ID and are found with
+ * a binary search, listeners with a narrower mask stay on a fallback list which is checked
+ * against the ID and mask of every frame.
+ */
+
+#pragma once
+
+#include "can_listener.h"
+
+#ifndef CAN_LISTENER_INDEX_SIZE
+#define CAN_LISTENER_INDEX_SIZE 48
+#endif
+
+#ifndef CAN_LISTENER_FALLBACK_SIZE
+#define CAN_LISTENER_FALLBACK_SIZE 16
+#endif
+
+class CanListenerIndex {
+public:
+	/**
+	 * Has to be invoked under lock, dispatch() may be running on another thread
+	 * @return false if there is no room left for this listener
+	 */
+	bool add(CanListener& listener);
+
+	void dispatch(const CANRxFrame& frame, efitick_t nowNt);
+
+	size_t getIndexedCount() const {
+		return m_indexedCount;
+	}
+
+	size_t getFallbackCount() const {
+		return m_fallbackCount;
+	}
+
+	// number of listeners offered the last dispatched frame
+	size_t visitedCounter = 0;
+	// frames accepted, summed over all listeners
+	uint32_t hitCounter = 0;
+
+private:
+	struct Entry {
+		uint32_t id;
+		CanListener* listener;
+	};
+
+	size_t lowerBound(uint32_t id) const;
+	void offer(CanListener& listener, const CANRxFrame& frame, efitick_t nowNt);
+
+	// sorted by id, listeners sharing an id keep their registration order
+	Entry m_indexed[CAN_LISTENER_INDEX_SIZE];
+	size_t m_indexedCount = 0;
+
+	CanListener* m_fallback[CAN_LISTENER_FALLBACK_SIZE];
+	size_t m_fallbackCount = 0;
+};
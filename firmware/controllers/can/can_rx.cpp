@@ -19,6 +19,7 @@
 #include "can_rx.h"
 #include "obd2.h"
 #include "can_sensor.h"
+#include "can_listener_index.h"
 #include "can_vss.h"
 #include "rusefi_wideband.h"
 #include "wideband_firmware/for_rusefi/wideband_can.h"
@@ -67,26 +68,45 @@ struct CanListenerTailSentinel : public CanListener {
 };
 
 static CanListenerTailSentinel tailSentinel;
+// all registered listeners, can_tx walks this list to let listeners send their requests
 CanListener *canListeners_head = &tailSentinel;
+// same listeners looked up by frame ID, this is what incoming frames go through
+static CanListenerIndex canListenerIndex;
 
 void serviceCanSubscribers(const CANRxFrame &frame, efitick_t nowNt) {
-	CanListener *current = canListeners_head;
-	size_t iterationValidationCounter = 0;
-
-	while (current) {
-		current = current->processFrame(frame, nowNt);
-		if (iterationValidationCounter++ > 239) {
-		  criticalError("forever loop canListeners_head");
-		  return;
-		}
-	}
+	canListenerIndex.dispatch(frame, nowNt);
+
+	engine->outputChannels.canListenerHitCounter = canListenerIndex.hitCounter;
+	engine->outputChannels.canListenersLastVisited = canListenerIndex.visitedCounter;
 }
 
 void registerCanListener(CanListener& listener) {
 	// If the listener already has a next, it's already registered
 	if (!listener.hasNext()) {
+		chibios_rt::CriticalSectionLocker csl;
+
+		if (!canListenerIndex.add(listener)) {
+			criticalError("Too many CAN listeners, %x not registered", (int)listener.getId());
+			return;
+		}
+
 		listener.setNext(canListeners_head);
 		canListeners_head = &listener;
+
+		engine->outputChannels.canListenersById = canListenerIndex.getIndexedCount();
+		engine->outputChannels.canListenersMasked = canListenerIndex.getFallbackCount();
+	}
+}
+
+void printCanListeners() {
+	efiPrintf("CAN listeners: %d by ID, %d by mask, last frame offered to %d",
+			(int)canListenerIndex.getIndexedCount(),
+			(int)canListenerIndex.getFallbackCount(),
+			(int)canListenerIndex.visitedCounter);
+
+	for (CanListener* current = canListeners_head; current != &tailSentinel; current = current->getNext()) {
+		efiPrintf("  ID %x mask %x hits=%d", current->getId(), current->getMask(),
+				(int)current->getHitCounter());
 	}
 }
 
@@ -30,7 +30,9 @@ CONTROLLERS_SRC_CPP = \
 	$(CONTROLLERS_DIR)/gauges/malfunction_indicator.cpp \
 	$(CONTROLLERS_DIR)/system/timer/single_timer_executor.cpp \
 	$(CONTROLLERS_DIR)/system/timer/pwm_generator_logic.cpp \
+	$(CONTROLLERS_DIR)/system/timer/pwm_group.cpp \
 	$(CONTROLLERS_DIR)/system/timer/event_queue.cpp \
+	$(CONTROLLERS_DIR)/system/timer/event_timing_stats.cpp \
 	$(CONTROLLERS_DIR)/settings.cpp \
 	$(CONTROLLERS_DIR)/core/error_handling.cpp \
 	$(CONTROLLERS_DIR)/engine_cycle/map_averaging.cpp \
@@ -49,6 +51,7 @@ CONTROLLERS_SRC_CPP = \
 	$(CONTROLLERS_DIR)/can/obd2.cpp \
 	$(CONTROLLERS_DIR)/can/can_verbose.cpp \
 	$(CONTROLLERS_DIR)/can/can_rx.cpp \
+	$(CONTROLLERS_DIR)/can/can_listener_index.cpp \
 	$(CONTROLLERS_DIR)/can/can_bench_test.cpp \
 	$(CONTORLLERS_DIR)/can/rusefi_wideband.cpp \
 	$(CONTROLLERS_DIR)/can/can_tx.cpp \
@@ -0,0 +1,150 @@
+/**
+ * @file engine_module_profiler.cpp
+ */
+
+#include "pch.h"
+
+#include "engine_module_profiler.h"
+
+#if EFI_MODULE_PROFILER
+
+#if EFI_PROD_CODE
+// cycle counter, same as perf trace
+#define MODULE_PROFILER_TICKS_PER_US (CORE_CLOCK / 1000000)
+#else
+#define MODULE_PROFILER_TICKS_PER_US US_TO_NT_MULTIPLIER
+#endif
+
+static ModuleProfile profiles[MODULE_PROFILER_MAX_MODULES];
+static size_t profileCount = 0;
+static ModuleTiming fastTotal;
+static ModuleTiming slowTotal;
+
+uint32_t getModuleProfilerTicks() {
+#if EFI_PROD_CODE
+	return port_rt_get_counter_value();
+#else
+	return getTimeNowLowerNt();
+#endif
+}
+
+uint32_t getModuleBudgetTicks(ModuleCallback callback) {
+	uint32_t periodMs = callback == ModuleCallback::Fast ? FAST_CALLBACK_PERIOD_MS : SLOW_CALLBACK_PERIOD_MS;
+	return periodMs * 1000 * MODULE_PROFILER_TICKS_PER_US / MODULE_PROFILER_BUDGET_SHARE;
+}
+
+ModuleProfile* registerModuleProfile(const char* signature) {
+	// fast and slow callbacks run on different threads, either could come first
+	chibios_rt::CriticalSectionLocker csl;
+
+	for (size_t i = 0; i < profileCount; i++) {
+		if (profiles[i].signature == signature) {
+			return &profiles[i];
+		}
+	}
+
+	if (profileCount == MODULE_PROFILER_MAX_MODULES) {
+		return nullptr;
+	}
+
+	ModuleProfile& profile = profiles[profileCount++];
+	profile.signature = signature;
+	return &profile;
+}
+
+size_t getModuleProfileCount() {
+	return profileCount;
+}
+
+ModuleProfile& getModuleProfile(size_t index) {
+	return profiles[index];
+}
+
+void getModuleProfileName(const ModuleProfile& profile, char* buffer, size_t size) {
+	// "const char* getModuleSignature() [with TModule = IdleController]"
+	const char* name = strstr(profile.signature, "= ");
+	name = name ? name + 2 : profile.signature;
+
+	size_t length = 0;
+	while (name[length] != 0 && name[length] != ']' && name[length] != ';' && length + 1 < size) {
+		buffer[length] = name[length];
+		length++;
+	}
+	buffer[length] = 0;
+}
+
+ModuleTiming& getModuleCallbackTotal(ModuleCallback callback) {
+	return callback == ModuleCallback::Fast ? fastTotal : slowTotal;
+}
+
+void resetModuleProfiles() {
+	for (size_t i = 0; i < profileCount; i++) {
+		profiles[i].fast.reset();
+		profiles[i].slow.reset();
+	}
+	fastTotal.reset();
+	slowTotal.reset();
+}
+
+static uint16_t ticksToUs(uint32_t ticks) {
+	return std::min<uint32_t>(ticks / MODULE_PROFILER_TICKS_PER_US, UINT16_MAX);
+}
+
+void publishModuleProfiles() {
+	uint32_t overruns = 0;
+	size_t slowest = 0;
+	uint32_t slowestTicks = 0;
+	for (size_t i = 0; i < profileCount; i++) {
+		overruns += profiles[i].fast.overrunCount + profiles[i].slow.overrunCount;
+		uint32_t ticks = std::max(profiles[i].fast.maxTicks, profiles[i].slow.maxTicks);
+		if (ticks > slowestTicks) {
+			slowest = i;
+			slowestTicks = ticks;
+		}
+	}
+
+	engine->outputChannels.moduleFastPassMaxUs = ticksToUs(fastTotal.maxTicks);
+	engine->outputChannels.moduleSlowPassMaxUs = ticksToUs(slowTotal.maxTicks);
+	engine->outputChannels.moduleOverrunCount = std::min<uint32_t>(overruns, UINT16_MAX);
+	engine->outputChannels.moduleSlowestMaxUs = ticksToUs(slowestTicks);
+	// index into the "moduleprofile" table
+	engine->outputChannels.moduleSlowestIndex = slowest;
+}
+
+static void printTiming(const char* name, const char* callback, const ModuleTiming& timing) {
+	if (timing.count == 0) {
+		return;
+	}
+
+	efiPrintf("%-24s %s min %d avg %d max %d ticks, max %dus, %d calls, %d overruns",
+		name, callback,
+		(int)timing.minTicks, (int)timing.getAverage(), (int)timing.maxTicks,
+		(int)(timing.maxTicks / MODULE_PROFILER_TICKS_PER_US),
+		(int)timing.count, (int)timing.overrunCount);
+}
+
+static void printModuleProfiles() {
+	efiPrintf("%d modules, overrun over %dus fast / %dus slow per module",
+		(int)profileCount,
+		(int)(getModuleBudgetTicks(ModuleCallback::Fast) / MODULE_PROFILER_TICKS_PER_US),
+		(int)(getModuleBudgetTicks(ModuleCallback::Slow) / MODULE_PROFILER_TICKS_PER_US));
+
+	char name[32];
+	for (size_t i = 0; i < profileCount; i++) {
+		// index is what moduleSlowestIndex output channel points at
+		int length = chsnprintf(name, sizeof(name), "%2d ", (int)i);
+		getModuleProfileName(profiles[i], name + length, sizeof(name) - length);
+		printTiming(name, "fast", profiles[i].fast);
+		printTiming(name, "slow", profiles[i].slow);
+	}
+
+	printTiming("   all modules", "fast", fastTotal);
+	printTiming("   all modules", "slow", slowTotal);
+}
+
+void initModuleProfiler() {
+	addConsoleAction("moduleprofile", printModuleProfiles);
+	addConsoleAction("moduleprofilereset", resetModuleProfiles);
+}
+
+#endif /* EFI_MODULE_PROFILER */
@@ -0,0 +1,149 @@
+/**
+ * @file engine_module_profiler.h
+ *
+ * Timing of every engine module's fast and slow callback: min/avg/max in profiler ticks (CPU cycles
+ * on real hardware) plus how many calls took more than their share of the callback period.
+ * "moduleprofile" prints the table, "moduleprofilereset" starts over. The worst numbers also go to
+ * the module* output channels, refreshed once per slow callback.
+ *
+ * With EFI_MODULE_PROFILER off CALL_ENGINE_MODULE is a plain call and none of this is compiled.
+ */
+
+#pragma once
+
+enum class ModuleCallback : uint8_t {
+	Fast,
+	Slow,
+};
+
+#if EFI_MODULE_PROFILER
+
+#ifndef MODULE_PROFILER_MAX_MODULES
+#define MODULE_PROFILER_MAX_MODULES 40
+#endif
+
+// one module call longer than 1/N of the callback period is an overrun, whole pass longer than the period is
+#ifndef MODULE_PROFILER_BUDGET_SHARE
+#define MODULE_PROFILER_BUDGET_SHARE 10
+#endif
+
+struct ModuleTiming {
+	void record(uint32_t ticks, uint32_t budgetTicks) {
+		count++;
+		totalTicks += ticks;
+		if (ticks < minTicks) {
+			minTicks = ticks;
+		}
+		if (ticks > maxTicks) {
+			maxTicks = ticks;
+		}
+		if (ticks > budgetTicks) {
+			overrunCount++;
+		}
+	}
+
+	uint32_t getAverage() const {
+		return count == 0 ? 0 : totalTicks / count;
+	}
+
+	void reset() {
+		*this = ModuleTiming();
+	}
+
+	uint32_t count = 0;
+	uint32_t minTicks = UINT32_MAX;
+	uint32_t maxTicks = 0;
+	uint32_t overrunCount = 0;
+	uint64_t totalTicks = 0;
+};
+
+struct ModuleProfile {
+	ModuleTiming& get(ModuleCallback callback) {
+		return callback == ModuleCallback::Fast ? fast : slow;
+	}
+
+	// __PRETTY_FUNCTION__ of getModuleSignature, see getModuleProfileName
+	const char* signature = nullptr;
+	ModuleTiming fast;
+	ModuleTiming slow;
+};
+
+uint32_t getModuleProfilerTicks();
+uint32_t getModuleBudgetTicks(ModuleCallback callback);
+
+/**
+ * Same signature twice gives the same entry
+ * @return nullptr once MODULE_PROFILER_MAX_MODULES are taken
+ */
+ModuleProfile* registerModuleProfile(const char* signature);
+size_t getModuleProfileCount();
+ModuleProfile& getModuleProfile(size_t index);
+// module type name out of the signature, truncated to fit
+void getModuleProfileName(const ModuleProfile& profile, char* buffer, size_t size);
+
+// whole apply_all pass
+ModuleTiming& getModuleCallbackTotal(ModuleCallback callback);
+void resetModuleProfiles();
+// copies pass maximums, overrun total and the slowest module into output channels
+void publishModuleProfiles();
+void initModuleProfiler();
+
+template <typename TModule>
+const char* getModuleSignature() {
+	return __PRETTY_FUNCTION__;
+}
+
+template <typename TModule>
+ModuleProfile* getModuleProfileFor() {
+	// first call per module type registers it
+	static ModuleProfile* const profile = registerModuleProfile(getModuleSignature<TModule>());
+	return profile;
+}
+
+template <typename TModule, typename TCall>
+void profileModuleCallback(ModuleCallback callback, TModule& module, const TCall& call) {
+	ModuleProfile* profile = getModuleProfileFor<TModule>();
+
+	uint32_t start = getModuleProfilerTicks();
+	call(module);
+	uint32_t elapsed = getModuleProfilerTicks() - start;
+
+	if (profile) {
+		profile->get(callback).record(elapsed, getModuleBudgetTicks(callback));
+	}
+}
+
+/**
+ * Times one whole apply_all pass
+ */
+class ModuleCallbackPass {
+public:
+	explicit ModuleCallbackPass(ModuleCallback callback)
+		: m_callback(callback)
+		, m_start(getModuleProfilerTicks())
+	{
+	}
+
+	~ModuleCallbackPass() {
+		getModuleCallbackTotal(m_callback).record(getModuleProfilerTicks() - m_start,
+			getModuleBudgetTicks(m_callback) * MODULE_PROFILER_BUDGET_SHARE);
+	}
+
+private:
+	const ModuleCallback m_callback;
+	const uint32_t m_start;
+};
+
+#define CALL_ENGINE_MODULE(callback, module, method) \
+	profileModuleCallback(callback, module, [](auto & profiled) { profiled.method(); })
+
+#else
+
+class ModuleCallbackPass {
+public:
+	explicit ModuleCallbackPass(ModuleCallback) { }
+};
+
+#define CALL_ENGINE_MODULE(callback, module, method) (module).method()
+
+#endif /* EFI_MODULE_PROFILER */
@@ -62,6 +62,9 @@
 #include "vr_pwm.h"
 #include "adc_subscription.h"
 #include "gc_generic.h"
+#include "engine_module_profiler.h"
+#include "event_timing_stats.h"
+#include "pwm_group.h"
 
 #if EFI_SENSOR_CHART
 #include "sensor_chart.h"
@@ -417,6 +420,18 @@ void commonInitEngineController() {
 	initConfigActions();
 #endif /* EFI_UNIT_TEST */
 
+#if EFI_MODULE_PROFILER
+	initModuleProfiler();
+#endif /* EFI_MODULE_PROFILER */
+
+#if EFI_EVENT_TIMING_STATS
+	initEventTimingStats();
+#endif /* EFI_EVENT_TIMING_STATS */
+
+#if EFI_PWM_GROUP
+	initPwmGroup();
+#endif /* EFI_PWM_GROUP */
+
 #if EFI_ENGINE_CONTROL
 	/**
 	 * This has to go after 'enginePins.startPins()' in order to
@@ -0,0 +1,179 @@
+/**
+ * @file event_phase_index.h
+ *
+ * Every trigger tooth used to check each cylinder's event angle against the tooth window, almost all
+ * of those checks fail. This index keeps event angles sorted so that a tooth only looks at events
+ * near its own window.
+ *
+ * The index is deliberately coarse: events are candidates within EVENT_PHASE_INDEX_MARGIN of the
+ * window and tooth handlers still make their exact isPhaseInRange check, so an angle has to drift
+ * further than the margin before the index needs a rebuild.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef EVENT_PHASE_INDEX_MARGIN
+#define EVENT_PHASE_INDEX_MARGIN 3
+#endif
+
+template <size_t TCapacity>
+class EventPhaseIndex {
+	static_assert(TCapacity <= 32, "candidates are a bit mask");
+
+public:
+	void invalidate() {
+		m_isValid = false;
+	}
+
+	bool isValid(size_t count, float engineCycle) const {
+		return m_isValid && m_count == count && m_engineCycle == engineCycle;
+	}
+
+	/**
+	 * Call whenever an event angle changes, the index is only dropped once the angle leaves the margin
+	 */
+	void onAngleChanged(size_t event, float angle) {
+		if (!m_isValid || event >= m_count) {
+			return;
+		}
+
+		float indexedAngle = m_eventAngles[event];
+		if (!isIndexable(indexedAngle) || !isIndexable(angle)) {
+			if (isIndexable(indexedAngle) != isIndexable(angle)) {
+				invalidate();
+			}
+			return;
+		}
+
+		float distance = std::abs(angle - indexedAngle);
+		if (distance > m_engineCycle / 2) {
+			// the short way is across the cycle boundary
+			distance = m_engineCycle - distance;
+		}
+
+		if (distance > EVENT_PHASE_INDEX_MARGIN) {
+			invalidate();
+		}
+	}
+
+	/**
+	 * @param getAngle angle of each event by index, NaN or out of cycle events are candidates on every tooth
+	 */
+	template <typename TGetAngle>
+	void rebuild(size_t count, float engineCycle, TGetAngle getAngle) {
+		// set first so that any onAngleChanged() from here on drops us again
+		m_isValid = true;
+		m_count = count;
+		m_engineCycle = engineCycle;
+		m_alwaysCandidates = 0;
+		m_sortedCount = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			float angle = getAngle(i);
+			m_eventAngles[i] = angle;
+
+			if (!isIndexable(angle)) {
+				m_alwaysCandidates |= 1u << i;
+				continue;
+			}
+
+			// insertion sort, we never have more than a dozen
+			size_t position = m_sortedCount++;
+			while (position > 0 && m_sortedAngles[position - 1] > angle) {
+				m_sortedAngles[position] = m_sortedAngles[position - 1];
+				m_sortedEvents[position] = m_sortedEvents[position - 1];
+				position--;
+			}
+			m_sortedAngles[position] = angle;
+			m_sortedEvents[position] = i;
+		}
+	}
+
+	/**
+	 * @return bit mask of events which could be in [currentPhase, nextPhase), superset of isPhaseInRange
+	 */
+	uint32_t getCandidates(float currentPhase, float nextPhase) const {
+		uint32_t all = m_count == 32 ? 0xFFFFFFFF : (1u << m_count) - 1;
+
+		if (!isPhase(currentPhase) || !isPhase(nextPhase) || nextPhase == currentPhase) {
+			// isPhaseInRange says everything for an empty window, don't even try
+			return all;
+		}
+
+		float windowLength = nextPhase > currentPhase
+			? nextPhase - currentPhase
+			: nextPhase + m_engineCycle - currentPhase;
+		if (windowLength + 2 * EVENT_PHASE_INDEX_MARGIN >= m_engineCycle) {
+			return all;
+		}
+
+		float from = currentPhase - EVENT_PHASE_INDEX_MARGIN;
+		if (from < 0) {
+			from += m_engineCycle;
+		}
+		float to = nextPhase + EVENT_PHASE_INDEX_MARGIN;
+		if (to >= m_engineCycle) {
+			to -= m_engineCycle;
+		}
+
+		size_t fromPosition = lowerBound(from);
+		size_t toPosition = lowerBound(to);
+
+		uint32_t candidates = m_alwaysCandidates;
+		if (to > from) {
+			addCandidates(candidates, fromPosition, toPosition);
+		} else {
+			// window wraps around the end of the cycle
+			addCandidates(candidates, fromPosition, m_sortedCount);
+			addCandidates(candidates, 0, toPosition);
+		}
+		return candidates;
+	}
+
+private:
+	bool isIndexable(float angle) const {
+		// NaN fails both
+		return angle >= 0 && angle < m_engineCycle;
+	}
+
+	bool isPhase(float phase) const {
+		return phase >= 0 && phase <= m_engineCycle;
+	}
+
+	// first sorted position at or after the angle
+	size_t lowerBound(float angle) const {
+		size_t low = 0;
+		size_t high = m_sortedCount;
+		while (low < high) {
+			size_t middle = (low + high) / 2;
+			if (m_sortedAngles[middle] < angle) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+		return low;
+	}
+
+	void addCandidates(uint32_t& candidates, size_t fromPosition, size_t toPosition) const {
+		for (size_t i = fromPosition; i < toPosition; i++) {
+			candidates |= 1u << m_sortedEvents[i];
+		}
+	}
+
+	bool m_isValid = false;
+	size_t m_count = 0;
+	float m_engineCycle = 0;
+	uint32_t m_alwaysCandidates = 0;
+
+	// by event index, as of the last rebuild
+	float m_eventAngles[TCapacity];
+
+	size_t m_sortedCount = 0;
+	float m_sortedAngles[TCapacity];
+	uint8_t m_sortedEvents[TCapacity];
+};
@@ -48,6 +48,7 @@ WallFuel& InjectionEvent::getWallFuel() {
 
 void FuelSchedule::invalidate() {
 	isReady = false;
+	phaseIndex.invalidate();
 }
 
 void FuelSchedule::resetOverlapping() {
@@ -137,7 +138,10 @@ bool InjectionEvent::updateInjectionAngle() {
 		// If injector duty cycle is high, lock injection SOI so that we
 		// don't miss injections at or above 100% duty
 		if (getEngineState()->shouldUpdateInjectionTiming) {
+			// trigger handler should not see the new angle with an index which has not caught up yet
+			chibios_rt::CriticalSectionLocker csl;
 			injectionStartAngle = result.Value;
+			getFuelSchedule()->phaseIndex.onAngleChanged(ownIndex, injectionStartAngle);
 		}
 
 		return true;
@@ -229,8 +233,20 @@ void FuelSchedule::onTriggerTooth(efitick_t nowNt, float currentPhase, float nex
 		return;
 	}
 
-	for (size_t i = 0; i < engineConfiguration->cylindersCount; i++) {
-		elements[i].onTriggerTooth(nowNt, currentPhase, nextPhase);
+	size_t cylindersCount = engineConfiguration->cylindersCount;
+	float engineCycle = getEngineState()->engineCycle;
+	if (!phaseIndex.isValid(cylindersCount, engineCycle)) {
+		phaseIndex.rebuild(cylindersCount, engineCycle, [this](size_t i) {
+			return elements[i].injectionStartAngle;
+		});
+	}
+
+	// each injector still checks its own angle, candidates are just the ones worth asking
+	uint32_t candidates = phaseIndex.getCandidates(currentPhase, nextPhase);
+	for (size_t i = 0; i < cylindersCount; i++) {
+		if (candidates & (1u << i)) {
+			elements[i].onTriggerTooth(nowNt, currentPhase, nextPhase);
+		}
 	}
 }
 
@@ -10,6 +10,7 @@
 #include "fl_stack.h"
 #include "trigger_structure.h"
 #include "wall_fuel.h"
+#include "event_phase_index.h"
 
 #define MAX_WIRES_COUNT 2
 
@@ -81,6 +82,8 @@ public:
 	 */
 	InjectionEvent elements[MAX_CYLINDER_COUNT];
 	bool isReady = false;
+	// injection start angles, so that a tooth only visits injectors about to start
+	EventPhaseIndex<MAX_CYLINDER_COUNT> phaseIndex;
 };
 
 FuelSchedule * getFuelSchedule();
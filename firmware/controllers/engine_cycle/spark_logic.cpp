@@ -80,6 +80,12 @@ static int getIgnitionPinForIndex(int cylinderIndex, ignition_mode_e ignitionMod
 	}
 }
 
+// what EventPhaseIndex knows an event by
+static float getPhaseIndexAngle(const IgnitionEvent* event) {
+	// NaN spark is reported on every tooth, that keeps it a candidate
+	return std::isnan(event->sparkAngle) ? NAN : event->dwellAngle;
+}
+
 static void prepareCylinderIgnitionSchedule(angle_t dwellAngleDuration, floatms_t sparkDwell, IgnitionEvent *event) {
 	// todo: clean up this implementation? does not look too nice as is.
 
@@ -127,6 +133,7 @@ static void prepareCylinderIgnitionSchedule(angle_t dwellAngleDuration, floatms_
 	efiAssertVoid(ObdCode::CUSTOM_SPARK_ANGLE_1, !std::isnan(sparkAngle), "sparkAngle#1");
 	wrapAngle(sparkAngle, "findAngle#2", ObdCode::CUSTOM_ERR_6550);
 	event->sparkAngle = sparkAngle;
+	engine->ignitionEvents.phaseIndex.onAngleChanged(event->cylinderIndex, getPhaseIndexAngle(event));
 
 	engine->outputChannels.currentIgnitionMode = static_cast<uint8_t>(ignitionMode);
 
@@ -157,7 +164,12 @@ static void prepareCylinderIgnitionSchedule(angle_t dwellAngleDuration, floatms_
 
 	assertAngleRange(dwellStartAngle, "findAngle dwellStartAngle", ObdCode::CUSTOM_ERR_6550);
 	wrapAngle(dwellStartAngle, "findAngle#7", ObdCode::CUSTOM_ERR_6550);
-	event->dwellAngle = dwellStartAngle;
+	{
+		// trigger handler should not see the new angle with an index which has not caught up yet
+		chibios_rt::CriticalSectionLocker csl;
+		event->dwellAngle = dwellStartAngle;
+		engine->ignitionEvents.phaseIndex.onAngleChanged(event->cylinderIndex, getPhaseIndexAngle(event));
+	}
 
 #if FUEL_MATH_EXTREME_LOGGING
 	if (printFuelDebug) {
@@ -181,7 +193,7 @@ static void fireTrailingSpark(IgnitionOutputPin* pin) {
 	pin->setLow();
 }
 
-static void overFireSparkAndPrepareNextSchedule(IgnitionEvent *event) {
+void overFireSparkAndPrepareNextSchedule(IgnitionEvent *event) {
 #if SPARK_EXTREME_LOGGING
 	efiPrintf("overFireSparkAndPrepareNextSchedule %s", event->outputs[0]->getName());
 #endif /* SPARK_EXTREME_LOGGING */
@@ -502,6 +514,27 @@ static void prepareIgnitionSchedule() {
 	initializeIgnitionActions();
 }
 
+/**
+ * @return bit mask of cylinders which could start dwell on this tooth
+ */
+static uint32_t getSparkCandidates(bool enableOddCylinderWastedSpark, float currentPhase, float nextPhase) {
+	size_t cylindersCount = engineConfiguration->cylindersCount;
+	if (enableOddCylinderWastedSpark) {
+		// dwell could also start 360 degrees away, index does not know about that
+		return (1u << cylindersCount) - 1;
+	}
+
+	IgnitionEventList& events = engine->ignitionEvents;
+	float engineCycle = getEngineState()->engineCycle;
+	if (!events.phaseIndex.isValid(cylindersCount, engineCycle)) {
+		events.phaseIndex.rebuild(cylindersCount, engineCycle, [&events](size_t i) {
+			return getPhaseIndexAngle(&events.elements[i]);
+		});
+	}
+
+	return events.phaseIndex.getCandidates(currentPhase, nextPhase);
+}
+
 void onTriggerEventSparkLogic(float rpm, efitick_t edgeTimestamp, float currentPhase, float nextPhase) {
 	ScopePerf perf(PE::OnTriggerEventSparkLogic);
 
@@ -541,7 +574,13 @@ void onTriggerEventSparkLogic(float rpm, efitick_t edgeTimestamp, float currentP
 		&& getCurrentIgnitionMode() == IM_WASTED_SPARK;
 
 	if (engine->ignitionEvents.isReady) {
+		uint32_t candidates = getSparkCandidates(enableOddCylinderWastedSpark, currentPhase, nextPhase);
+
 		for (size_t i = 0; i < engineConfiguration->cylindersCount; i++) {
+			if (!(candidates & (1u << i))) {
+				continue;
+			}
+
 			IgnitionEvent *event = &engine->ignitionEvents.elements[i];
 
 			angle_t dwellAngle = event->dwellAngle;
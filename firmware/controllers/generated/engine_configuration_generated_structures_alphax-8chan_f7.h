@@ -943,9 +943,11 @@ struct engine_configuration_s {
 	 */
 	uint8_t hip9011Prescaler;
 	/**
+	 * How many received CAN frames may wait for the Lua thread, frames beyond that are dropped. 0 for the firmware maximum.
+	 * units: frames
 	 * offset 425
 	 */
-	uint8_t unusedHip0;
+	uint8_t luaCanRxQueueDepth;
 	/**
 	 * offset 426
 	 */
@@ -2596,8 +2598,9 @@ struct engine_configuration_s {
 	offset 1336 bit 27 */
 	bool sdTriggerLog : 1 {};
 	/**
+	 * 'Normal' mode only: capture at SD logger rate but skip rows in which no fast changing channel has changed. Saves a lot of card space while the engine is off, very little while it runs.
 	offset 1336 bit 28 */
-	bool unused1320_28 : 1 {};
+	bool sdCardLogVariableRate : 1 {};
 	/**
 	offset 1336 bit 29 */
 	bool stepper_dc_use_two_wires : 1 {};
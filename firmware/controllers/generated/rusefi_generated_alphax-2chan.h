@@ -1381,7 +1381,7 @@
 #define show_2chan_presets true
 #define show_tcu_gauges false
 #define show_vvt_output_pin true
-#define SIGNATURE_HASH 419583876
+#define SIGNATURE_HASH 1823108078
 #define SIMULATOR_TUNE_BIN_FILE_NAME "generated/simulator_tune_image.bin"
 #define SIMULATOR_TUNE_BIN_FILE_NAME_PREFIX "generated/simulator_tune_image"
 #define SIMULATOR_TUNE_BIN_FILE_NAME_SUFFIX ".bin"
@@ -1642,6 +1642,8 @@
 #define TS_COMPOSITE_READ 3
 #define TS_CRC_CHECK_COMMAND 'k'
 #define TS_CRC_CHECK_COMMAND_char k
+#define TS_EVENT_TIMING_COMMAND 'J'
+#define TS_EVENT_TIMING_COMMAND_char J
 #define TS_EXECUTE 'E'
 #define TS_EXECUTE_char E
 #define TS_GET_COMPOSITE_BUFFER_DONE_DIFFERENTLY '8'
@@ -1668,10 +1670,19 @@
 #define TS_OUTPUT_ALL_COMMAND_char A
 #define TS_OUTPUT_COMMAND 'O'
 #define TS_OUTPUT_COMMAND_char O
+#define TS_OUTPUT_DELTA_COMMAND 'D'
+#define TS_OUTPUT_DELTA_COMMAND_char D
+#define TS_OUTPUT_SUBSCRIBE_COMMAND 'P'
+#define TS_OUTPUT_SUBSCRIBE_COMMAND_char P
 #define TS_PERF_TRACE_BEGIN '_'
 #define TS_PERF_TRACE_BEGIN_char _
 #define TS_PERF_TRACE_GET_BUFFER 'b'
 #define TS_PERF_TRACE_GET_BUFFER_char b
+#define TS_PERF_TRACE_STREAM 'y'
+#define TS_PERF_TRACE_STREAM_READ 3
+#define TS_PERF_TRACE_STREAM_START 1
+#define TS_PERF_TRACE_STREAM_STOP 2
+#define TS_PERF_TRACE_STREAM_char y
 #define TS_PROTOCOL "001"
 #define TS_QUERY_BOOTLOADER 'L'
 #define TS_QUERY_BOOTLOADER_char L
@@ -1685,6 +1696,7 @@
 #define TS_RESPONSE_CRC_FAILURE 0x82
 #define TS_RESPONSE_FRAMING_ERROR 0x8D
 #define TS_RESPONSE_OK 0
+#define TS_RESPONSE_OUTPUT_PUSH 1
 #define TS_RESPONSE_OUT_OF_RANGE 0x84
 #define TS_RESPONSE_OVERRUN 0x81
 #define TS_RESPONSE_UNDERRUN 0x80
@@ -1872,7 +1884,7 @@
 #define ts_show_wastegate_sensor true
 #define ts_show_wbo_canbus_index true
 #define ts_show_wbo_canbus_set_index true
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-2chan.419583876"
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-2chan.1823108078"
 #define TS_SIMULATE_CAN '>'
 #define TS_SIMULATE_CAN_char >
 #define TS_SINGLE_WRITE_COMMAND 'W'
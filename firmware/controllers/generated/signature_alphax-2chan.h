@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 419583876
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-2chan.419583876"
+#define SIGNATURE_HASH 1823108078
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-2chan.1823108078"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3611121596
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-4chan.3611121596"
+#define SIGNATURE_HASH 2727701462
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-4chan.2727701462"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 4157231800
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-4k-gdi.4157231800"
+#define SIGNATURE_HASH 2187488978
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-4k-gdi.2187488978"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 811463479
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-8chan-revA.811463479"
+#define SIGNATURE_HASH 1173737309
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-8chan-revA.1173737309"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 900623210
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-8chan_f7.900623210"
+#define SIGNATURE_HASH 1074157312
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-8chan_f7.1074157312"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2372758631
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-gold.2372758631"
+#define SIGNATURE_HASH 4173680653
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-gold.4173680653"
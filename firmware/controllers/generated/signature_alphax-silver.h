@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1821268564
-#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-silver.1821268564"
+#define SIGNATURE_HASH 421946942
+#define TS_SIGNATURE "rusEFI master.2025.02.22.alphax-silver.421946942"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2367211817
-#define TS_SIGNATURE "rusEFI master.2025.02.22.atlas.2367211817"
+#define SIGNATURE_HASH 4172346691
+#define TS_SIGNATURE "rusEFI master.2025.02.22.atlas.4172346691"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 698864858
-#define TS_SIGNATURE "rusEFI master.2025.02.22.f407-discovery.698864858"
+#define SIGNATURE_HASH 1544546480
+#define TS_SIGNATURE "rusEFI master.2025.02.22.f407-discovery.1544546480"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 4224195572
-#define TS_SIGNATURE "rusEFI master.2025.02.22.f469-discovery.4224195572"
+#define SIGNATURE_HASH 2388666270
+#define TS_SIGNATURE "rusEFI master.2025.02.22.f469-discovery.2388666270"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3374259559
-#define TS_SIGNATURE "rusEFI master.2025.02.22.f746-discovery.3374259559"
+#define SIGNATURE_HASH 3166118157
+#define TS_SIGNATURE "rusEFI master.2025.02.22.f746-discovery.3166118157"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 840691372
-#define TS_SIGNATURE "rusEFI master.2025.02.22.frankenso_na6.840691372"
+#define SIGNATURE_HASH 1202967238
+#define TS_SIGNATURE "rusEFI master.2025.02.22.frankenso_na6.1202967238"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3136315764
-#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen-112-17.3136315764"
+#define SIGNATURE_HASH 3478674718
+#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen-112-17.3478674718"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 4286684744
-#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen-gm-e67.4286684744"
+#define SIGNATURE_HASH 2317984290
+#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen-gm-e67.2317984290"
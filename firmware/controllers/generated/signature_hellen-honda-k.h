@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2636541713
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen-honda-k.2636541713"
+#define SIGNATURE_HASH 3901641595
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen-honda-k.3901641595"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3276751047
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen121nissan.3276751047"
+#define SIGNATURE_HASH 3068624045
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen121nissan.3068624045"
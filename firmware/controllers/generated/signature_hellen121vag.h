@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2574738876
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen121vag.2574738876"
+#define SIGNATURE_HASH 3974060502
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen121vag.3974060502"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 613234576
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen128.613234576"
+#define SIGNATURE_HASH 1361382394
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen128.1361382394"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1617294002
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen154hyundai.1617294002"
+#define SIGNATURE_HASH 365809368
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen154hyundai.365809368"
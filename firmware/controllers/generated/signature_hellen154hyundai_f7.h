@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3755699491
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen154hyundai_f7.3755699491"
+#define SIGNATURE_HASH 2859684169
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen154hyundai_f7.2859684169"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2680727955
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen72.2680727955"
+#define SIGNATURE_HASH 3932198393
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellen72.3932198393"
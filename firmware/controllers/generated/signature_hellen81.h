@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1449683222
-#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen81.1449683222"
+#define SIGNATURE_HASH 599807356
+#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen81.599807356"
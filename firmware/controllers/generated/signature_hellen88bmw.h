@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1095466069
-#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen88bmw.1095466069"
+#define SIGNATURE_HASH 887308351
+#define TS_SIGNATURE "rusEFI master.2025.01.17.hellen88bmw.887308351"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1187258467
-#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNA6.1187258467"
+#define SIGNATURE_HASH 862723081
+#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNA6.862723081"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3105776301
-#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNA96.3105776301"
+#define SIGNATURE_HASH 3434503879
+#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNA96.3434503879"
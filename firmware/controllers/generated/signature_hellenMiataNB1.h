@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 997799331
-#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNB1.997799331"
+#define SIGNATURE_HASH 1322322377
+#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNB1.1322322377"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1384134431
-#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNB2.1384134431"
+#define SIGNATURE_HASH 656935797
+#define TS_SIGNATURE "rusEFI master.2024.03.09.hellenMiataNB2.656935797"
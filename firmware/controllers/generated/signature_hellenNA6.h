@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3244194194
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellenNA6.3244194194"
+#define SIGNATURE_HASH 3036038648
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellenNA6.3036038648"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2213253638
-#define TS_SIGNATURE "rusEFI master.2025.02.22.hellenNA8_96.2213253638"
+#define SIGNATURE_HASH 4131630700
+#define TS_SIGNATURE "rusEFI master.2025.02.22.hellenNA8_96.4131630700"
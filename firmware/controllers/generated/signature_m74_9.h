@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2936823544
-#define TS_SIGNATURE "rusEFI master.2025.02.22.m74_9.2936823544"
+#define SIGNATURE_HASH 3668206226
+#define TS_SIGNATURE "rusEFI master.2025.02.22.m74_9.3668206226"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3310717432
-#define TS_SIGNATURE "rusEFI master.2025.02.22.mre_f4.3310717432"
+#define SIGNATURE_HASH 2969417106
+#define TS_SIGNATURE "rusEFI master.2025.02.22.mre_f4.2969417106"
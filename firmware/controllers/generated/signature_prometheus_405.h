@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2748944714
-#define TS_SIGNATURE "rusEFI master.2024.09.09.prometheus_405.2748944714"
+#define SIGNATURE_HASH 3597774112
+#define TS_SIGNATURE "rusEFI master.2024.09.09.prometheus_405.3597774112"
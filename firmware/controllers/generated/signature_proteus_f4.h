@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2768194599
-#define TS_SIGNATURE "rusEFI master.2025.02.22.proteus_f4.2768194599"
+#define SIGNATURE_HASH 3512168525
+#define TS_SIGNATURE "rusEFI master.2025.02.22.proteus_f4.3512168525"
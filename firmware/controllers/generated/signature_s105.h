@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 2356377906
-#define TS_SIGNATURE "rusEFI master.2025.01.17.s105.2356377906"
+#define SIGNATURE_HASH 4191896920
+#define TS_SIGNATURE "rusEFI master.2025.01.17.s105.4191896920"
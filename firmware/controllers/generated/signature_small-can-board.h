@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1698917147
-#define TS_SIGNATURE "rusEFI master.2025.02.22.small-can-board.1698917147"
+#define SIGNATURE_HASH 283858801
+#define TS_SIGNATURE "rusEFI master.2025.02.22.small-can-board.283858801"
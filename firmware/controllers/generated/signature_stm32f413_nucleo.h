@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 3529622403
-#define TS_SIGNATURE "rusEFI master.2024.03.09.stm32f413_nucleo.3529622403"
+#define SIGNATURE_HASH 2815033321
+#define TS_SIGNATURE "rusEFI master.2024.03.09.stm32f413_nucleo.2815033321"
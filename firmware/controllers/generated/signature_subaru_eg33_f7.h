@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1056571868
-#define TS_SIGNATURE "rusEFI master.2025.02.22.subaru_eg33_f7.1056571868"
+#define SIGNATURE_HASH 1263680950
+#define TS_SIGNATURE "rusEFI master.2025.02.22.subaru_eg33_f7.1263680950"
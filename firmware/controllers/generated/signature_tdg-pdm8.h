@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 164971896
-#define TS_SIGNATURE "rusEFI master.2025.01.17.tdg-pdm8.164971896"
+#define SIGNATURE_HASH 2088597778
+#define TS_SIGNATURE "rusEFI master.2025.01.17.tdg-pdm8.2088597778"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 4009244448
-#define TS_SIGNATURE "rusEFI master.2025.02.22.uaefi.4009244448"
+#define SIGNATURE_HASH 2605714250
+#define TS_SIGNATURE "rusEFI master.2025.02.22.uaefi.2605714250"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool config_definition-all.jar based on gen_config.sh by SignatureConsumer
 //
 
-#define SIGNATURE_HASH 1688824204
-#define TS_SIGNATURE "rusEFI master.2025.02.22.uaefi121.1688824204"
+#define SIGNATURE_HASH 285300198
+#define TS_SIGNATURE "rusEFI master.2025.02.22.uaefi121.285300198"
@@ -6,39 +6,130 @@
 #define LUA_RX_MAX_FILTER_COUNT 48
 #endif
 
+static_assert(LUA_RX_MAX_FILTER_COUNT <= 255, "Filter index has to fit uint8_t");
+
 static size_t filterCount = 0;
 static CanFilter filters[LUA_RX_MAX_FILTER_COUNT];
 
+// Filters which match one exact ID, sorted by ID then by filter index.
+// Everything else (masked filters) is only listed in maskedFilters, in the order those were added.
+struct ExactFilterEntry {
+	int32_t Id;
+	uint8_t FilterIndex;
+};
+
+static size_t exactFilterCount = 0;
+static ExactFilterEntry exactFilters[LUA_RX_MAX_FILTER_COUNT];
+static size_t maskedFilterCount = 0;
+static uint8_t maskedFilters[LUA_RX_MAX_FILTER_COUNT];
+
+static bool isExactFilter(uint32_t mask) {
+	return (mask & FILTER_SPECIFIC) == FILTER_SPECIFIC;
+}
+
+static size_t exactLowerBound(int32_t Id) {
+	size_t low = 0;
+	size_t high = exactFilterCount;
+
+	while (low < high) {
+		size_t middle = (low + high) / 2;
+		if (exactFilters[middle].Id < Id) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+static bool isOnBus(const CanFilter& filter, size_t busIndex) {
+	return filter.Bus == ANY_BUS || filter.Bus == (int)busIndex;
+}
+
 CanFilter* getFilterForId(size_t busIndex, int Id) {
-	for (size_t i = 0; i < filterCount; i++) {
-		auto& filter = filters[i];
+	// filters are applied in the order in which those were added: find the first exact one...
+	size_t firstMatch = filterCount;
+	for (size_t i = exactLowerBound(Id); i < exactFilterCount && exactFilters[i].Id == Id; i++) {
+		size_t filterIndex = exactFilters[i].FilterIndex;
+		if (isOnBus(filters[filterIndex], busIndex)) {
+			firstMatch = filterIndex;
+			break;
+		}
+	}
 
-		if (filter.accept(Id)) {
-			if (filter.Bus == ANY_BUS || filter.Bus == (int)busIndex) {
-				return &filter;
-			}
+	// ...and only look at masked filters which were added before it
+	for (size_t i = 0; i < maskedFilterCount && maskedFilters[i] < firstMatch; i++) {
+		auto& filter = filters[maskedFilters[i]];
+
+		if (filter.accept(Id) && isOnBus(filter, busIndex)) {
+			firstMatch = maskedFilters[i];
+			break;
 		}
 	}
 
-	return nullptr;
+	return firstMatch < filterCount ? &filters[firstMatch] : nullptr;
+}
+
+bool hasLuaCanRxFilterCallback(size_t busIndex) {
+	for (size_t i = 0; i < filterCount; i++) {
+		if (filters[i].Callback != NO_CALLBACK && isOnBus(filters[i], busIndex)) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void resetLuaCanRx() {
 	// Clear all lua filters - reloading the script will reinit them
 	filterCount = 0;
+	exactFilterCount = 0;
+	maskedFilterCount = 0;
 }
 
 void addLuaCanRxFilter(int32_t eid, uint32_t mask, int bus, int callback) {
 	if (filterCount >= LUA_RX_MAX_FILTER_COUNT) {
 		criticalError("Too many Lua CAN RX filters");
+		return;
 	}
 
 	efiPrintf("Added Lua CAN RX filter id 0x%x mask 0x%x with%s custom function", (unsigned int)eid, (unsigned int)mask, (callback == -1 ? "out" : ""));
 
-	filters[filterCount].Id = eid;
-	filters[filterCount].Mask = mask;
-	filters[filterCount].Bus = bus;
-	filters[filterCount].Callback = callback;
+	uint8_t filterIndex = filterCount;
+
+	filters[filterIndex].Id = eid;
+	filters[filterIndex].Mask = mask;
+	filters[filterIndex].Bus = bus;
+	filters[filterIndex].Callback = callback;
+	filters[filterIndex].HitCounter = 0;
+
+	if (isExactFilter(mask)) {
+		// after all filters with the same ID since it was added last
+		size_t position = exactLowerBound(eid);
+		while (position < exactFilterCount && exactFilters[position].Id == eid) {
+			position++;
+		}
+
+		for (size_t i = exactFilterCount; i > position; i--) {
+			exactFilters[i] = exactFilters[i - 1];
+		}
+
+		exactFilters[position] = { eid, filterIndex };
+		exactFilterCount++;
+	} else {
+		maskedFilters[maskedFilterCount++] = filterIndex;
+	}
 
 	filterCount++;
 }
+
+void printLuaCanRxFilters() {
+	efiPrintf("Lua CAN RX filters: %d exact, %d masked", (int)exactFilterCount, (int)maskedFilterCount);
+
+	for (size_t i = 0; i < filterCount; i++) {
+		auto& filter = filters[i];
+		efiPrintf("  id 0x%x mask 0x%x bus %d: %d frames", (unsigned int)filter.Id, (unsigned int)filter.Mask,
+			filter.Bus, (int)filter.HitCounter);
+	}
+}
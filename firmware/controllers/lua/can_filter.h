@@ -13,6 +13,9 @@ struct CanFilter {
 	int Bus;
 	int Callback;
 
+	// frames accepted by this filter, including the ones dropped because Lua RX queue was full
+	uint32_t HitCounter;
+
 	bool accept(int p_Id) {
 	    return (p_Id & this->Mask) == Id;
 	}
@@ -23,4 +26,10 @@ void resetLuaCanRx();
 // Adds a frame ID to listen to
 void addLuaCanRxFilter(int32_t eid, uint32_t mask, int bus, int callback);
 
+// First filter in the order those were added which accepts this frame, nullptr if none
 CanFilter* getFilterForId(size_t busIndex, int Id);
+
+// Is there a filter with its own callback which takes frames of this bus
+bool hasLuaCanRxFilterCallback(size_t busIndex);
+
+void printLuaCanRxFilters();
@@ -834,6 +834,42 @@ float getOutputValueByName(const char *name) {
 // mcuSerial
 		case 714144074:
 			return engine->outputChannels.mcuSerial;
+// canListenerHitCounter
+		case -1392728702:
+			return engine->outputChannels.canListenerHitCounter;
+// canListenersById
+		case 29092440:
+			return engine->outputChannels.canListenersById;
+// canListenersMasked
+		case 2019293733:
+			return engine->outputChannels.canListenersMasked;
+// canListenersLastVisited
+		case 1657750652:
+			return engine->outputChannels.canListenersLastVisited;
+// luaCanRxQueueHighWater
+		case 972215435:
+			return engine->outputChannels.luaCanRxQueueHighWater;
+// luaCanRxDropCounter
+		case 786524152:
+			return engine->outputChannels.luaCanRxDropCounter;
+// luaCanRxOverflowCounter
+		case 1552810839:
+			return engine->outputChannels.luaCanRxOverflowCounter;
+// moduleFastPassMaxUs
+		case -41647682:
+			return engine->outputChannels.moduleFastPassMaxUs;
+// moduleSlowPassMaxUs
+		case 377085653:
+			return engine->outputChannels.moduleSlowPassMaxUs;
+// moduleOverrunCount
+		case -1276716283:
+			return engine->outputChannels.moduleOverrunCount;
+// moduleSlowestMaxUs
+		case 642587786:
+			return engine->outputChannels.moduleSlowestMaxUs;
+// moduleSlowestIndex
+		case 638288980:
+			return engine->outputChannels.moduleSlowestIndex;
 // totalFuelCorrection
 #if EFI_ENGINE_CONTROL
 		case -1779658835:
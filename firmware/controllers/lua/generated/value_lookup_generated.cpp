@@ -251,6 +251,9 @@ float getConfigValueByName(const char *name) {
 // hip9011Prescaler
 		case 1548430930:
 			return engineConfiguration->hip9011Prescaler;
+// luaCanRxQueueDepth
+		case -317086307:
+			return engineConfiguration->luaCanRxQueueDepth;
 // alternator_iTermMin
 		case 107641733:
 			return engineConfiguration->alternator_iTermMin;
@@ -908,6 +911,9 @@ float getConfigValueByName(const char *name) {
 // sdTriggerLog
 		case -105464622:
 			return engineConfiguration->sdTriggerLog;
+// sdCardLogVariableRate
+		case 2056516266:
+			return engineConfiguration->sdCardLogVariableRate;
 // stepper_dc_use_two_wires
 		case 2136379132:
 			return engineConfiguration->stepper_dc_use_two_wires;
@@ -2382,6 +2388,11 @@ bool setConfigValueByName(const char *name, float value) {
 	{
 		engineConfiguration->hip9011Prescaler = (int)value;
 		return 1;
+	}
+		case -317086307:
+	{
+		engineConfiguration->luaCanRxQueueDepth = (int)value;
+		return 1;
 	}
 		case 107641733:
 	{
@@ -3477,6 +3488,11 @@ bool setConfigValueByName(const char *name, float value) {
 	{
 		engineConfiguration->sdTriggerLog = (int)value;
 		return 1;
+	}
+		case 2056516266:
+	{
+		engineConfiguration->sdCardLogVariableRate = (int)value;
+		return 1;
 	}
 		case 2136379132:
 	{
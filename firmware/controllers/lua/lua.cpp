@@ -299,6 +299,7 @@ static void resetLua() {
 	engine->module<AcController>().unmock().isDisabledByLua = false;
 #if EFI_CAN_SUPPORT
 	resetLuaCanRx();
+	resetLuaCanRxBatch();
 #endif // EFI_CAN_SUPPORT
 
 	// De-init pins, they will reinit next start of the script.
@@ -515,7 +516,7 @@ int testLuaReturnsInteger(const char* script) {
 	return lua_tointeger(ls, -1);
 }
 
-void testLuaExecString(const char* script) {
+LuaHandle testLuaLoadScript(const char* script) {
 	auto ls = setupLuaState(myAlloc);
 
 	if (!ls) {
@@ -525,6 +526,12 @@ void testLuaExecString(const char* script) {
 	if (!loadScript(ls, script)) {
 		throw std::logic_error("Call to loadScript failed");
 	}
+
+	return ls;
+}
+
+void testLuaExecString(const char* script) {
+	testLuaLoadScript(script);
 }
 
 #endif // EFI_UNIT_TEST
@@ -2,7 +2,8 @@
 
 #include "can_filter.h"
 
-#if EFI_CAN_SUPPORT
+// delivery to Lua is built for unit tests too, queueing frames needs CAN hardware
+#if EFI_CAN_SUPPORT || EFI_UNIT_TEST
 
 #include "rusefi_lua.h"
 
@@ -12,54 +13,13 @@ extern "C" {
 	#include "lgc.h"
 }
 
-// Stores information about one received CAN frame: which bus, plus the actual frame
-struct CanFrameData {
-	uint8_t BusIndex;
-	int Callback;
-	CANRxFrame Frame;
-};
-
-static constexpr size_t canFrameCount = 32;
-static CanFrameData canFrames[canFrameCount];
-// CAN frame buffers that are not in use
-static chibios_rt::Mailbox<CanFrameData*, canFrameCount> freeBuffers;
-// CAN frame buffers that are waiting to be processed by the lua thread
-static chibios_rt::Mailbox<CanFrameData*, canFrameCount> filledBuffers;
-
-void processLuaCan(const size_t busIndex, const CANRxFrame& frame) {
-	auto filter = getFilterForId(busIndex, CAN_ID(frame));
+// How many received frames may wait for the lua thread at most, luaCanRxQueueDepth may lower that
+#ifndef LUA_CAN_RX_QUEUE_SIZE
+#define LUA_CAN_RX_QUEUE_SIZE 32
+#endif
 
-	// Filter the frame if we aren't listening for it
-	if (!filter) {
-		return;
-	}
-
-	CanFrameData* frameBuffer;
-	msg_t msg;
-
-	{
-		// Acquire a buffer under lock
-		chibios_rt::CriticalSectionLocker csl;
-		msg = freeBuffers.fetchI(&frameBuffer);
-	}
-
-	if (msg != MSG_OK) {
-		// all buffers are already in use, this frame will be dropped!
-		// TODO: warn the user
-		return;
-	}
-
-	// Copy the frame in to the buffer
-	frameBuffer->BusIndex = busIndex;
-	frameBuffer->Frame = frame;
-	frameBuffer->Callback = filter->Callback;
-
-	{
-		// Push the frame in to the queue under lock
-		chibios_rt::CriticalSectionLocker csl;
-		filledBuffers.postI(frameBuffer);
-	}
-}
+// buses 1 and 2, see validateCanChannelAndConvertFromHumanIntoZeroIndex
+#define LUA_CAN_RX_BUS_COUNT 2
 
 // From lapi.c:762 lua_createtable, modified slightly
 static void lua_createtable_noGC(lua_State *L, int narray) {
@@ -77,14 +37,23 @@ static void lua_createtable_noGC(lua_State *L, int narray) {
 	lua_unlock(L);
 }
 
-static void handleCanFrame(LuaHandle& ls, CanFrameData* data) {
+static void printCanRxCallError(lua_State* l, int status) {
+	if (0 != status) {
+		// error calling CAN rx hook function
+		auto errMsg = lua_tostring(l, -1);
+		efiPrintf("LUA CAN RX error %s", errMsg);
+		lua_pop(l, 1);
+	}
+}
+
+void handleLuaCanFrame(LuaHandle& ls, size_t busIndex, int callback, const CANRxFrame& frame) {
 	ScopePerf perf(PE::LuaOneCanRxCallback);
-	if (data->Callback == NO_CALLBACK) {
+	if (callback == NO_CALLBACK) {
 		// No callback, use catch-all function
 		lua_getglobal(ls, "onCanRx");
 	} else {
 		// Push the specified callback on to the stack
-		lua_rawgeti(ls, LUA_REGISTRYINDEX, data->Callback);
+		lua_rawgeti(ls, LUA_REGISTRYINDEX, callback);
 	}
 
 	if (lua_isnil(ls, -1)) {
@@ -94,11 +63,11 @@ static void handleCanFrame(LuaHandle& ls, CanFrameData* data) {
 		return;
 	}
 
-	auto dlc = data->Frame.DLC;
+	auto dlc = frame.DLC;
 
 	// Push bus, ID and DLC
-	lua_pushinteger(ls, HUMAN_OFFSET + data->BusIndex);
-	lua_pushinteger(ls, CAN_ID(data->Frame));
+	lua_pushinteger(ls, HUMAN_OFFSET + busIndex);
+	lua_pushinteger(ls, CAN_ID(frame));
 	lua_pushinteger(ls, dlc);
 
   if (engineConfiguration->luaCanRxWorkaround) {
@@ -109,25 +78,216 @@ static void handleCanFrame(LuaHandle& ls, CanFrameData* data) {
 	  lua_createtable_noGC(ls, dlc);
 	}
 	for (size_t i = 0; i < dlc; i++) {
-		lua_pushinteger(ls, data->Frame.data8[i]);
+		lua_pushinteger(ls, frame.data8[i]);
 
 		// index is i+1 because Lua "arrays" (tables) are 1-indexed
 		lua_rawseti(ls, -2, i + 1);
 	}
 
 	// Perform the actual function call
-	int status = lua_pcall(ls, 4, 0, 0);
+	printCanRxCallError(ls, lua_pcall(ls, 4, 0, 0));
 
-	if (0 != status) {
-		// error calling CAN rx hook function
-		auto errMsg = lua_tostring(ls, -1);
-		efiPrintf("LUA CAN RX error %s", errMsg);
+	lua_settop(ls, 0);
+}
+
+// Batch handler of each bus, plus the table of frame tables we hand to it.
+// Frame tables are created the first time a batch is that long, and are reused for every batch after that.
+static int batchCallbacks[LUA_CAN_RX_BUS_COUNT] = { NO_CALLBACK, NO_CALLBACK };
+static int batchFrameTables[LUA_CAN_RX_BUS_COUNT];
+
+bool setLuaCanRxBatchHandler(lua_State* l, size_t busIndex, int callback) {
+	efiAssert(ObdCode::OBD_PCM_Processor_Fault, busIndex < LUA_CAN_RX_BUS_COUNT, "lua can batch bus", false);
+
+	if (hasLuaCanRxFilterCallback(busIndex)) {
+		// those callbacks would never be called again
+		return false;
+	}
+
+	if (batchCallbacks[busIndex] == NO_CALLBACK) {
+		lua_createtable(l, LUA_CAN_RX_QUEUE_SIZE, 0);
+		batchFrameTables[busIndex] = luaL_ref(l, LUA_REGISTRYINDEX);
+	} else {
+		// replacing the handler, let go of the previous function
+		luaL_unref(l, LUA_REGISTRYINDEX, batchCallbacks[busIndex]);
+	}
+
+	batchCallbacks[busIndex] = callback;
+	return true;
+}
+
+bool hasLuaCanRxBatchHandler(size_t busIndex) {
+	return busIndex < LUA_CAN_RX_BUS_COUNT && batchCallbacks[busIndex] != NO_CALLBACK;
+}
+
+bool canUseLuaCanRxFilterCallback(int bus) {
+	if (bus == ANY_BUS) {
+		for (size_t i = 0; i < LUA_CAN_RX_BUS_COUNT; i++) {
+			if (hasLuaCanRxBatchHandler(i)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	return !hasLuaCanRxBatchHandler(bus);
+}
+
+void resetLuaCanRxBatch() {
+	// references belong to the Lua instance which is going away
+	for (size_t i = 0; i < LUA_CAN_RX_BUS_COUNT; i++) {
+		batchCallbacks[i] = NO_CALLBACK;
+	}
+}
+
+// Frame table on top of the stack gets id, dlc and data of this frame
+static void fillFrameTable(lua_State* l, const CANRxFrame& frame) {
+	lua_pushinteger(l, CAN_ID(frame));
+	lua_setfield(l, -2, "id");
+	lua_pushinteger(l, frame.DLC);
+	lua_setfield(l, -2, "dlc");
+
+	lua_getfield(l, -1, "data");
+	for (size_t i = 0; i < 8; i++) {
+		// clear what is left from a longer frame, so that #data is always dlc
+		if (i < frame.DLC) {
+			lua_pushinteger(l, frame.data8[i]);
+		} else {
+			lua_pushnil(l);
+		}
+		lua_rawseti(l, -2, i + 1);
+	}
+	lua_pop(l, 1);
+}
+
+void handleLuaCanFrameBatch(LuaHandle& ls, size_t busIndex, const CANRxFrame* const* frames, size_t count) {
+	if (count == 0 || !hasLuaCanRxBatchHandler(busIndex)) {
+		return;
+	}
+
+	ScopePerf perf(PE::LuaCanRxBatchCallback);
+
+	// handler(bus, frames, count)
+	lua_rawgeti(ls, LUA_REGISTRYINDEX, batchCallbacks[busIndex]);
+	lua_pushinteger(ls, HUMAN_OFFSET + busIndex);
+	lua_rawgeti(ls, LUA_REGISTRYINDEX, batchFrameTables[busIndex]);
+
+	for (size_t i = 0; i < count; i++) {
+		if (lua_rawgeti(ls, -1, i + 1) == LUA_TNIL) {
+			// first batch this long: grow the pool by one frame table
+			lua_pop(ls, 1);
+			lua_createtable(ls, 0, 3);
+			lua_createtable(ls, 8, 0);
+			lua_setfield(ls, -2, "data");
+			lua_pushvalue(ls, -1);
+			lua_rawseti(ls, -3, i + 1);
+		}
+
+		fillFrameTable(ls, *frames[i]);
 		lua_pop(ls, 1);
 	}
 
+	lua_pushinteger(ls, count);
+
+	printCanRxCallError(ls, lua_pcall(ls, 3, 0, 0));
+
 	lua_settop(ls, 0);
 }
 
+#if EFI_CAN_SUPPORT
+
+// Stores information about one received CAN frame: which bus, plus the actual frame
+struct CanFrameData {
+	uint8_t BusIndex;
+	int Callback;
+	CANRxFrame Frame;
+};
+
+static constexpr size_t canFrameCount = LUA_CAN_RX_QUEUE_SIZE;
+static CanFrameData canFrames[canFrameCount];
+// CAN frame buffers that are not in use
+static chibios_rt::Mailbox<CanFrameData*, canFrameCount> freeBuffers;
+// CAN frame buffers that are waiting to be processed by the lua thread
+static chibios_rt::Mailbox<CanFrameData*, canFrameCount> filledBuffers;
+
+// Frames accepted by a filter but lost because the queue was full
+static uint32_t droppedFrameCounter = 0;
+// How many times the queue filled up, each time one or more frames in a row were dropped
+static uint32_t overflowCounter = 0;
+static bool isOverflowing = false;
+// Frames currently waiting in filledBuffers, and the most we have ever seen waiting
+static size_t pendingFrameCount = 0;
+static size_t pendingFrameHighWaterMark = 0;
+
+static size_t getLuaCanRxQueueDepth() {
+	size_t depth = engineConfiguration->luaCanRxQueueDepth;
+	return (depth == 0 || depth > canFrameCount) ? canFrameCount : depth;
+}
+
+static void dropFrame() {
+	droppedFrameCounter++;
+	if (!isOverflowing) {
+		isOverflowing = true;
+		overflowCounter++;
+	}
+}
+
+void processLuaCan(const size_t busIndex, const CANRxFrame& frame) {
+	auto filter = getFilterForId(busIndex, CAN_ID(frame));
+
+	// Filter the frame if we aren't listening for it
+	if (!filter) {
+		return;
+	}
+
+	filter->HitCounter++;
+
+	CanFrameData* frameBuffer;
+	msg_t msg;
+
+	{
+		// Acquire a buffer under lock
+		chibios_rt::CriticalSectionLocker csl;
+		if (pendingFrameCount >= getLuaCanRxQueueDepth()) {
+			msg = MSG_TIMEOUT;
+		} else {
+			msg = freeBuffers.fetchI(&frameBuffer);
+		}
+	}
+
+	if (msg != MSG_OK) {
+		// queue is full or all buffers are already in use, this frame will be dropped!
+		dropFrame();
+		return;
+	}
+
+	// Copy the frame in to the buffer
+	frameBuffer->BusIndex = busIndex;
+	frameBuffer->Frame = frame;
+	frameBuffer->Callback = filter->Callback;
+
+	{
+		// Push the frame in to the queue under lock
+		chibios_rt::CriticalSectionLocker csl;
+		filledBuffers.postI(frameBuffer);
+
+		isOverflowing = false;
+		pendingFrameCount++;
+		if (pendingFrameCount > pendingFrameHighWaterMark) {
+			pendingFrameHighWaterMark = pendingFrameCount;
+		}
+	}
+}
+
+// Frames of buses with a batch handler, held until the end of doLuaCanRx
+static CanFrameData* batchBuffers[canFrameCount];
+static size_t batchBufferCount = 0;
+
+static void returnToFreeBuffers(CanFrameData* data) {
+	msg_t msg = freeBuffers.post(data, TIME_IMMEDIATE);
+	efiAssertVoid(ObdCode::OBD_PCM_Processor_Fault, msg == MSG_OK, "lua can post to free buffer fail");
+}
+
 static bool doOneLuaCanRx(LuaHandle& ls) {
 	ScopePerf perf(PE::LuaOneCanRxFunction);
 	CanFrameData* data;
@@ -145,12 +305,22 @@ static bool doOneLuaCanRx(LuaHandle& ls) {
 		return false;
 	}
 
+	{
+		chibios_rt::CriticalSectionLocker csl;
+		pendingFrameCount--;
+	}
+
+	if (hasLuaCanRxBatchHandler(data->BusIndex)) {
+		// keep it for the batch, this can't overflow since there are only canFrameCount buffers
+		batchBuffers[batchBufferCount++] = data;
+		return true;
+	}
+
 	// We've accepted the frame, process it in Lua.
-	handleCanFrame(ls, data);
+	handleLuaCanFrame(ls, data->BusIndex, data->Callback, data->Frame);
 
 	// We're done, return this frame to the free list
-	msg = freeBuffers.post(data, TIME_IMMEDIATE);
-	efiAssert(ObdCode::OBD_PCM_Processor_Fault, msg == MSG_OK, "lua can post to free buffer fail", false);
+	returnToFreeBuffers(data);
 
 	// We processed a frame so we should check again
 	return true;
@@ -163,14 +333,51 @@ int doLuaCanRx(LuaHandle& ls) {
 	while (doOneLuaCanRx(ls)) {
 	  counter++;
 	}
+
+	if (batchBufferCount > 0) {
+		// one call per bus with all of its frames
+		const CANRxFrame* frames[canFrameCount];
+		for (size_t bus = 0; bus < LUA_CAN_RX_BUS_COUNT; bus++) {
+			size_t count = 0;
+			for (size_t i = 0; i < batchBufferCount; i++) {
+				if (batchBuffers[i]->BusIndex == bus) {
+					frames[count++] = &batchBuffers[i]->Frame;
+				}
+			}
+
+			handleLuaCanFrameBatch(ls, bus, frames, count);
+		}
+
+		for (size_t i = 0; i < batchBufferCount; i++) {
+			returnToFreeBuffers(batchBuffers[i]);
+		}
+		batchBufferCount = 0;
+	}
+
+	engine->outputChannels.luaCanRxQueueHighWater = pendingFrameHighWaterMark;
+	// channels are 16 bit, stick at the top instead of wrapping, luacaninfo has the full count
+	engine->outputChannels.luaCanRxDropCounter = std::min<uint32_t>(droppedFrameCounter, UINT16_MAX);
+	engine->outputChannels.luaCanRxOverflowCounter = std::min<uint32_t>(overflowCounter, UINT16_MAX);
+
 	return counter;
 }
 
+static void printLuaCanRxInfo() {
+	efiPrintf("Lua CAN RX queue %d/%d, high water mark %d, dropped %d in %d overflows",
+		(int)pendingFrameCount, (int)getLuaCanRxQueueDepth(),
+		(int)pendingFrameHighWaterMark, (int)droppedFrameCounter, (int)overflowCounter);
+	printLuaCanRxFilters();
+}
+
 void initLuaCanRx() {
 	// Push all CAN frames in to the free buffer
 	for (size_t i = 0; i < canFrameCount; i++) {
 		freeBuffers.post(&canFrames[i], TIME_INFINITE);
 	}
+
+	addConsoleAction("luacaninfo", printLuaCanRxInfo);
 }
 
 #endif // EFI_CAN_SUPPORT
+
+#endif // EFI_CAN_SUPPORT || EFI_UNIT_TEST
@@ -577,6 +577,11 @@ int lua_canRxAdd(lua_State* l) {
 			return luaL_error(l, "Wrong number of arguments to canRxAdd. Got %d, expected 1, 2, or 3.", argumentCount);
 	}
 
+	if (callback != NO_CALLBACK && !canUseLuaCanRxFilterCallback(bus)) {
+		luaL_unref(l, LUA_REGISTRYINDEX, callback);
+		return luaL_error(l, "canRxAdd: callback would never be called, bus has a batch handler");
+	}
+
 	addLuaCanRxFilter(eid, FILTER_SPECIFIC, bus, callback);
 
 	return 0;
@@ -627,10 +632,33 @@ int lua_canRxAddMask(lua_State* l) {
 			return luaL_error(l, "Wrong number of arguments to canRxAddMask. Got %d, expected 2, 3, or 4.");
 	}
 
+	if (callback != NO_CALLBACK && !canUseLuaCanRxFilterCallback(bus)) {
+		luaL_unref(l, LUA_REGISTRYINDEX, callback);
+		return luaL_error(l, "canRxAddMask: callback would never be called, bus has a batch handler");
+	}
+
 	addLuaCanRxFilter(eid, mask, bus, callback);
 
 	return 0;
 }
+
+int lua_canRxSetBatchHandler(lua_State* l) {
+	if (lua_gettop(l) != 2) {
+		return luaL_error(l, "Wrong number of arguments to canRxSetBatchHandler. Got %d, expected 2.", lua_gettop(l));
+	}
+
+	// handle canRxSetBatchHandler(bus, callback)
+	int bus = validateCanChannelAndConvertFromHumanIntoZeroIndex(l);
+	lua_remove(l, 1);
+	int callback = getLuaFunc(l);
+
+	if (!setLuaCanRxBatchHandler(l, bus, callback)) {
+		luaL_unref(l, LUA_REGISTRYINDEX, callback);
+		return luaL_error(l, "canRxSetBatchHandler: bus %d has canRxAdd callbacks which would never be called", HUMAN_OFFSET + bus);
+	}
+
+	return 0;
+}
 #endif // EFI_CAN_SUPPORT
 
 PUBLIC_API_WEAK void boardConfigureLuaHooks(lua_State* lState) { }
@@ -996,6 +1024,7 @@ extern int luaCommandCounters[LUA_BUTTON_COUNT];
 		bool isGoodName = setConfigValueByName(propertyName, value);
 		if (isGoodName) {
 		    efiPrintf("LUA: applying [%s][%f]", propertyName, value);
+		    engine->tuneVersion++;
 		} else {
 		    efiPrintf("LUA: invalid calibration key [%s]", propertyName);
 		}
@@ -1070,6 +1099,7 @@ extern int luaCommandCounters[LUA_BUTTON_COUNT];
 #if EFI_CAN_SUPPORT
 	lua_register(lState, "canRxAdd", lua_canRxAdd);
 	lua_register(lState, "canRxAddMask", lua_canRxAddMask);
+	lua_register(lState, "canRxSetBatchHandler", lua_canRxSetBatchHandler);
 #endif // EFI_CAN_SUPPORT
 #endif // not EFI_UNIT_TEST
 
@@ -50,12 +50,32 @@ expected<float> testLuaReturnsNumberOrNil(const char* script);
 float testLuaReturnsNumber(const char* script);
 int testLuaReturnsInteger(const char* script);
 void testLuaExecString(const char* script);
+// Lua instance with this script loaded, for tests which call in to it directly
+LuaHandle testLuaLoadScript(const char* script);
 #endif
 
-#if EFI_CAN_SUPPORT
+#if EFI_CAN_SUPPORT || EFI_UNIT_TEST
 
 #include "can.h"
 
+// Lua CAN rx delivery: one call of onCanRx(bus, id, dlc, data) or of the filter callback per frame
+void handleLuaCanFrame(LuaHandle& ls, size_t busIndex, int callback, const CANRxFrame& frame);
+// Opt-in batch mode: all pending frames of a bus go to one handler(bus, frames, count) call per tick,
+// frames[i] being {id, dlc, data}. Frame tables are pooled, entries past count are stale.
+// onCanRx is not called for frames of that bus, and filters of that bus can't have their own callbacks:
+// returns false without touching the handler if some already do.
+bool setLuaCanRxBatchHandler(lua_State* l, size_t busIndex, int callback);
+bool hasLuaCanRxBatchHandler(size_t busIndex);
+// false if a filter callback on this bus would be shadowed by a batch handler
+bool canUseLuaCanRxFilterCallback(int bus);
+void handleLuaCanFrameBatch(LuaHandle& ls, size_t busIndex, const CANRxFrame* const* frames, size_t count);
+// Called when the user script is unloaded
+void resetLuaCanRxBatch();
+
+#endif // EFI_CAN_SUPPORT || EFI_UNIT_TEST
+
+#if EFI_CAN_SUPPORT
+
 // Lua CAN rx feature
 void initLuaCanRx();
 
@@ -107,4 +107,5 @@ temperature_t IFuelComputer::getTCharge(float rpm, float tps) {
 
 void initSpeedDensity() {
 	veMap.initTable(config->veTable, config->veRpmBins, config->veLoadBins);
+	veMap.setAxisLookupCache(&engine->axisLookupCache);
 }
@@ -19,9 +19,9 @@
  */
 class CanSensorBase : public StoredValueSensor, public CanListener {
 public:
-	CanSensorBase(uint32_t eid, SensorType type, efidur_t timeout)
+	CanSensorBase(uint32_t eid, SensorType type, efidur_t timeout, uint32_t mask = CAN_LISTENER_EXACT_MASK)
 		: StoredValueSensor(type, timeout)
-		, CanListener(eid)
+		, CanListener(eid, mask)
 	{
 	}
 
@@ -17,9 +17,10 @@ static constexpr uint32_t rusefi_base = WB_DATA_BASE_ADDR;
 
 AemXSeriesWideband::AemXSeriesWideband(uint8_t sensorIndex, SensorType type)
 	: CanSensorBase(
-		0,	// ID passed here doesn't matter since we override acceptFrame
+		0,	// any ID, acceptFrame picks the three IDs depending on flipWboChannels
 		type,
-		MS2NT(3 * WBO_TX_PERIOD_MS)	// sensor transmits at 100hz, allow a frame to be missed
+		MS2NT(3 * WBO_TX_PERIOD_MS),	// sensor transmits at 100hz, allow a frame to be missed
+		0
 	)
 	, m_sensorIndex(sensorIndex)
 {
@@ -624,6 +624,7 @@ static void setValue(const char *paramStr, const char *valueStr) {
     if (isGoodName) {
        efiPrintf("Settings: applying [%s][%f]", paramStr, valueF);
     }
+	engine->tuneVersion++;
 
 	engine->resetEngineSnifferIfInTestMode();
 }
@@ -1,9 +1,12 @@
 /**
  * @file event_queue.cpp
  * This is a data structure which keeps track of all pending events
- * Implemented as a linked list, which is fine since the number of
- * pending events is pretty low
- * todo: MAYBE migrate to a better data structure, but that's low priority
+ * Implemented as a binary min-heap of pointers so that both insert and cancel are
+ * O(log n) - queue depth grows with cylinder count, multi-spark and PWM channels
+ * and we do not want a linear walk in ISR context right when RPM peaks.
+ * Each scheduling_s remembers its own heap slot which is what makes cancel cheap.
+ * Heap has a fixed size, anything beyond that waits in a sorted linked list same as
+ * the whole queue used to, so the queue is never full.
  *
  * this data structure is NOT thread safe
  *
@@ -15,6 +18,9 @@
 
 #include "event_queue.h"
 #include "efitime.h"
+#include "event_timing_stats.h"
+
+#include <algorithm>
 
 #if EFI_UNIT_TEST
 extern bool verboseMode;
@@ -59,8 +65,71 @@ void EventQueue::tryReturnScheduling(scheduling_s* sched) {
 	}
 }
 
+bool EventQueue::isBefore(const scheduling_s* a, const scheduling_s* b) {
+	efitick_t momentA = a->getMomentNt();
+	efitick_t momentB = b->getMomentNt();
+	if (momentA != momentB) {
+		return momentA < momentB;
+	}
+	// same moment: first come first served, wrap-around safe
+	return (int32_t)(a->queueOrder - b->queueOrder) < 0;
+}
+
+void EventQueue::place(scheduling_s* scheduling, int index) {
+	m_heap[index] = scheduling;
+	scheduling->queueIndex = index;
+}
+
+void EventQueue::siftUp(int index) {
+	scheduling_s* scheduling = m_heap[index];
+	while (index > 0) {
+		int parent = (index - 1) / 2;
+		if (!isBefore(scheduling, m_heap[parent])) {
+			break;
+		}
+		place(m_heap[parent], index);
+		index = parent;
+	}
+	place(scheduling, index);
+}
+
+void EventQueue::siftDown(int index) {
+	scheduling_s* scheduling = m_heap[index];
+	while (true) {
+		int child = 2 * index + 1;
+		if (child >= m_size) {
+			break;
+		}
+		if (child + 1 < m_size && isBefore(m_heap[child + 1], m_heap[child])) {
+			child++;
+		}
+		if (!isBefore(m_heap[child], scheduling)) {
+			break;
+		}
+		place(m_heap[child], index);
+		index = child;
+	}
+	place(scheduling, index);
+}
+
+void EventQueue::removeAt(int index) {
+	m_size--;
+	if (index == m_size) {
+		// removing the last leaf, nothing to rebalance
+		return;
+	}
+
+	// move the last leaf into the hole and restore heap order in whichever direction is needed
+	place(m_heap[m_size], index);
+	if (index > 0 && isBefore(m_heap[index], m_heap[(index - 1) / 2])) {
+		siftUp(index);
+	} else {
+		siftDown(index);
+	}
+}
+
 /**
- * @return true if inserted into the head of the list
+ * @return true if inserted into the head of the queue
  */
 bool EventQueue::insertTask(scheduling_s *scheduling, efitick_t timeNt, action_s action) {
 	ScopePerf perf(PE::EventQueueInsertTask);
@@ -79,7 +148,6 @@ bool EventQueue::insertTask(scheduling_s *scheduling, efitick_t timeNt, action_s
 		}
 	}
 
-	assertListIsSorted();
 	efiAssert(ObdCode::CUSTOM_ERR_ASSERT, action.getCallback() != NULL, "NULL callback", false);
 
 // please note that simulator does not use this code at all - simulator uses signal_executor_sleep
@@ -96,71 +164,98 @@ bool EventQueue::insertTask(scheduling_s *scheduling, efitick_t timeNt, action_s
 
 	scheduling->setMomentNt(timeNt);
 	scheduling->action = action;
+	scheduling->queueOrder = m_insertCounter++;
 
-	if (!m_head || timeNt < m_head->getMomentNt()) {
-		// here we insert into head of the linked list
-		LL_PREPEND2(m_head, scheduling, nextScheduling_s);
-		assertListIsSorted();
-		return true;
+	if (m_size < (int)efi::size(m_heap)) {
+		pushHeap(scheduling);
 	} else {
-		// here we know we are not in the head of the list, let's find the position - linear search
-		scheduling_s *insertPosition = m_head;
-		while (insertPosition->nextScheduling_s != NULL && insertPosition->nextScheduling_s->getMomentNt() < timeNt) {
-			insertPosition = insertPosition->nextScheduling_s;
-		}
-
-		scheduling->nextScheduling_s = insertPosition->nextScheduling_s;
-		insertPosition->nextScheduling_s = scheduling;
-		assertListIsSorted();
-		return false;
+		insertSpill(scheduling);
 	}
+
+	return getHead() == scheduling;
 }
 
-void EventQueue::remove(scheduling_s* scheduling) {
-	assertListIsSorted();
+void EventQueue::pushHeap(scheduling_s* scheduling) {
+	place(scheduling, m_size);
+	m_size++;
+	siftUp(m_size - 1);
+}
 
-	// Special case: event isn't scheduled, so don't cancel it
-	if (!scheduling->action) {
-		return;
+/**
+ * O(spill size) - only used once the heap is full
+ */
+void EventQueue::insertSpill(scheduling_s* scheduling) {
+	scheduling->queueIndex = SPILL_INDEX;
+
+	scheduling_s** position = &m_spillHead;
+	while (*position && !isBefore(scheduling, *position)) {
+		position = &(*position)->nextScheduling_s;
+	}
+	scheduling->nextScheduling_s = *position;
+	*position = scheduling;
+	m_spillSize++;
+}
+
+void EventQueue::removeSpill(scheduling_s* scheduling) {
+	scheduling_s** position = &m_spillHead;
+	while (*position && *position != scheduling) {
+		position = &(*position)->nextScheduling_s;
 	}
 
-	// Special case: empty list, nothing to do
-	if (!m_head) {
+	// Walked off the end, this is an error since this *should* have been scheduled
+	if (!*position) {
+		firmwareError(ObdCode::OBD_PCM_Processor_Fault, "EventQueue::remove didn't find element");
 		return;
 	}
 
-	// Special case: is the item to remove at the head?
-	if (scheduling == m_head) {
-		m_head = m_head->nextScheduling_s;
+	*position = scheduling->nextScheduling_s;
+	scheduling->nextScheduling_s = nullptr;
+	m_spillSize--;
+}
+
+/**
+ * Heap has room again: earliest spilled event moves over
+ */
+void EventQueue::refillFromSpill() {
+	if (m_spillHead && m_size < (int)efi::size(m_heap)) {
+		scheduling_s* scheduling = m_spillHead;
+		m_spillHead = scheduling->nextScheduling_s;
 		scheduling->nextScheduling_s = nullptr;
-		scheduling->action = {};
-	} else {
-		auto prev = m_head;	// keep track of the element before the one to remove, so we can link around it
-		auto current = prev->nextScheduling_s;
+		m_spillSize--;
+		pushHeap(scheduling);
+	}
+}
 
-		// Find our element
-		while (current && current != scheduling) {
-			prev = current;
-			current = current->nextScheduling_s;
-		}
+void EventQueue::remove(scheduling_s* scheduling) {
+	// Special case: event isn't scheduled, so don't cancel it
+	if (!scheduling->action) {
+		return;
+	}
 
-		// Walked off the end, this is an error since this *should* have been scheduled
-		if (!current) {
-			firmwareError(ObdCode::OBD_PCM_Processor_Fault, "EventQueue::remove didn't find element");
-			return;
-		}
+	// Special case: empty queue, nothing to do
+	if (size() == 0) {
+		return;
+	}
 
-		efiAssertVoid(ObdCode::OBD_PCM_Processor_Fault, current == scheduling, "current not equal to scheduling");
+	int index = scheduling->queueIndex;
 
-		// Link around the removed item
-		prev->nextScheduling_s = current->nextScheduling_s;
+	if (index == SPILL_INDEX) {
+		removeSpill(scheduling);
+		scheduling->action = {};
+		return;
+	}
 
-		// Clean the item to remove
-		current->nextScheduling_s = nullptr;
-		current->action = {};
+	// Not our element, this is an error since this *should* have been scheduled
+	if (index >= m_size || m_heap[index] != scheduling) {
+		firmwareError(ObdCode::OBD_PCM_Processor_Fault, "EventQueue::remove didn't find element");
+		return;
 	}
 
-	assertListIsSorted();
+	removeAt(index);
+	refillFromSpill();
+
+	// Clean the item to remove
+	scheduling->action = {};
 }
 
 /**
@@ -170,8 +265,9 @@ void EventQueue::remove(scheduling_s* scheduling) {
  * @return Get the timestamp of the soonest pending action, skipping all the actions in the past
  */
 expected<efitick_t> EventQueue::getNextEventTime(efitick_t nowNt) const {
-	if (m_head) {
-		if (m_head->getMomentNt() <= nowNt) {
+	scheduling_s* head = getHead();
+	if (head) {
+		if (head->getMomentNt() <= nowNt) {
 			/**
 			 * We are here if action timestamp is in the past. We should rarely be here since this 'getNextEventTime()' is
 			 * always invoked by 'scheduleTimerCallback' which is always invoked right after 'executeAllPendingActions' - but still,
@@ -182,7 +278,7 @@ expected<efitick_t> EventQueue::getNextEventTime(efitick_t nowNt) const {
 			 */
 			return nowNt + m_lateDelay;
 		} else {
-			return m_head->getMomentNt();
+			return head->getMomentNt();
 		}
 	}
 
@@ -203,7 +299,7 @@ int EventQueue::executeAll(efitick_t now) {
 
 	int executionCounter = 0;
 
-	assertListIsSorted();
+	assertHeapIsValid();
 
 	bool didExecute;
 	do {
@@ -217,7 +313,7 @@ int EventQueue::executeAll(efitick_t now) {
 bool EventQueue::executeOne(efitick_t now) {
 	// Read the head every time - a previously executed event could
 	// have inserted something new at the head
-	scheduling_s* current = m_head;
+	scheduling_s* current = getHead();
 
 	// Queue is empty - bail
 	if (!current) {
@@ -255,14 +351,22 @@ extern bool unitTestBusyWaitHack;
 		UNIT_TEST_BUSY_WAIT_CALLBACK();
 	}
 
-	// step the head forward, unlink this element, clear scheduled flag
-	m_head = current->nextScheduling_s;
-	current->nextScheduling_s = nullptr;
+	// pop the head, clear scheduled flag
+	if (current->queueIndex == SPILL_INDEX) {
+		removeSpill(current);
+	} else {
+		removeAt(0);
+		refillFromSpill();
+	}
 
 	// Grab the action but clear it in the event so we can reschedule from the action's execution
 	auto action = current->action;
 	current->action = {};
 
+#if EFI_EVENT_TIMING_STATS
+	efitick_t momentNt = current->getMomentNt();
+#endif // EFI_EVENT_TIMING_STATS
+
 	tryReturnScheduling(current);
 	current = nullptr;
 
@@ -270,66 +374,103 @@ extern bool unitTestBusyWaitHack;
 	printf("QUEUE: execute current=%d param=%d\r\n", (uintptr_t)current, (uintptr_t)action.getArgument());
 #endif
 
+#if EFI_EVENT_TIMING_STATS
+	efitick_t startNt = getTimeNowNt();
+#endif // EFI_EVENT_TIMING_STATS
+
 	// Execute the current element
 	{
 		ScopePerf perf2(PE::EventQueueExecuteCallback);
 		action.execute();
 	}
 
-	assertListIsSorted();
+#if EFI_EVENT_TIMING_STATS
+	recordEventTiming(getEventClass(action.getCallback()), startNt - momentNt, getTimeNowNt() - startNt);
+#endif // EFI_EVENT_TIMING_STATS
+
 	return true;
 }
 
 int EventQueue::size() const {
-	scheduling_s *tmp;
-	int result;
-	LL_COUNT2(m_head, tmp, result, nextScheduling_s);
-	return result;
+	return m_size + m_spillSize;
 }
 
-void EventQueue::assertListIsSorted() const {
+/**
+ * O(size) so only invoked once per executeAll batch, not on every insert/remove
+ */
+void EventQueue::assertHeapIsValid() const {
 #if EFI_UNIT_TEST || EFI_SIMULATOR
-	int counter = 0;
-	scheduling_s *current = m_head;
-	while (current != NULL && current->nextScheduling_s != NULL) {
-		efiAssertVoid(ObdCode::CUSTOM_ERR_6623, current->getMomentNt() <= current->nextScheduling_s->getMomentNt(), "list order");
-		current = current->nextScheduling_s;
-		if (counter++ > 1'000'000'000)
-			criticalError("EventQueue: looks like a loop?!");
+	for (int i = 0; i < m_size; i++) {
+		efiAssertVoid(ObdCode::CUSTOM_ERR_6623, m_heap[i]->queueIndex == i, "heap index");
+		if (i > 0) {
+			efiAssertVoid(ObdCode::CUSTOM_ERR_6623, !isBefore(m_heap[i], m_heap[(i - 1) / 2]), "heap order");
+		}
+	}
+	for (scheduling_s* current = m_spillHead; current && current->nextScheduling_s; current = current->nextScheduling_s) {
+		efiAssertVoid(ObdCode::CUSTOM_ERR_6623, !isBefore(current->nextScheduling_s, current), "spill order");
 	}
 #endif // EFI_UNIT_TEST || EFI_SIMULATOR
 }
 
-scheduling_s * EventQueue::getHead() {
-	return m_head;
+scheduling_s * EventQueue::getHead() const {
+	if (m_size == 0) {
+		return m_spillHead;
+	}
+	if (m_spillHead && isBefore(m_spillHead, m_heap[0])) {
+		return m_spillHead;
+	}
+	return m_heap[0];
 }
 
 // todo: reduce code duplication with another 'getElementAtIndexForUnitText'
 scheduling_s *EventQueue::getElementAtIndexForUnitText(int index) {
-	scheduling_s * current;
+	if (index < 0 || index >= size()) {
+		return NULL;
+	}
 
-	LL_FOREACH2(m_head, current, nextScheduling_s)
-	{
-		if (index == 0)
+	// heap is not sorted, a sorted copy of it merged with the spill list is
+	scheduling_s* sorted[EVENT_QUEUE_HEAP_SIZE];
+	std::copy(m_heap, m_heap + m_size, sorted);
+	std::sort(sorted, sorted + m_size, isBefore);
+
+	int heapIndex = 0;
+	scheduling_s* spill = m_spillHead;
+	while (true) {
+		scheduling_s* current;
+		if (heapIndex < m_size && (!spill || isBefore(sorted[heapIndex], spill))) {
+			current = sorted[heapIndex++];
+		} else {
+			current = spill;
+			spill = spill->nextScheduling_s;
+		}
+
+		if (index == 0) {
 			return current;
+		}
 		index--;
 	}
-
-	return NULL;
 }
 
 void EventQueue::clear() {
 	// Flush the queue, resetting all scheduling_s as though we'd executed them
-	while(m_head) {
-		auto x = m_head;
-		// link next element to head
-		m_head = x->nextScheduling_s;
+	for (int i = 0; i < m_size; i++) {
+		auto x = m_heap[i];
 
 		// Reset this element
+		x->setMomentNt(0);
+		x->action = {};
+		m_heap[i] = nullptr;
+	}
+
+	while (m_spillHead) {
+		auto x = m_spillHead;
+		m_spillHead = x->nextScheduling_s;
+
 		x->setMomentNt(0);
 		x->nextScheduling_s = nullptr;
 		x->action = {};
 	}
 
-	m_head = nullptr;
+	m_size = 0;
+	m_spillSize = 0;
 }
@@ -13,8 +13,14 @@
 
 #define QUEUE_LENGTH_LIMIT 1000
 
+#ifndef EVENT_QUEUE_HEAP_SIZE
+// pool records plus all the statically owned scheduling_s (injection, ignition, PWM...)
+// more than that still works, just O(n) for the events beyond
+#define EVENT_QUEUE_HEAP_SIZE 256
+#endif
+
 /**
- * Execution sorted linked list
+ * Execution queue: binary min-heap of pending events ordered by momentNt
  */
 class EventQueue {
 public:
@@ -24,9 +30,12 @@ public:
 	explicit EventQueue(efidur_t lateDelay = 0);
 
 	/**
-	 * O(size) - linear search in sorted linked list
+	 * O(log(size)) - heap sift up
 	 */
 	bool insertTask(scheduling_s *scheduling, efitick_t timeX, action_s action);
+	/**
+	 * O(log(size)) - each scheduling_s knows its own slot in the heap
+	 */
 	void remove(scheduling_s* scheduling);
 
 	int executeAll(efitick_t now);
@@ -35,20 +44,43 @@ public:
 	expected<efitick_t> getNextEventTime(efitick_t nowUs) const;
 	void clear();
 	int size() const;
+	/**
+	 * O(size * log(size)), only meant for unit test assertions
+	 */
 	scheduling_s *getElementAtIndexForUnitText(int index);
-	scheduling_s * getHead();
+	scheduling_s * getHead() const;
 
 	scheduling_s* getFreeScheduling();
 	void tryReturnScheduling(scheduling_s* sched);
 private:
-	void assertListIsSorted() const;
+	void assertHeapIsValid() const;
+	// true if a is due before b
+	static bool isBefore(const scheduling_s* a, const scheduling_s* b);
+	void place(scheduling_s* scheduling, int index);
+	void siftUp(int index);
+	void siftDown(int index);
+	void removeAt(int index);
+	void pushHeap(scheduling_s* scheduling);
+	void insertSpill(scheduling_s* scheduling);
+	void removeSpill(scheduling_s* scheduling);
+	void refillFromSpill();
+
+	// queueIndex of events waiting in the spill list
+	static constexpr uint16_t SPILL_INDEX = 0xFFFF;
+
 	/**
-	 * this list is sorted
+	 * m_heap[0] is the soonest event
 	 */
-	scheduling_s *m_head = nullptr;
+	scheduling_s* m_heap[EVENT_QUEUE_HEAP_SIZE];
+	int m_size = 0;
+	/**
+	 * events which did not fit into the heap, sorted linked list
+	 */
+	scheduling_s* m_spillHead = nullptr;
+	int m_spillSize = 0;
+	uint32_t m_insertCounter = 0;
 	const efidur_t m_lateDelay;
 
 	scheduling_s* m_freelist = nullptr;
 	scheduling_s m_pool[64];
 };
-
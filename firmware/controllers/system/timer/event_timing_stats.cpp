@@ -0,0 +1,163 @@
+/**
+ * @file event_timing_stats.cpp
+ */
+
+#include "pch.h"
+
+#include "event_timing_stats.h"
+#include "injection_gpio.h"
+#include "pwm_generator_logic.h"
+#include "pwm_group.h"
+
+#if EFI_ENGINE_CONTROL
+#include "spark_logic.h"
+#include "fuel_schedule.h"
+#include "main_trigger_callback.h"
+#endif // EFI_ENGINE_CONTROL
+
+template <typename TArg>
+static schfunc_t asSchfunc(void (*callback)(TArg*)) {
+	// same conversion as action_s does
+	return (schfunc_t)callback;
+}
+
+EventClass getEventClass(schfunc_t callback) {
+#if EFI_ENGINE_CONTROL
+	if (callback == asSchfunc(&turnSparkPinHighStartCharging)
+			|| callback == asSchfunc(&fireSparkAndPrepareNextSchedule)
+			|| callback == asSchfunc(&overFireSparkAndPrepareNextSchedule)) {
+		return EventClass::Spark;
+	}
+
+	if (callback == bit_cast<schfunc_t>(&turnInjectionPinHigh)
+#if EFI_SHAFT_POSITION_INPUT
+			|| callback == asSchfunc(&turnInjectionPinLow)
+			|| callback == asSchfunc(&turnInjectionPinLowStage2)
+			|| callback == asSchfunc(&endSimultaneousInjection)
+#endif // EFI_SHAFT_POSITION_INPUT
+			|| callback == &startSimultaneousInjection) {
+		return EventClass::Injection;
+	}
+#endif // EFI_ENGINE_CONTROL
+
+	if (callback == asSchfunc(&pwmTimerCallback) || callback == asSchfunc(&pwmGroupCallback)) {
+		return EventClass::Pwm;
+	}
+
+	return EventClass::Generic;
+}
+
+const char* getEventClassName(EventClass eventClass) {
+	switch (eventClass) {
+	case EventClass::Spark:
+		return "spark";
+	case EventClass::Injection:
+		return "injection";
+	case EventClass::Pwm:
+		return "PWM";
+	case EventClass::Generic:
+		return "generic";
+	}
+	return "unknown";
+}
+
+size_t getEventTimingBucket(uint32_t us) {
+	if (us == 0) {
+		return 0;
+	}
+
+	// index of the highest set bit, plus one
+	size_t bucket = 32 - __builtin_clz(us);
+	return bucket < EVENT_TIMING_BUCKET_COUNT ? bucket : EVENT_TIMING_BUCKET_COUNT - 1;
+}
+
+#if EFI_EVENT_TIMING_STATS
+
+static event_class_timing_s timings[EVENT_CLASS_COUNT];
+
+void event_timing_histogram_s::add(uint32_t nt) {
+	buckets[getEventTimingBucket(nt / US_TO_NT_MULTIPLIER)]++;
+	if (nt > max) {
+		max = nt;
+	}
+}
+
+extern uint32_t maxEventCallbackDuration;
+extern uint32_t maxSchedulingPrecisionLoss;
+
+void recordEventTiming(EventClass eventClass, efidur_t latenessNt, efidur_t durationNt) {
+	uint32_t lateness = latenessNt > 0 ? (uint32_t)latenessNt : 0;
+	uint32_t duration = durationNt > 0 ? (uint32_t)durationNt : 0;
+
+	event_class_timing_s& timing = timings[(size_t)eventClass];
+	timing.count++;
+	timing.lateness.add(lateness);
+	timing.duration.add(duration);
+
+	if (duration > maxEventCallbackDuration) {
+		maxEventCallbackDuration = duration;
+	}
+	if (lateness > maxSchedulingPrecisionLoss) {
+		maxSchedulingPrecisionLoss = lateness;
+	}
+}
+
+void getEventTimingReport(event_timing_report_s& report, bool reset) {
+	report.classCount = EVENT_CLASS_COUNT;
+	report.bucketCount = EVENT_TIMING_BUCKET_COUNT;
+	report.ticksPerUs = US_TO_NT_MULTIPLIER;
+
+	// recorded from the timer ISR
+	chibios_rt::CriticalSectionLocker csl;
+	memcpy(report.classes, timings, sizeof(timings));
+	if (reset) {
+		memset(timings, 0, sizeof(timings));
+	}
+}
+
+void resetEventTiming() {
+	chibios_rt::CriticalSectionLocker csl;
+	memset(timings, 0, sizeof(timings));
+}
+
+static void printHistogram(const char* name, const event_timing_histogram_s& histogram) {
+	// highest non-empty bucket, no point in printing a tail of zeros
+	size_t last = 0;
+	for (size_t i = 0; i < EVENT_TIMING_BUCKET_COUNT; i++) {
+		if (histogram.buckets[i] != 0) {
+			last = i;
+		}
+	}
+
+	efiPrintf("  %s max %dus", name, (int)(histogram.max / US_TO_NT_MULTIPLIER));
+	for (size_t i = 0; i <= last; i++) {
+		if (i == EVENT_TIMING_BUCKET_COUNT - 1) {
+			efiPrintf("    >=%dus: %d", 1 << (i - 1), (int)histogram.buckets[i]);
+		} else {
+			efiPrintf("    <%dus: %d", 1 << i, (int)histogram.buckets[i]);
+		}
+	}
+}
+
+static void printEventTiming() {
+	event_timing_report_s report;
+	getEventTimingReport(report);
+
+	for (size_t i = 0; i < EVENT_CLASS_COUNT; i++) {
+		const event_class_timing_s& timing = report.classes[i];
+		efiPrintf("%s: %d events", getEventClassName((EventClass)i), (int)timing.count);
+		if (timing.count == 0) {
+			continue;
+		}
+
+		printHistogram("lateness", timing.lateness);
+		printHistogram("duration", timing.duration);
+	}
+}
+
+void initEventTimingStats() {
+	addConsoleAction("eventtiming", printEventTiming);
+	addConsoleAction("eventtimingreset", resetEventTiming);
+}
+
+#endif /* EFI_EVENT_TIMING_STATS */
@@ -0,0 +1,72 @@
+/**
+ * @file event_timing_stats.h
+ *
+ * How late scheduled events fire compared to their momentNt, and how long their callbacks take,
+ * as histograms per event class. Lighter than histogram_s: power of two microsecond buckets,
+ * fixed size, no lookup tables, cheap enough for the timer ISR.
+ *
+ * Read and reset with TS_EVENT_TIMING_COMMAND or the "eventtiming" console command.
+ */
+
+#pragma once
+
+#include "scheduler.h"
+
+enum class EventClass : uint8_t {
+	Spark,
+	Injection,
+	Pwm,
+	Generic,
+};
+
+#define EVENT_CLASS_COUNT 4
+
+// bucket 0 is under 1us, bucket i is [2^(i-1), 2^i) us, last one is everything above
+#define EVENT_TIMING_BUCKET_COUNT 16
+
+EventClass getEventClass(schfunc_t callback);
+const char* getEventClassName(EventClass eventClass);
+
+size_t getEventTimingBucket(uint32_t us);
+
+#if EFI_EVENT_TIMING_STATS
+
+struct event_timing_histogram_s {
+	uint32_t buckets[EVENT_TIMING_BUCKET_COUNT];
+	// in ticks, see US_TO_NT_MULTIPLIER
+	uint32_t max;
+
+	void add(uint32_t nt);
+};
+
+struct event_class_timing_s {
+	uint32_t count;
+	event_timing_histogram_s lateness;
+	event_timing_histogram_s duration;
+};
+
+/**
+ * TS_EVENT_TIMING_COMMAND response, little endian
+ */
+struct event_timing_report_s {
+	uint8_t classCount;
+	uint8_t bucketCount;
+	uint16_t ticksPerUs;
+	event_class_timing_s classes[EVENT_CLASS_COUNT];
+};
+
+/**
+ * Called by EventQueue right after the callback
+ * @param latenessNt how long after its moment the callback was entered, negative is clamped
+ */
+void recordEventTiming(EventClass eventClass, efidur_t latenessNt, efidur_t durationNt);
+
+/**
+ * Consistent snapshot, safe from any thread
+ * @param reset start over right after the snapshot, nothing is lost in between
+ */
+void getEventTimingReport(event_timing_report_s& report, bool reset = false);
+void resetEventTiming();
+void initEventTimingStats();
+
+#endif /* EFI_EVENT_TIMING_STATS */
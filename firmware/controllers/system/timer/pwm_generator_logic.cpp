@@ -10,6 +10,7 @@
 
 #include "pch.h"
 
+#include "pwm_group.h"
 
 #if EFI_PROD_CODE
 #include "mpu_util.h"
@@ -160,7 +161,8 @@ void PwmConfig::handleCycleStart() {
 		/**
 		 * period length has changed - we need to reset internal state
 		 */
-		safe.startNt = getTimeNowNt();
+		// grouped PWMs of the same frequency restart in step so that their edges share timer events
+		safe.startNt = m_group ? m_group->getCycleStartNt(this, periodNt) : getTimeNowNt();
 		safe.iteration = 0;
 		safe.periodNt = periodNt;
 
@@ -252,7 +254,7 @@ efitick_t PwmConfig::togglePwmState() {
  *
  * First invocation happens on application thread
  */
-static void timerCallback(PwmConfig *state) {
+void pwmTimerCallback(PwmConfig *state) {
 	ScopePerf perf(PE::PwmGeneratorCallback);
 
 	state->dbgNestingLevel++;
@@ -268,7 +270,7 @@ static void timerCallback(PwmConfig *state) {
 		return;
 	}
 
-	state->m_executor->schedule(state->m_name, &state->scheduling, switchTimeNt, { timerCallback, state });
+	state->m_executor->schedule(state->m_name, &state->scheduling, switchTimeNt, { pwmTimerCallback, state });
 	state->dbgNestingLevel--;
 }
 
@@ -308,8 +310,16 @@ void PwmConfig::weComplexInit(Scheduler *executor,
 	safe.periodNt = -1;
 	safe.iteration = -1;
 
+	if (m_group) {
+		if (m_group->add(this)) {
+			// the group's timer events drive us from now on
+			return;
+		}
+		m_group = nullptr;
+	}
+
 	// let's start the indefinite callback loop of PWM generation
-	timerCallback(this);
+	pwmTimerCallback(this);
 }
 
 void startSimplePwm(SimplePwm *state, const char *msg,
@@ -353,6 +363,13 @@ void startSimplePwm(SimplePwm *state, const char *msg,
 
 	state->outputPins[0] = output;
 
+#if EFI_PWM_GROUP
+	if (!state->m_group && executor == getScheduler()) {
+		// one timeline for all software PWMs on the main scheduler
+		state->m_group = &getSoftwarePwmGroup();
+	}
+#endif /* EFI_PWM_GROUP */
+
 	state->setFrequency(frequency);
 	state->setSimplePwmDutyCycle(dutyCycle);
 	state->weComplexInit(executor, &state->seq, nullptr, callback);
@@ -34,6 +34,7 @@ typedef struct {
 } pwm_config_safe_state_s;
 
 class PwmConfig;
+class PwmGroup;
 
 typedef void (pwm_cycle_callback)(PwmConfig *state);
 typedef void (pwm_gen_callback)(int stateIndex, PwmConfig* pwm);
@@ -83,6 +84,11 @@ public:
 	int dbgNestingLevel;
 
 	scheduling_s scheduling;
+	/**
+	 * set before start to share timer events with other PWMs, 'scheduling' is not used then
+	 * see pwm_group.h
+	 */
+	PwmGroup* m_group = nullptr;
 
 	pwm_config_safe_state_s safe;
 
@@ -127,6 +133,9 @@ public:
  */
 void applyPinState(int stateIndex, PwmConfig* state) /* pwm_gen_callback */;
 
+// main PWM loop, scheduled action of every software PWM
+void pwmTimerCallback(PwmConfig *state);
+
 #define PWM_MAX_DUTY 1
 
 /**
@@ -0,0 +1,245 @@
+/**
+ * @file pwm_group.cpp
+ */
+
+#include "pch.h"
+
+#include "pwm_group.h"
+
+// members toggled late may already have their next edge due, but a runaway one should not keep us here
+#define PWM_GROUP_MAX_PASSES 4
+
+// a running member restarts its cycle at least every 838 iterations, see handleCycleStart
+#define PWM_GROUP_STALE_CYCLES 1000
+
+// slot taken by add() which is not done with the member yet, the timer callback leaves it alone
+#define PWM_GROUP_PARKED_NT INT64_MAX
+
+PwmGroup::PwmGroup(const char* p_name)
+	: name(p_name)
+{
+	memset(m_members, 0, sizeof(m_members));
+	memset(m_nextSwitchNt, 0, sizeof(m_nextSwitchNt));
+}
+
+bool PwmGroup::add(PwmConfig* pwm) {
+	size_t index;
+
+	{
+		// the list is walked from the timer callback
+		chibios_rt::CriticalSectionLocker csl;
+
+		if (!m_executor) {
+			m_executor = pwm->m_executor;
+		}
+
+		if (m_executor != pwm->m_executor) {
+			// one timeline, one executor
+			return false;
+		}
+
+		index = m_memberCount;
+		for (size_t i = 0; i < m_memberCount; i++) {
+			if (m_members[i] == pwm) {
+				index = i;
+				break;
+			}
+		}
+
+		if (index == m_memberCount) {
+			// slot of a stopped member is up for grabs
+			for (size_t i = 0; i < m_memberCount; i++) {
+				if (m_nextSwitchNt[i] == 0) {
+					index = i;
+					break;
+				}
+			}
+		}
+
+		if (index == m_memberCount) {
+			if (m_memberCount == PWM_GROUP_MAX_MEMBERS) {
+				return false;
+			}
+			m_memberCount++;
+		}
+
+		m_members[index] = pwm;
+		m_nextSwitchNt[index] = PWM_GROUP_PARKED_NT;
+	}
+
+	// Pins and the executor are no business of the lock: nobody else touches a parked member
+	efitick_t firstSwitchNt = getCycleStartNt(pwm, pwm->periodNt);
+	if (firstSwitchNt <= getTimeNowNt()) {
+		firstSwitchNt = pwm->togglePwmState();
+		toggleCounter++;
+	}
+	// else a member of the same frequency is mid cycle: we start with its next cycle instead of
+	// right away with a stretched first pulse
+
+	setNextSwitchNt(index, firstSwitchNt);
+	scheduleNext();
+	return true;
+}
+
+void PwmGroup::reset() {
+	chibios_rt::CriticalSectionLocker csl;
+
+	memset(m_members, 0, sizeof(m_members));
+	memset(m_nextSwitchNt, 0, sizeof(m_nextSwitchNt));
+	m_memberCount = 0;
+	m_executor = nullptr;
+	// was pending on a scheduler we no longer know
+	m_scheduling.action = {};
+	m_scheduling.nextScheduling_s = nullptr;
+}
+
+void PwmGroup::setNextSwitchNt(size_t index, efitick_t nextSwitchNt) {
+	// 64 bit store is two on a Cortex-M, the timer callback must not see half of it
+	chibios_rt::CriticalSectionLocker csl;
+	// zero once the PWM is stopped, its slot goes idle
+	m_nextSwitchNt[index] = nextSwitchNt;
+}
+
+bool PwmGroup::toggle(size_t index) {
+	efitick_t nextSwitchNt = m_members[index]->togglePwmState();
+	toggleCounter++;
+
+	setNextSwitchNt(index, nextSwitchNt);
+	return nextSwitchNt != 0;
+}
+
+efitick_t PwmGroup::getEarliestSwitchNt() const {
+	chibios_rt::CriticalSectionLocker csl;
+
+	efitick_t nextNt = 0;
+	for (size_t i = 0; i < m_memberCount; i++) {
+		efitick_t memberNt = m_nextSwitchNt[i];
+		if (memberNt != 0 && memberNt != PWM_GROUP_PARKED_NT && (nextNt == 0 || memberNt < nextNt)) {
+			nextNt = memberNt;
+		}
+	}
+	return nextNt;
+}
+
+void PwmGroup::scheduleNext() {
+	// Called by add() without our lock: the timer callback may get in between, but it only ever
+	// moves edges later so what we schedule here is at worst early, then that event reschedules
+	efitick_t nextNt = getEarliestSwitchNt();
+
+	// add() could bring an edge earlier than the one we are waiting for
+	m_executor->cancel(&m_scheduling);
+
+	if (nextNt == 0) {
+		// every member has stopped, next add() gets us going again
+		return;
+	}
+
+	m_executor->schedule(name, &m_scheduling, nextNt, { pwmGroupCallback, this });
+}
+
+void PwmGroup::onTimerCallback() {
+	ScopePerf perf(PE::PwmGeneratorCallback);
+	callbackCounter++;
+
+	uint32_t batch = 0;
+	for (int pass = 0; pass < PWM_GROUP_MAX_PASSES; pass++) {
+		efitick_t dueNt = getTimeNowNt() + US2NT(PWM_GROUP_COALESCE_US);
+
+		bool hasToggled = false;
+		for (size_t i = 0; i < m_memberCount; i++) {
+			if (m_nextSwitchNt[i] != 0 && m_nextSwitchNt[i] <= dueNt) {
+				toggle(i);
+				hasToggled = true;
+				batch++;
+			}
+		}
+
+		if (!hasToggled) {
+			break;
+		}
+	}
+
+	if (batch > maxBatch) {
+		maxBatch = batch;
+	}
+
+	scheduleNext();
+}
+
+efitick_t PwmGroup::getCycleStartNt(const PwmConfig* pwm, float periodNt) const {
+	// peers restart their cycles from the timer callback
+	chibios_rt::CriticalSectionLocker csl;
+	efitick_t nowNt = getTimeNowNt();
+
+	for (size_t i = 0; i < m_memberCount; i++) {
+		const PwmConfig* peer = m_members[i];
+		if (peer == pwm || m_nextSwitchNt[i] == 0 || peer->safe.periodNt != periodNt) {
+			continue;
+		}
+
+		efidur_t elapsedNt = nowNt - peer->safe.startNt;
+		if (elapsedNt <= 0) {
+			// peer has just lined itself up with the next cycle start
+			return peer->safe.startNt;
+		}
+
+		if (elapsedNt > PWM_GROUP_STALE_CYCLES * periodNt) {
+			// paused peer, its grid means nothing
+			continue;
+		}
+
+		// next cycle start on the peer's grid rather than the previous one: starting in the past
+		// could put us behind schedule
+		uint32_t cycles = (uint32_t)(elapsedNt / periodNt);
+		// same math as getNextSwitchTimeNt so that we land on the peer's very edges
+		efitick_t previousNt = peer->safe.startNt + (uint32_t)(cycles * periodNt);
+		if (previousNt >= nowNt) {
+			// right now, or float rounding
+			return previousNt;
+		}
+		return peer->safe.startNt + (uint32_t)((cycles + 1) * periodNt);
+	}
+
+	return nowNt;
+}
+
+size_t PwmGroup::getMemberCount() const {
+	return m_memberCount;
+}
+
+const PwmConfig* PwmGroup::getMember(size_t index) const {
+	return m_members[index];
+}
+
+efitick_t PwmGroup::getNextSwitchNt(size_t index) const {
+	return m_nextSwitchNt[index];
+}
+
+void pwmGroupCallback(PwmGroup* group) {
+	group->onTimerCallback();
+}
+
+#if EFI_PWM_GROUP
+
+static PwmGroup softwarePwmGroup("software PWM");
+
+PwmGroup& getSoftwarePwmGroup() {
+	return softwarePwmGroup;
+}
+
+static void printPwmGroupInfo() {
+	const PwmGroup& group = softwarePwmGroup;
+	efiPrintf("%s: %d members, %d timer events, %d toggles, max %d toggles per event",
+		group.name, (int)group.getMemberCount(), (int)group.callbackCounter, (int)group.toggleCounter,
+		(int)group.maxBatch);
+
+	for (size_t i = 0; i < group.getMemberCount(); i++) {
+		efiPrintf("  %s %s", group.getMember(i)->m_name, group.getNextSwitchNt(i) == 0 ? "stopped" : "running");
+	}
+}
+
+void initPwmGroup() {
+	addConsoleAction("pwmgroupinfo", printPwmGroupInfo);
+}
+
+#endif /* EFI_PWM_GROUP */
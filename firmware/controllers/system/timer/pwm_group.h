@@ -0,0 +1,87 @@
+/**
+ * @file pwm_group.h
+ *
+ * Software PWM channels sharing one timeline: instead of every PwmConfig keeping its own
+ * scheduling_s in the queue, the group keeps one and on each timer event toggles every member
+ * which is due by then. Members with the same frequency restart their cycles on a common grid so
+ * that their rising edges land on the very same event.
+ *
+ * "pwmgroupinfo" shows how many toggles each timer event handles.
+ */
+
+#pragma once
+
+#include "pwm_generator_logic.h"
+
+#ifndef PWM_GROUP_MAX_MEMBERS
+#define PWM_GROUP_MAX_MEMBERS 24
+#endif
+
+// edges closer than this to the earliest due one are fired by the same event, a bit early
+#ifndef PWM_GROUP_COALESCE_US
+#define PWM_GROUP_COALESCE_US 2
+#endif
+
+class PwmGroup {
+public:
+	explicit PwmGroup(const char* name);
+
+	/**
+	 * Takes over scheduling of this PWM. It toggles right away same as pwmTimerCallback would,
+	 * unless a member of the same frequency is mid cycle: then it starts with the next cycle of
+	 * that one. Adding a member again just picks up its new timing.
+	 * @return false if the group is full or on another executor, PWM has to run on its own
+	 */
+	bool add(PwmConfig* pwm);
+
+	/**
+	 * Forgets all members and the pending timer event without touching the executor, for when
+	 * the executor itself is gone
+	 */
+	void reset();
+
+	// timer event of the whole group
+	void onTimerCallback();
+
+	/**
+	 * Cycle start for a member restarting its cycle: the next cycle start of another member
+	 * running at the same period, now if there is none
+	 */
+	efitick_t getCycleStartNt(const PwmConfig* pwm, float periodNt) const;
+
+	size_t getMemberCount() const;
+	const PwmConfig* getMember(size_t index) const;
+	// next edge of a member, zero once it has stopped
+	efitick_t getNextSwitchNt(size_t index) const;
+
+	uint32_t callbackCounter = 0;
+	uint32_t toggleCounter = 0;
+	// most members toggled by one event
+	uint32_t maxBatch = 0;
+
+	const char* const name;
+
+private:
+	// @return false once the member has stopped
+	bool toggle(size_t index);
+	void setNextSwitchNt(size_t index, efitick_t nextSwitchNt);
+	// zero if nothing is running
+	efitick_t getEarliestSwitchNt() const;
+	void scheduleNext();
+
+	PwmConfig* m_members[PWM_GROUP_MAX_MEMBERS];
+	efitick_t m_nextSwitchNt[PWM_GROUP_MAX_MEMBERS];
+	size_t m_memberCount = 0;
+
+	Scheduler* m_executor = nullptr;
+	scheduling_s m_scheduling;
+};
+
+// main loop of a PWM group, scheduled action standing in for every member's pwmTimerCallback
+void pwmGroupCallback(PwmGroup* group);
+
+#if EFI_PWM_GROUP
+// startSimplePwm puts everything driven by the main scheduler here
+PwmGroup& getSoftwarePwmGroup();
+void initPwmGroup();
+#endif /* EFI_PWM_GROUP */
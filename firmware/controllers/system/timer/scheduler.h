@@ -78,9 +78,14 @@ struct scheduling_s {
 	virtual_timer_t timer;
 #endif /* EFI_SIMULATOR */
 
-	// Scheduler implementation uses a sorted linked list of these scheduling records.
+	// EventQueue chains free pool records and events which did not fit into its heap
 	scheduling_s *nextScheduling_s = nullptr;
 
+	// EventQueue keeps pending records in a binary min-heap: this is our slot in that heap
+	uint16_t queueIndex = 0;
+	// insertion order, used to execute events scheduled for the same moment in FIFO order
+	uint32_t queueOrder = 0;
+
 	action_s action;
 	/**
 	 * timestamp represented as 64-bit value of ticks since MCU start
@@ -2,28 +2,61 @@
 
 #include "event_queue.h"
 
-bool TriggerScheduler::assertNotInList(AngleBasedEvent *head, AngleBasedEvent *element) {
-	/* this code is just to validate state, no functional load*/
-	decltype(head) current;
+int TriggerScheduler::getBucketIndex(angle_t angle) {
+	// buckets are fixed over the four stroke cycle so that engineCycle changes do not strand pending events
+	int index = (int)(angle * TRIGGER_SCHEDULER_BUCKET_COUNT / FOUR_STROKE_CYCLE_DURATION);
+	if (index < 0) {
+		return 0;
+	}
+	if (index >= TRIGGER_SCHEDULER_BUCKET_COUNT) {
+		return TRIGGER_SCHEDULER_BUCKET_COUNT - 1;
+	}
+	return index;
+}
+
+void TriggerScheduler::appendToBucket(AngleBasedEvent *event, int bucketIndex) {
+	ToothBucket& bucket = m_buckets[bucketIndex];
+
+	event->toothBucket = bucketIndex;
+	event->nextToothEvent = nullptr;
+	if (bucket.tail) {
+		bucket.tail->nextToothEvent = event;
+	} else {
+		bucket.head = event;
+	}
+	bucket.tail = event;
+}
+
+bool TriggerScheduler::unlinkFromBucket(AngleBasedEvent *event) {
+	ToothBucket& bucket = m_buckets[event->toothBucket];
+
+	AngleBasedEvent *prev = nullptr;
+	AngleBasedEvent *current = bucket.head;
 	int counter = 0;
-	LL_FOREACH2(head, current, nextToothEvent) {
+	while (current && current != event) {
 		if (++counter > QUEUE_LENGTH_LIMIT) {
 			firmwareError(ObdCode::CUSTOM_ERR_LOOPED_QUEUE, "Looped queue?");
 			return false;
 		}
+		prev = current;
+		current = current->nextToothEvent;
+	}
 
-		if (current == element) {
-			/**
-			 * for example, this might happen in case of sudden RPM change if event
-			 * was not scheduled by angle but was scheduled by time. In case of scheduling
-			 * by time with slow RPM the whole next fast revolution might be within the wait
-			 */
-			warning(ObdCode::CUSTOM_RE_ADDING_INTO_EXECUTION_QUEUE, "re-adding element into event_queue");
-			return true;
-		}
+	if (!current) {
+		// bucket is detached by scheduleBucket right now, it would take care of this event
+		return false;
 	}
 
-	return false;
+	if (prev) {
+		prev->nextToothEvent = event->nextToothEvent;
+	} else {
+		bucket.head = event->nextToothEvent;
+	}
+	if (bucket.tail == event) {
+		bucket.tail = prev;
+	}
+	event->nextToothEvent = nullptr;
+	return true;
 }
 
 void TriggerScheduler::schedule(const char *msg, AngleBasedEvent* event, angle_t angle, action_s action) {
@@ -72,52 +105,65 @@ void TriggerScheduler::schedule(const char *msg, AngleBasedEvent* event, action_
 	}
 
 	event->action = action;
+	int bucketIndex = getBucketIndex(event->getAngle());
 
 	{
 		chibios_rt::CriticalSectionLocker csl;
 
-		// TODO: This is O(n), consider some other way of detecting if in a list,
-		// and consider doubly linked or other list tricks.
+		if (event->toothBucket == AngleBasedEvent::NOT_QUEUED) {
+			appendToBucket(event, bucketIndex);
+#if EFI_UNIT_TEST
+			event->queueOrder = m_queueOrderCounter++;
+#endif // EFI_UNIT_TEST
+		} else {
+			/**
+			 * for example, this might happen in case of sudden RPM change if event
+			 * was not scheduled by angle but was scheduled by time. In case of scheduling
+			 * by time with slow RPM the whole next fast revolution might be within the wait
+			 */
+			warning(ObdCode::CUSTOM_RE_ADDING_INTO_EXECUTION_QUEUE, "re-adding element into event_queue");
 
-		if (!assertNotInList(m_angleBasedEventsHead, event)) {
-			// Use Append to retain some semblance of event ordering in case of
-			// time skew.  Thus on events are always followed by off events.
-			LL_APPEND2(m_angleBasedEventsHead, event, nextToothEvent);
+			// angle might have moved the event into another bucket
+			if (event->toothBucket != bucketIndex && unlinkFromBucket(event)) {
+				appendToBucket(event, bucketIndex);
+			}
 		}
 	}
 }
 
-void TriggerScheduler::scheduleEventsUntilNextTriggerTooth(float rpm,
-							   efitick_t edgeTimestamp, float currentPhase, float nextPhase) {
-
-	if (!isValidRpm(rpm)) {
-		 // this might happen for instance in case of a single trigger event after a pause
-		return;
-	}
-
+void TriggerScheduler::scheduleBucket(int bucketIndex, efitick_t edgeTimestamp, float currentPhase, float nextPhase) {
+	ToothBucket& bucket = m_buckets[bucketIndex];
 	AngleBasedEvent *current, *tmp, *keephead;
 	AngleBasedEvent *keeptail = nullptr;
 
 	{
 		chibios_rt::CriticalSectionLocker csl;
 
-		keephead = m_angleBasedEventsHead;
-		m_angleBasedEventsHead = nullptr;
+		keephead = bucket.head;
+		bucket.head = nullptr;
+		bucket.tail = nullptr;
 	}
 
 	LL_FOREACH_SAFE2(keephead, current, tmp, nextToothEvent)
 	{
-		if (current->shouldSchedule(currentPhase, nextPhase)) {
+#if EFI_UNIT_TEST
+		scannedEventsCounter++;
+#endif // EFI_UNIT_TEST
+
+		int actualBucket = getBucketIndex(current->getAngle());
+		if (actualBucket != bucketIndex) {
+			// angle was changed while we had this bucket detached, move it where it belongs
+			LL_DELETE2(keephead, current, nextToothEvent);
+
+			chibios_rt::CriticalSectionLocker csl;
+			appendToBucket(current, actualBucket);
+		} else if (current->shouldSchedule(currentPhase, nextPhase)) {
 			// time to fire a spark which was scheduled previously
 
-			// Yes this looks like O(n^2), but that's only over the entire engine
-			// cycle.  It's really O(mn + nn) where m = # of teeth and n = # events
-			// fired per cycle.  The number of teeth outweigh the number of events, at
-			// least for 60-2....  So odds are we're only firing an event or two per
-			// tooth, which means the outer loop is really only O(n).  And if we are
-			// firing many events per teeth, then it's likely the events before this
-			// one also fired and thus the call to LL_DELETE2 is closer to O(1).
+			// Buckets are short and we only visit the buckets within the tooth window,
+			// so the call to LL_DELETE2 is close to O(1).
 			LL_DELETE2(keephead, current, nextToothEvent);
+			current->toothBucket = AngleBasedEvent::NOT_QUEUED;
 
 			scheduling_s * sDown = &current->eventScheduling;
 
@@ -146,8 +192,42 @@ void TriggerScheduler::scheduleEventsUntilNextTriggerTooth(float rpm,
 		chibios_rt::CriticalSectionLocker csl;
 
 		// Put any new entries onto the end of the keep list
-		keeptail->nextToothEvent = m_angleBasedEventsHead;
-		m_angleBasedEventsHead = keephead;
+		keeptail->nextToothEvent = bucket.head;
+		bucket.head = keephead;
+		if (!bucket.tail) {
+			bucket.tail = keeptail;
+		}
+	}
+}
+
+void TriggerScheduler::scheduleEventsUntilNextTriggerTooth(float rpm,
+							   efitick_t edgeTimestamp, float currentPhase, float nextPhase) {
+
+	if (!isValidRpm(rpm)) {
+		 // this might happen for instance in case of a single trigger event after a pause
+		return;
+	}
+
+	int firstBucket = getBucketIndex(currentPhase);
+	int lastBucket = getBucketIndex(nextPhase);
+
+	if (nextPhase > currentPhase) {
+		for (int i = firstBucket; i <= lastBucket; i++) {
+			scheduleBucket(i, edgeTimestamp, currentPhase, nextPhase);
+		}
+	} else if (lastBucket >= firstBucket) {
+		// wrapping window covers the whole cycle
+		for (int i = 0; i < TRIGGER_SCHEDULER_BUCKET_COUNT; i++) {
+			scheduleBucket(i, edgeTimestamp, currentPhase, nextPhase);
+		}
+	} else {
+		// we're near the end of the cycle: from current tooth to the end, then from the start to next tooth
+		for (int i = firstBucket; i < TRIGGER_SCHEDULER_BUCKET_COUNT; i++) {
+			scheduleBucket(i, edgeTimestamp, currentPhase, nextPhase);
+		}
+		for (int i = 0; i <= lastBucket; i++) {
+			scheduleBucket(i, edgeTimestamp, currentPhase, nextPhase);
+		}
 	}
 }
 
@@ -165,15 +245,29 @@ float AngleBasedEvent::getAngleFromNow(float currentPhase) const {
 }
 
 #if EFI_UNIT_TEST
-// todo: reduce code duplication with another 'getElementAtIndexForUnitText'
+/**
+ * @return pending event number 'index' in order of scheduling, regardless of bucket
+ */
 AngleBasedEvent * TriggerScheduler::getElementAtIndexForUnitTest(int index) {
-	AngleBasedEvent * current;
-
-	LL_FOREACH2(m_angleBasedEventsHead, current, nextToothEvent)
-	{
-		if (index == 0)
-			return current;
-		index--;
+	for (auto& bucket : m_buckets) {
+		AngleBasedEvent * current;
+		LL_FOREACH2(bucket.head, current, nextToothEvent)
+		{
+			int rank = 0;
+			for (auto& other : m_buckets) {
+				AngleBasedEvent * o;
+				LL_FOREACH2(other.head, o, nextToothEvent)
+				{
+					if ((int32_t)(o->queueOrder - current->queueOrder) < 0) {
+						rank++;
+					}
+				}
+			}
+
+			if (rank == index) {
+				return current;
+			}
+		}
 	}
 	criticalError("getElementAtIndexForUnitText: null");
 	return nullptr;
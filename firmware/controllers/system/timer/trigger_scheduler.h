@@ -1,5 +1,10 @@
 #pragma once
 
+#ifndef TRIGGER_SCHEDULER_BUCKET_COUNT
+// 22.5 degree buckets over a 720 degree cycle
+#define TRIGGER_SCHEDULER_BUCKET_COUNT 32
+#endif
+
 // TriggerScheduler here is an intermediate tooth-based scheduler working on top of time-base scheduler
 // *kludge*: individual event for *Trigger*Scheduler is called *Angle*BasedEvent. Shall we rename to ToothSchedule and ToothBasedEvent?
 class TriggerScheduler : public EngineModule {
@@ -22,18 +27,34 @@ public:
 
 #if EFI_UNIT_TEST
 	AngleBasedEvent * getElementAtIndexForUnitTest(int index);
+	// total number of pending events visited by scheduleEventsUntilNextTriggerTooth
+	uint32_t scannedEventsCounter = 0;
 #endif // EFI_UNIT_TEST
 
 private:
 	void schedule(const char *msg, AngleBasedEvent* event, action_s action);
 
-	bool assertNotInList(AngleBasedEvent *head, AngleBasedEvent *element);
+	static int getBucketIndex(angle_t angle);
+	// these two have to be invoked under lock
+	void appendToBucket(AngleBasedEvent *event, int bucketIndex);
+	bool unlinkFromBucket(AngleBasedEvent *event);
+
+	void scheduleBucket(int bucketIndex, efitick_t edgeTimestamp, float currentPhase, float nextPhase);
 
 	/**
-	 * That's the linked list of pending events scheduled in relation to trigger
-	 * At the moment we iterate over the whole list while looking for events for specific
-	 * trigger index We can make it an array of lists per trigger index, but that would take
-	 * some RAM and probably not needed yet.
+	 * Pending events scheduled in relation to trigger, bucketed by engine phase so that each
+	 * tooth only has to look at the events in the angle window up to the next tooth
+	 * instead of iterating over everything which is pending.
+	 * Each bucket is a linked list in order of scheduling, so that on events are always
+	 * followed by off events.
 	 */
-	AngleBasedEvent *m_angleBasedEventsHead = nullptr;
+	struct ToothBucket {
+		AngleBasedEvent *head = nullptr;
+		AngleBasedEvent *tail = nullptr;
+	};
+	ToothBucket m_buckets[TRIGGER_SCHEDULER_BUCKET_COUNT];
+
+#if EFI_UNIT_TEST
+	uint32_t m_queueOrderCounter = 0;
+#endif // EFI_UNIT_TEST
 };
@@ -34,6 +34,9 @@
 
 #define WIFI_THREAD_PRIORITY (NORMALPRIO)
 
+// SD log snapshots are short and must stay on time, slow SD writes happen later at PRIO_MMC
+#define PRIO_MLG_CAPTURE (NORMALPRIO)
+
 // Less important things
 #define PRIO_MMC (NORMALPRIO - 1)
 
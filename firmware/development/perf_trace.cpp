@@ -8,6 +8,8 @@
 
 #include "pch.h"
 
+#include "buffered_writer.h"
+
 #ifndef ENABLE_PERF_TRACE
 #error ENABLE_PERF_TRACE must be defined!
 #endif
@@ -34,32 +36,128 @@ static_assert(sizeof(TraceEntry) == 8);
 
 #define TRACE_BUFFER_LENGTH (BIG_BUFFER_SIZE / sizeof(TraceEntry))
 
+// free running stream indices wrap around at 2^32, buffer length has to divide that
+static_assert((TRACE_BUFFER_LENGTH & (TRACE_BUFFER_LENGTH - 1)) == 0);
+
 // This buffer stores a trace - we write the full buffer once, then disable tracing
 static BigBufferHandle s_traceBuffer;
 static size_t s_nextIdx = 0;
 
 static bool s_isTracing = false;
 
+// Streaming mode ring. Head is where the next record goes, tail is the oldest one not yet read.
+// Both only ever grow, slot is index % TRACE_BUFFER_LENGTH. A slot is finished once its Event
+// is no longer PE::INVALID, the reader puts INVALID back before handing the slot over.
+static BigBufferHandle s_streamBuffer;
+static uint32_t s_streamHead = 0;
+static uint32_t s_streamTail = 0;
+static bool s_isStreaming = false;
+static PerfTraceStreamOwner s_streamOwner = nullptr;
+// last time the owner came for records, see perfTraceStreamStopIfIdle
+static efitick_t s_streamLastReadNt = 0;
+// producers between their s_isStreaming check and the last store in to their slot
+static uint32_t s_streamWriters = 0;
+
+static PerfTraceStreamStats s_streamStats;
+
 static void stopTrace() {
 	s_isTracing = false;
 	s_nextIdx = 0;
 }
 
-static void perfEventImpl(PE event, EPhase phase) {
+static uint32_t getPerfTraceTimestamp() {
 #if EFI_PROD_CODE
+	// todo: why doesn't getTimeNowLowerNt() work here?
+	// It returns 0 like we're in a unit test
+	return port_rt_get_counter_value();
+#else
+	return getTimeNowLowerNt();
+#endif
+}
+
+static volatile TraceEntry* reserveStreamEntry() {
+	uint32_t head = __atomic_load_n(&s_streamHead, __ATOMIC_RELAXED);
+	uint32_t pending;
+
+	// No lock and no interrupt masking here: an ISR which preempts us in between simply takes
+	// the next slot, we retry with the head it left behind.
+	do {
+		pending = head - __atomic_load_n(&s_streamTail, __ATOMIC_ACQUIRE);
+		if (pending >= TRACE_BUFFER_LENGTH) {
+			// reader is behind, losing this record beats stalling whoever is being traced
+			__atomic_fetch_add(&s_streamStats.dropped, 1, __ATOMIC_RELAXED);
+			return nullptr;
+		}
+	} while (!__atomic_compare_exchange_n(&s_streamHead, &head, head + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	__atomic_fetch_add(&s_streamStats.recorded, 1, __ATOMIC_RELAXED);
+	// racy, a lost update only makes the figure a bit low
+	if (pending + 1 > s_streamStats.highWaterMark) {
+		s_streamStats.highWaterMark = pending + 1;
+	}
+
+	return &s_streamBuffer.get<TraceEntry>()[head % TRACE_BUFFER_LENGTH];
+}
+
+static void fillEntry(volatile TraceEntry& entry, EPhase phase, uint32_t timestamp) {
+	entry.Phase = phase;
+	entry.Timestamp = timestamp;
+
+#if EFI_PROD_CODE
+	// Get the current active interrupt - this is the "process ID"
+	auto isr = static_cast<int8_t>(SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk);
+	entry.IsrId = isr - 16;
+
+	// Get the current thread (if not interrupt) and use as the thread ID
+	if (isr == 0) {
+		entry.ThreadId = chThdGetSelfX()->threadId;
+	} else {
+		// Interrupts have no thread - all are T0
+		entry.ThreadId = 0;
+	}
+#else
+	// same as thread context on real hardware
+	entry.IsrId = -16;
+	entry.ThreadId = 0;
+#endif // EFI_PROD_CODE
+}
+
+static void streamEvent(PE event, EPhase phase) {
+	__atomic_fetch_add(&s_streamWriters, 1, __ATOMIC_SEQ_CST);
+
+	// check again now that perfTraceStreamStop would wait for us
+	if (__atomic_load_n(&s_isStreaming, __ATOMIC_SEQ_CST)) {
+		uint32_t timestamp = getPerfTraceTimestamp();
+
+		volatile TraceEntry* entry = reserveStreamEntry();
+		if (entry) {
+			fillEntry(*entry, phase, timestamp);
+			// Event goes last, that is what tells the reader the record is complete
+			__atomic_store_n(reinterpret_cast<volatile uint8_t*>(&entry->Event), static_cast<uint8_t>(event), __ATOMIC_RELEASE);
+		}
+	}
+
+	__atomic_fetch_sub(&s_streamWriters, 1, __ATOMIC_SEQ_CST);
+}
+
+static void perfEventImpl(PE event, EPhase phase) {
 	// Bail if we aren't allowed to trace
 	if constexpr (!ENABLE_PERF_TRACE) {
 		return;
 	}
 
+	if (__atomic_load_n(&s_isStreaming, __ATOMIC_RELAXED)) {
+		streamEvent(event, phase);
+		return;
+	}
+
+#if EFI_PROD_CODE
 	// Bail if we aren't tracing
 	if (!s_isTracing || !s_traceBuffer) {
 		return;
 	}
 
-	// todo: why doesn't getTimeNowLowerNt() work here?
-	// It returns 0 like we're in a unit test
-	uint32_t timestamp = port_rt_get_counter_value();
+	uint32_t timestamp = getPerfTraceTimestamp();
 
 	size_t idx;
 
@@ -87,20 +185,7 @@ static void perfEventImpl(PE event, EPhase phase) {
 	volatile TraceEntry& entry = s_traceBuffer.get<TraceEntry>()[idx];
 
 	entry.Event = event;
-	entry.Phase = phase;
-	// Get the current active interrupt - this is the "process ID"
-	auto isr = static_cast<int8_t>(SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk);
-	entry.IsrId = isr - 16;
-
-	// Get the current thread (if not interrupt) and use as the thread ID
-	if (isr == 0) {
-		entry.ThreadId = chThdGetSelfX()->threadId;
-	} else {
-		// Interrupts have no thread - all are T0
-		entry.ThreadId = 0;
-	}
-
-	entry.Timestamp = timestamp;
+	fillEntry(entry, phase, timestamp);
 #endif // EFI_PROD_CODE
 }
 
@@ -116,7 +201,7 @@ void perfEventInstantGlobal(PE event) {
 	perfEventImpl(event, EPhase::InstantGlobal);
 }
 
-void perfTraceEnable() {
+static void releaseBufferFromToothLogger() {
 #if EFI_TOOTH_LOGGER
 	// force release of the buffer if occupied by the tooth logger
 	if (IsToothLoggerEnabled()) {
@@ -125,8 +210,18 @@ void perfTraceEnable() {
 		DisableToothLogger();
 	}
 #endif // EFI_TOOTH_LOGGER
+}
+
+bool perfTraceEnable() {
+	// one mode at a time, they share the buffer
+	if (s_streamOwner) {
+		return false;
+	}
+
+	releaseBufferFromToothLogger();
 	s_traceBuffer = getBigBuffer(BigBufferUser::PerfTrace);
 	s_isTracing = true;
+	return true;
 }
 
 const BigBufferHandle perfTraceGetBuffer() {
@@ -136,3 +231,251 @@ const BigBufferHandle perfTraceGetBuffer() {
 	// transfer ownership of the buffer to the caller
 	return efi::move(s_traceBuffer);
 }
+
+#if EFI_PROD_CODE
+// cycle counter
+#define PERF_TRACE_TICKS_PER_US (CORE_CLOCK / 1000000)
+#else
+#define PERF_TRACE_TICKS_PER_US US_TO_NT_MULTIPLIER
+#endif
+
+static const char* const perfEventNames[] = {
+#define PE_NAME(name) #name,
+	PERF_TRACE_EVENTS(PE_NAME)
+#undef PE_NAME
+};
+
+bool perfTraceStreamStart(PerfTraceStreamOwner owner) {
+	// restart drops whatever the owner did not read yet
+	perfTraceStreamStop(owner);
+
+	{
+		// TS and SD card threads may both try
+		chibios_rt::CriticalSectionLocker csl;
+		if (s_streamOwner) {
+			return false;
+		}
+		s_streamOwner = owner;
+	}
+
+	stopTrace();
+	s_traceBuffer = {};
+	releaseBufferFromToothLogger();
+
+	s_streamBuffer = getBigBuffer(BigBufferUser::PerfTrace);
+	if (!s_streamBuffer) {
+		s_streamOwner = nullptr;
+		return false;
+	}
+
+	// all slots PE::INVALID
+	memset(s_streamBuffer.get<uint8_t>(), 0, s_streamBuffer.size());
+	s_streamHead = 0;
+	s_streamTail = 0;
+	s_streamStats = {};
+	s_streamLastReadNt = getTimeNowNt();
+
+	__atomic_store_n(&s_isStreaming, true, __ATOMIC_SEQ_CST);
+	return true;
+}
+
+void perfTraceStreamStop(PerfTraceStreamOwner owner) {
+	if (!perfTraceStreamIsOwner(owner)) {
+		return;
+	}
+
+	{
+		// no producer gets past its second s_isStreaming check after this
+		chibios_rt::CriticalSectionLocker csl;
+		__atomic_store_n(&s_isStreaming, false, __ATOMIC_SEQ_CST);
+	}
+
+#if ! EFI_UNIT_TEST
+	// An ISR which interrupted us is long done by now, but a lower priority thread we preempted
+	// while it was filling its slot has to get a chance to finish before the ring goes away
+	while (__atomic_load_n(&s_streamWriters, __ATOMIC_SEQ_CST) != 0) {
+		chThdSleepMilliseconds(1);
+	}
+#endif // EFI_UNIT_TEST
+
+	// whatever was not read yet is gone
+	s_streamBuffer = {};
+	s_streamOwner = nullptr;
+}
+
+void perfTraceStreamStopIfIdle(PerfTraceStreamOwner owner) {
+	if (perfTraceStreamIsOwner(owner) && getTimeNowNt() - s_streamLastReadNt > MS2NT(PERF_TRACE_STREAM_IDLE_TIMEOUT_MS)) {
+		efiPrintf("perf trace stream not read for %dms, stopping", PERF_TRACE_STREAM_IDLE_TIMEOUT_MS);
+		perfTraceStreamStop(owner);
+	}
+}
+
+bool perfTraceIsStreaming() {
+	return s_isStreaming;
+}
+
+bool perfTraceStreamIsOwner(PerfTraceStreamOwner owner) {
+	return owner && s_streamOwner == owner;
+}
+
+static bool isEntryFinished(const TraceEntry& entry) {
+	return __atomic_load_n(reinterpret_cast<const uint8_t*>(&entry.Event), __ATOMIC_ACQUIRE) != static_cast<uint8_t>(PE::INVALID);
+}
+
+size_t perfTraceStreamPeek(PerfTraceStreamOwner owner, const uint8_t*& data) {
+	if (!s_streamBuffer || !perfTraceStreamIsOwner(owner)) {
+		return 0;
+	}
+
+	s_streamLastReadNt = getTimeNowNt();
+
+	// only the reader moves the tail
+	uint32_t tail = s_streamTail;
+	uint32_t pending = __atomic_load_n(&s_streamHead, __ATOMIC_ACQUIRE) - tail;
+
+	size_t start = tail % TRACE_BUFFER_LENGTH;
+	// up to the end of the ring, the rest comes with the next call
+	size_t count = std::min<size_t>(pending, TRACE_BUFFER_LENGTH - start);
+
+	const TraceEntry* entries = s_streamBuffer.get<TraceEntry>() + start;
+
+	// stop at the first record someone is still in the middle of writing
+	size_t ready = 0;
+	while (ready < count && isEntryFinished(entries[ready])) {
+		ready++;
+	}
+
+	data = reinterpret_cast<const uint8_t*>(entries);
+	return ready * sizeof(TraceEntry);
+}
+
+void perfTraceStreamRelease(PerfTraceStreamOwner owner, size_t size) {
+	if (!s_streamBuffer || !perfTraceStreamIsOwner(owner)) {
+		return;
+	}
+
+	size_t count = size / sizeof(TraceEntry);
+	uint32_t tail = s_streamTail;
+	TraceEntry* entries = s_streamBuffer.get<TraceEntry>();
+
+	for (size_t i = 0; i < count; i++) {
+		__atomic_store_n(reinterpret_cast<uint8_t*>(&entries[(tail + i) % TRACE_BUFFER_LENGTH].Event), static_cast<uint8_t>(PE::INVALID), __ATOMIC_RELAXED);
+	}
+
+	// slots become free only after they are marked unfinished
+	__atomic_store_n(&s_streamTail, tail + count, __ATOMIC_RELEASE);
+}
+
+PerfTraceStreamStats perfTraceStreamGetStats() {
+	return s_streamStats;
+}
+
+/**
+ * see "JSON Array Format" in https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ * Same process names as JsonOutput.java, those are interrupt numbers.
+ */
+static const char* const jsonTraceHeader[] = {
+	"[{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":-16,\"tid\":0,\"args\":{\"name\":\"Main\"}}\n",
+	",{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":-1,\"tid\":0,\"args\":{\"name\":\"SysTick\"}}\n",
+	",{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":18,\"tid\":0,\"args\":{\"name\":\"ADC\"}}\n",
+	",{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":29,\"tid\":0,\"args\":{\"name\":\"TIM3\"}}\n",
+	",{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":30,\"tid\":0,\"args\":{\"name\":\"TIM4\"}}\n",
+	",{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":50,\"tid\":0,\"args\":{\"name\":\"TIM5\"}}\n",
+	",{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":67,\"tid\":0,\"args\":{\"name\":\"USB\"}}\n",
+};
+
+// raw timestamps are 32 bit cycle counts, those wrap every few seconds
+static uint32_t s_jsonLastTimestamp;
+static uint64_t s_jsonTicks;
+static bool s_jsonHasTimestamp;
+
+void perfTraceStreamWriteJsonHeader(Writer& writer) {
+	for (const char* line : jsonTraceHeader) {
+		writer.write(line, strlen(line));
+	}
+
+	s_jsonHasTimestamp = false;
+	s_jsonTicks = 0;
+}
+
+static size_t writeJsonEntry(Writer& writer, const TraceEntry& entry) {
+	if (!s_jsonHasTimestamp) {
+		s_jsonHasTimestamp = true;
+		s_jsonLastTimestamp = entry.Timestamp;
+	}
+
+	// records from an ISR can land a bit out of order, never step back
+	int32_t delta = static_cast<int32_t>(entry.Timestamp - s_jsonLastTimestamp);
+	if (delta > 0) {
+		s_jsonTicks += delta;
+		s_jsonLastTimestamp = entry.Timestamp;
+	}
+
+	uint32_t us = s_jsonTicks / PERF_TRACE_TICKS_PER_US;
+	uint32_t fraction = (s_jsonTicks % PERF_TRACE_TICKS_PER_US) * 1000 / PERF_TRACE_TICKS_PER_US;
+
+	char name[16];
+	const char* eventName;
+	if (entry.Event == PE::ISR) {
+		chsnprintf(name, sizeof(name), "ISR: %d", entry.ThreadId);
+		eventName = name;
+	} else if ((size_t)entry.Event < efi::size(perfEventNames)) {
+		eventName = perfEventNames[(size_t)entry.Event];
+	} else {
+		eventName = "unknown";
+	}
+
+	const char* phase;
+	switch (entry.Phase) {
+	case EPhase::Start:
+		phase = "B\"";
+		break;
+	case EPhase::End:
+		phase = "E\"";
+		break;
+	case EPhase::InstantThread:
+		phase = "i\",\"s\":\"t\"";
+		break;
+	default:
+		phase = "i\",\"s\":\"g\"";
+		break;
+	}
+
+	char line[128];
+	size_t length = chsnprintf(line, sizeof(line), ",{\"name\":\"%s\",\"ph\":\"%s,\"tid\":%d,\"pid\":%d,\"ts\":%d.%03d}\n",
+		eventName, phase, entry.ThreadId, entry.IsrId, (int)us, (int)fraction);
+	writer.write(line, length);
+	return length;
+}
+
+size_t perfTraceStreamWriteJson(PerfTraceStreamOwner owner, Writer& writer) {
+	size_t written = 0;
+	// at most one ring worth per call so that a busy trace can't keep us here forever
+	size_t budget = TRACE_BUFFER_LENGTH;
+
+	const uint8_t* data;
+	size_t size;
+	while (budget > 0 && (size = perfTraceStreamPeek(owner, data)) != 0) {
+		size_t count = std::min(size / sizeof(TraceEntry), budget);
+		const TraceEntry* entries = reinterpret_cast<const TraceEntry*>(data);
+		for (size_t i = 0; i < count; i++) {
+			written += writeJsonEntry(writer, entries[i]);
+		}
+
+		perfTraceStreamRelease(owner, count * sizeof(TraceEntry));
+		budget -= count;
+	}
+
+	return written;
+}
+
+static void printPerfTraceInfo() {
+	PerfTraceStreamStats stats = perfTraceStreamGetStats();
+	efiPrintf("perf trace streaming %s, %d recorded, %d dropped, %d/%d most pending",
+		boolToString(perfTraceIsStreaming()),
+		(int)stats.recorded, (int)stats.dropped, (int)stats.highWaterMark, (int)TRACE_BUFFER_LENGTH);
+}
+
+void initPerfTrace() {
+	addConsoleAction("perftraceinfo", printPerfTraceInfo);
+}
@@ -15,80 +15,135 @@
 // instant.  Instants can be global, or specific to one thread.  You probably don't want to use
 // each element in PE more than once, as they should each indicate that a specific thing began,
 // ended, or occurred.
+// The same list gives PE values and their names in the JSON trace.
+// The tag below is consumed by PerfTraceEnumGenerator.java which generates EnumNames.java
+// enum_start_tag
+#define PERF_TRACE_EVENTS(PE_EVENT) \
+	PE_EVENT(INVALID) \
+	PE_EVENT(ISR) \
+	PE_EVENT(ContextSwitch) \
+	PE_EVENT(OutputPinSetValue) \
+	PE_EVENT(DecodeTriggerEvent) \
+	PE_EVENT(EnginePeriodicFastCallback) \
+	PE_EVENT(EnginePeriodicSlowCallback) \
+	PE_EVENT(EngineStatePeriodicFastCallback) \
+	PE_EVENT(HandleShaftSignal) \
+	PE_EVENT(EventQueueInsertTask) \
+	PE_EVENT(EventQueueExecuteAll) \
+	PE_EVENT(SingleTimerExecutorDoExecute) \
+	PE_EVENT(SingleTimerExecutorScheduleTimerCallback) \
+	PE_EVENT(PeriodicControllerPeriodicTask) \
+	PE_EVENT(PeriodicTimerControllerPeriodicTask) \
+	PE_EVENT(AdcCallbackFast) \
+	PE_EVENT(AdcProcessSlow) \
+	PE_EVENT(AdcConversionSlow) \
+	PE_EVENT(AdcConversionFast) \
+	PE_EVENT(AdcSubscriptionUpdateSubscribers) \
+	PE_EVENT(GetRunningFuel) \
+	PE_EVENT(GetInjectionDuration) \
+	PE_EVENT(HandleFuel) \
+	PE_EVENT(MainTriggerCallback) \
+	PE_EVENT(OnTriggerEventSparkLogic) \
+	PE_EVENT(ShaftPositionListeners) \
+	PE_EVENT(GetBaseFuel) \
+	PE_EVENT(GetTpsEnrichment) \
+	PE_EVENT(GetSpeedDensityFuel) \
+	PE_EVENT(WallFuelAdjust) \
+	PE_EVENT(MapAveragingTriggerCallback) \
+	PE_EVENT(Unused1) \
+	PE_EVENT(SingleTimerExecutorScheduleByTimestamp) \
+	PE_EVENT(GetTimeNowUs) \
+	PE_EVENT(EventQueueExecuteCallback) \
+	PE_EVENT(PwmGeneratorCallback) \
+	PE_EVENT(TunerStudioHandleCrcCommand) \
+	PE_EVENT(Unused) \
+	PE_EVENT(PwmConfigStateChangeCallback) \
+	PE_EVENT(Temporary1) \
+	PE_EVENT(Temporary2) \
+	PE_EVENT(Temporary3) \
+	PE_EVENT(Temporary4) \
+	PE_EVENT(EngineSniffer) \
+	PE_EVENT(PrepareIgnitionSchedule) \
+	PE_EVENT(Hip9011IntHoldCallback) \
+	PE_EVENT(GlobalLock) \
+	PE_EVENT(GlobalUnlock) \
+	PE_EVENT(SoftwareKnockProcess) \
+	PE_EVENT(KnockAnalyzer) \
+	PE_EVENT(LogTriggerTooth) \
+	PE_EVENT(LuaTickFunction) \
+	PE_EVENT(LuaOneCanRxFunction) \
+	PE_EVENT(LuaAllCanRxFunction) \
+	PE_EVENT(LuaOneCanRxCallback) \
+	PE_EVENT(LuaOneCanTxFunction) \
+	PE_EVENT(LuaCanRxBatchCallback)
+// enum_end_tag
+// The tag above is consumed by PerfTraceEnumGenerator.java
+
 enum class PE : uint8_t {
-	// The tag below is consumed by PerfTraceTool.java which generates EnumNames.java
-	// enum_start_tag
-	INVALID,
-	ISR,
-	ContextSwitch,
-	OutputPinSetValue,
-	DecodeTriggerEvent,
-	EnginePeriodicFastCallback,
-	EnginePeriodicSlowCallback,
-	EngineStatePeriodicFastCallback,
-	HandleShaftSignal,
-	EventQueueInsertTask,
-	EventQueueExecuteAll,
-	SingleTimerExecutorDoExecute,
-	SingleTimerExecutorScheduleTimerCallback,
-	PeriodicControllerPeriodicTask,
-	PeriodicTimerControllerPeriodicTask,
-	AdcCallbackFast,
-	AdcProcessSlow,
-	AdcConversionSlow,
-	AdcConversionFast,
-	AdcSubscriptionUpdateSubscribers,
-	GetRunningFuel,
-	GetInjectionDuration,
-	HandleFuel,
-	MainTriggerCallback,
-	OnTriggerEventSparkLogic,
-	ShaftPositionListeners,
-	GetBaseFuel,
-	GetTpsEnrichment,
-	GetSpeedDensityFuel,
-	WallFuelAdjust,
-	MapAveragingTriggerCallback,
-	Unused1,
-	SingleTimerExecutorScheduleByTimestamp,
-	GetTimeNowUs,
-	EventQueueExecuteCallback,
-	PwmGeneratorCallback,
-	TunerStudioHandleCrcCommand,
-	Unused,
-	PwmConfigStateChangeCallback,
-	Temporary1,
-	Temporary2,
-	Temporary3,
-	Temporary4,
-	EngineSniffer,
-	PrepareIgnitionSchedule,
-	Hip9011IntHoldCallback,
-	GlobalLock,
-	GlobalUnlock,
-	SoftwareKnockProcess,
-	KnockAnalyzer,
-	LogTriggerTooth,
-	LuaTickFunction,
-	LuaOneCanRxFunction,
-	LuaAllCanRxFunction,
-	LuaOneCanRxCallback,
-  LuaOneCanTxFunction,
-	// enum_end_tag
-	// The tag above is consumed by PerfTraceTool.java
-	// please note that the tool requires a comma at the end of last value
+#define PE_ENUM_VALUE(name) name,
+	PERF_TRACE_EVENTS(PE_ENUM_VALUE)
+#undef PE_ENUM_VALUE
 };
 
 void perfEventBegin(PE event);
 void perfEventEnd(PE event);
 void perfEventInstantGlobal(PE event);
 
-// Enable one buffer's worth of perf tracing, and retrieve the buffer size in bytes
-void perfTraceEnable();
+// Enable one buffer's worth of perf tracing, false while the buffer is streaming
+bool perfTraceEnable();
 
 // Retrieve the trace buffer
 const BigBufferHandle perfTraceGetBuffer();
 
+/**
+ * Streaming mode: instead of one buffer's worth, records go in to a ring which a reader keeps
+ * draining for as long as it likes. Producers never block nor mask interrupts, when the reader
+ * falls behind records are dropped and counted.
+ *
+ * The stream has a single owner, whoever started it: a TS channel or the SD card log writer.
+ * Only the owner reads and stops it, always from its own thread, everybody else is turned away.
+ */
+using PerfTraceStreamOwner = const void*;
+
+// @return false if somebody else is streaming or the buffer is taken
+bool perfTraceStreamStart(PerfTraceStreamOwner owner);
+// no-op unless owner is streaming, once this returns no producer touches the ring any more
+void perfTraceStreamStop(PerfTraceStreamOwner owner);
+/**
+ * A TS client which went away without STOP would keep the big buffer forever, owner calls this
+ * from its own thread and loses the stream once it did not read for this long
+ */
+#define PERF_TRACE_STREAM_IDLE_TIMEOUT_MS 5000
+void perfTraceStreamStopIfIdle(PerfTraceStreamOwner owner);
+bool perfTraceIsStreaming();
+bool perfTraceStreamIsOwner(PerfTraceStreamOwner owner);
+
+/**
+ * Oldest finished records, same 8 byte layout as perfTraceGetBuffer, contiguous in the ring
+ * so possibly fewer than are pending
+ * @return size in bytes, zero if there is nothing to read or owner is not streaming
+ */
+size_t perfTraceStreamPeek(PerfTraceStreamOwner owner, const uint8_t*& data);
+// hand back what perfTraceStreamPeek returned once it is sent
+void perfTraceStreamRelease(PerfTraceStreamOwner owner, size_t size);
+
+struct Writer;
+// Chrome trace JSON array format start, the closing bracket is optional so a cut off file still loads
+void perfTraceStreamWriteJsonHeader(Writer& writer);
+// drains whatever is pending as Chrome trace JSON, returns bytes written
+size_t perfTraceStreamWriteJson(PerfTraceStreamOwner owner, Writer& writer);
+
+struct PerfTraceStreamStats {
+	uint32_t recorded;
+	// found the ring full
+	uint32_t dropped;
+	// most records ever waiting for the reader
+	uint32_t highWaterMark;
+};
+
+PerfTraceStreamStats perfTraceStreamGetStats();
+void initPerfTrace();
+
 #if ENABLE_PERF_TRACE
 class ScopePerf
 {
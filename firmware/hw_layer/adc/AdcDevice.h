@@ -9,6 +9,8 @@
 
 #if HAL_USE_ADC
 
+#include "adc_decimator.h"
+
 #ifndef ADC_MAX_CHANNELS_COUNT
 #define ADC_MAX_CHANNELS_COUNT 16
 #endif /* ADC_MAX_CHANNELS_COUNT */
@@ -36,6 +38,12 @@ public:
 		/* TODO: in case depth > 1 this will return random (not last) sample */
 		return samples[token];
 	};
+	uint32_t getAdcBurstSumByToken(AdcToken token) {
+		return sumAdcBurst(samples, token, channelCount, depth);
+	}
+	size_t getDepth() const {
+		return depth;
+	}
 	AdcToken getAdcChannelToken(adc_channel_e hwChannel);
 	int size() const;
 	void init(void);
@@ -61,6 +61,14 @@ static AdcChannelMode adcHwChannelMode[EFI_ADC_TOTAL_CHANNELS];
 // todo: move this flag to Engine god object
 static int adcDebugReporting = false;
 
+uint32_t PUBLIC_API_WEAK getFastAdcBurstSum(AdcToken token) {
+	return getFastAdc(token);
+}
+
+size_t PUBLIC_API_WEAK getFastAdcBurstDepth() {
+	return 1;
+}
+
 AdcChannelMode getAdcMode(adc_channel_e hwChannel) {
 	return adcHwChannelMode[hwChannel];
 }
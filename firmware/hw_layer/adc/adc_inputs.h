@@ -113,6 +113,10 @@ static constexpr AdcToken invalidAdcToken = (AdcToken)(-1);
 
 AdcToken enableFastAdcChannel(const char* msg, adc_channel_e channel);
 adcsample_t getFastAdc(AdcToken token);
+// sum of every sample of the channel in the last DMA burst, ports without bursts return getFastAdc()
+uint32_t getFastAdcBurstSum(AdcToken token);
+// samples per channel in getFastAdcBurstSum()
+size_t getFastAdcBurstDepth();
 const ADCConversionGroup* getKnockConversionGroup(uint8_t channelIdx);
 void onKnockSamplingComplete();
 #endif // HAL_USE_ADC
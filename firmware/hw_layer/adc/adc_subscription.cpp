@@ -2,6 +2,39 @@
 
 #include "adc_subscription.h"
 
+void AdcSubscriptionTable::update(FunctionalSensorBase* const (&sensors)[ADC_SUBSCRIPTION_COUNT], const float (&mcuVolts)[ADC_SUBSCRIPTION_COUNT], efitick_t nowNt) {
+	// unconfigured entries run their filters on zeros, that's cheaper than skipping them
+	float sensorVolts[ADC_SUBSCRIPTION_COUNT];
+	for (size_t i = 0; i < efi::size(entries); i++) {
+		sensorVolts[i] = mcuVolts[i] * voltsPerAdcVolt[i];
+	}
+
+	for (size_t i = 0; i < efi::size(entries); i++) {
+		auto &entry = entries[i];
+
+		// On the very first update, preload the filter as if we've been
+		// seeing this value for a long time.  This prevents a slow ramp-up
+		// towards the correct value just after startup
+		if (sensors[i] && !entry.HasUpdated) {
+			filters.cookSteadyState(i, sensorVolts[i]);
+			entry.HasUpdated = true;
+		}
+	}
+
+	float filtered[ADC_SUBSCRIPTION_COUNT];
+	filters.filter(sensorVolts, filtered);
+
+	for (size_t i = 0; i < efi::size(entries); i++) {
+		if (!sensors[i]) {
+			// Skip unconfigured entries
+			continue;
+		}
+
+		entries[i].sensorVolts = sensorVolts[i];
+		sensors[i]->postRawValue(filtered[i], nowNt);
+	}
+}
+
 #if EFI_UNIT_TEST
 
 /*static*/ AdcSubscriptionEntry * AdcSubscription::SubscribeSensor(FunctionalSensorBase&, adc_channel_e, float, float) {
@@ -16,12 +49,16 @@
 
 #else
 
-static AdcSubscriptionEntry s_entries[16];
+static AdcSubscriptionTable s_table;
+
+static size_t getIndex(const AdcSubscriptionEntry* entry) {
+	return entry - s_table.entries;
+}
 
 static AdcSubscriptionEntry* findEntry(FunctionalSensorBase* sensor) {
-	for (size_t i = 0; i < efi::size(s_entries); i++) {
-		if (s_entries[i].Sensor == sensor) {
-			return &s_entries[i];
+	for (size_t i = 0; i < efi::size(s_table.entries); i++) {
+		if (s_table.entries[i].Sensor == sensor) {
+			return &s_table.entries[i];
 		}
 	}
 
@@ -88,9 +125,12 @@ TODO: this code is similar to initIfValid, what is the plan? shall we extract he
 	}
 #endif /* EFI_PROD_CODE && HAL_USE_ADC */
 	// Populate the entry
-	entry->VoltsPerAdcVolt = voltsPerAdcVolt;
+	size_t index = getIndex(entry);
+	s_table.voltsPerAdcVolt[index] = voltsPerAdcVolt;
 	entry->Channel = channel;
-	entry->Filter.configureLowpass(SLOW_ADC_RATE, lowpassCutoff);
+	Biquad filter;
+	filter.configureLowpass(SLOW_ADC_RATE, lowpassCutoff);
+	s_table.filters.configure(index, filter);
 	entry->HasUpdated = false;
 
 	// Set the sensor last - it's the field we use to determine whether this entry is in use
@@ -116,7 +156,7 @@ TODO: this code is similar to initIfValid, what is the plan? shall we extract he
 	// clear the sensor first to mark this entry not in use
 	entry->Sensor = nullptr;
 
-	entry->VoltsPerAdcVolt = 0;
+	s_table.voltsPerAdcVolt[getIndex(entry)] = 0;
 	entry->Channel = EFI_ADC_NONE;
 }
 
@@ -131,8 +171,8 @@ TODO: this code is similar to initIfValid, what is the plan? shall we extract he
 }
 
 void AdcSubscription::ResetFilters() {
-	for (size_t i = 0; i < efi::size(s_entries); i++) {
-		auto &entry = s_entries[i];
+	for (size_t i = 0; i < efi::size(s_table.entries); i++) {
+		auto &entry = s_table.entries[i];
 		entry.HasUpdated = false;
 	}
 }
@@ -140,35 +180,21 @@ void AdcSubscription::ResetFilters() {
 void AdcSubscription::UpdateSubscribers(efitick_t nowNt) {
 	ScopePerf perf(PE::AdcSubscriptionUpdateSubscribers);
 
-	for (size_t i = 0; i < efi::size(s_entries); i++) {
-		auto &entry = s_entries[i];
-
-		if (!entry.Sensor) {
-			// Skip unconfigured entries
-			continue;
-		}
-
-		float mcuVolts = adcGetRawVoltage("sensor", entry.Channel);
-		entry.sensorVolts = mcuVolts * entry.VoltsPerAdcVolt;
-
-		// On the very first update, preload the filter as if we've been
-		// seeing this value for a long time.  This prevents a slow ramp-up
-		// towards the correct value just after startup
-		if (!entry.HasUpdated) {
-			entry.Filter.cookSteadyState(entry.sensorVolts);
-			entry.HasUpdated = true;
-		}
-
-		float filtered = entry.Filter.filter(entry.sensorVolts);
-
-		entry.Sensor->postRawValue(filtered, nowNt);
+	FunctionalSensorBase* sensors[ADC_SUBSCRIPTION_COUNT];
+	float mcuVolts[ADC_SUBSCRIPTION_COUNT];
+	for (size_t i = 0; i < efi::size(s_table.entries); i++) {
+		auto &entry = s_table.entries[i];
+		sensors[i] = entry.Sensor;
+		mcuVolts[i] = sensors[i] ? adcGetRawVoltage("sensor", entry.Channel) : 0;
 	}
+
+	s_table.update(sensors, mcuVolts, nowNt);
 }
 
 #if EFI_PROD_CODE && HAL_USE_ADC
 void AdcSubscription::PrintInfo() {
-	for (size_t i = 0; i < efi::size(s_entries); i++) {
-		auto& entry = s_entries[i];
+	for (size_t i = 0; i < efi::size(s_table.entries); i++) {
+		auto& entry = s_table.entries[i];
 
 		if (!entry.Sensor) {
 			// Skip unconfigured entries
@@ -177,7 +203,8 @@ void AdcSubscription::PrintInfo() {
 
 		const auto name = entry.Sensor->getSensorName();
 		float mcuVolts = adcGetRawVoltage("sensor", entry.Channel);
-		float sensorVolts = mcuVolts * entry.VoltsPerAdcVolt;
+		float voltsPerAdcVolt = s_table.voltsPerAdcVolt[i];
+		float sensorVolts = mcuVolts * voltsPerAdcVolt;
 		auto channel = entry.Channel;
 
 		char pinNameBuffer[16];
@@ -188,7 +215,7 @@ void AdcSubscription::PrintInfo() {
 			channel,
 			(int)getAdcMode(channel),
 			getPinNameByAdcChannel(name, channel, pinNameBuffer, sizeof(pinNameBuffer)),
-			mcuVolts, sensorVolts, entry.VoltsPerAdcVolt
+			mcuVolts, sensorVolts, voltsPerAdcVolt
 		);
 	}
 }
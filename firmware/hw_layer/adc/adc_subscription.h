@@ -6,18 +6,40 @@
 
 #include "functional_sensor_base.h"
 #include "global.h"
-#include "biquad.h"
+#include "biquad_bank.h"
 
+#ifndef ADC_SUBSCRIPTION_COUNT
+#define ADC_SUBSCRIPTION_COUNT 16
+#endif
+
+/**
+ * Divider coefficient and filter of each entry live in AdcSubscriptionTable, at the same index
+ */
 struct AdcSubscriptionEntry {
-	FunctionalSensorBase *Sensor;
-	float VoltsPerAdcVolt;
+	FunctionalSensorBase *Sensor = nullptr;
 	// raw voltage before we apply biquad filter
-	float sensorVolts;
-	Biquad Filter;
-	adc_channel_e Channel;
+	float sensorVolts = 0;
+	adc_channel_e Channel = EFI_ADC_NONE;
 	bool HasUpdated = false;
 };
 
+/**
+ * Structure of arrays, so that an update converts and filters all channels in one loop each
+ */
+class AdcSubscriptionTable {
+public:
+	/**
+	 * One sample of every entry: divider, filter and post to the sensor
+	 * @param sensors as seen while reading mcuVolts, SubscribeSensor could be setting an entry up meanwhile
+	 * @param mcuVolts zero for entries without a sensor
+	 */
+	void update(FunctionalSensorBase* const (&sensors)[ADC_SUBSCRIPTION_COUNT], const float (&mcuVolts)[ADC_SUBSCRIPTION_COUNT], efitick_t nowNt);
+
+	AdcSubscriptionEntry entries[ADC_SUBSCRIPTION_COUNT];
+	float voltsPerAdcVolt[ADC_SUBSCRIPTION_COUNT] = {};
+	BiquadBank<ADC_SUBSCRIPTION_COUNT> filters;
+};
+
 class AdcSubscription {
 public:
 	static AdcSubscriptionEntry *SubscribeSensor(FunctionalSensorBase &sensor, adc_channel_e channel, float lowpassCutoffHZ, float voltsPerAdcVolt = 0.0f);
@@ -0,0 +1,124 @@
+/**
+ * @file	adc_decimator.h
+ *
+ * Oversample and decimate stage for fast ADC channels. The DMA burst already converts every fast
+ * channel ADC_BUF_DEPTH_FAST times, summing the whole burst instead of taking one sample of it
+ * averages noise away for free. On top of that a CIC decimator trades output rate for resolution:
+ * every 4x of decimation is one more bit, as long as there is about an LSB of noise to dither with.
+ *
+ * Integer math all the way, integrators are allowed to wrap around - the combs undo that exactly
+ * as long as the output fits 32 bits: input bits + TOrder * log2(ratio).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+enum class AdcDecimation : uint8_t {
+	// one sample per conversion, as it always was
+	Bypass,
+	// sum of the DMA burst, same output rate
+	Burst,
+	// sum of the DMA burst through AdcDecimator, output rate divided by the ratio
+	Cic,
+};
+
+/**
+ * Sum of one channel's samples in a DMA burst, samples of all channels are interleaved
+ * @param index position of the channel within the first conversion
+ * @param stride number of channels converted each time
+ */
+template <typename TSample>
+uint32_t sumAdcBurst(const volatile TSample* samples, size_t index, size_t stride, size_t depth) {
+	uint32_t sum = 0;
+	for (size_t i = 0; i < depth; i++) {
+		sum += samples[index];
+		index += stride;
+	}
+	return sum;
+}
+
+/**
+ * CIC decimator, differential delay of one
+ */
+template <size_t TOrder>
+class AdcDecimator {
+public:
+	AdcDecimator() {
+		configure(1);
+	}
+
+	/**
+	 * @param ratio input samples per output, 1 passes every sample through
+	 * @param inputGain every input is a sum of that many samples, like a DMA burst
+	 */
+	void configure(uint32_t ratio, uint32_t inputGain = 1) {
+		m_ratio = ratio < 1 ? 1 : ratio;
+
+		uint32_t gain = inputGain < 1 ? 1 : inputGain;
+		for (size_t i = 0; i < TOrder; i++) {
+			gain *= m_ratio;
+		}
+		m_scale = 1.0f / gain;
+
+		reset();
+	}
+
+	void reset() {
+		for (size_t i = 0; i < TOrder; i++) {
+			m_integrators[i] = 0;
+			m_combs[i] = 0;
+		}
+		m_phase = 0;
+		m_output = 0;
+	}
+
+	/**
+	 * Outputs take TOrder of them to settle after configure()
+	 * @return true once per ratio inputs, get() has the new output
+	 */
+	bool add(uint32_t sample) {
+		uint32_t value = sample;
+		for (size_t i = 0; i < TOrder; i++) {
+			m_integrators[i] += value;
+			value = m_integrators[i];
+		}
+
+		if (++m_phase < m_ratio) {
+			return false;
+		}
+		m_phase = 0;
+
+		for (size_t i = 0; i < TOrder; i++) {
+			uint32_t delayed = m_combs[i];
+			m_combs[i] = value;
+			value -= delayed;
+		}
+
+		m_output = value;
+		return true;
+	}
+
+	// in units of a single sample, the fraction is the resolution gained
+	float get() const {
+		return m_output * m_scale;
+	}
+
+	// group delay, in input samples
+	float getLatency() const {
+		return TOrder * (m_ratio - 1) / 2.0f;
+	}
+
+	uint32_t getRatio() const {
+		return m_ratio;
+	}
+
+private:
+	uint32_t m_integrators[TOrder];
+	uint32_t m_combs[TOrder];
+	uint32_t m_ratio = 1;
+	uint32_t m_phase = 0;
+	uint32_t m_output = 0;
+	float m_scale = 1;
+};
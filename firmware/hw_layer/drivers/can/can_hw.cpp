@@ -165,6 +165,7 @@ static void applyListenOnly(CANConfig* canConfig, bool isListenOnly) {
 
 void initCan() {
 	addConsoleAction("caninfo", canInfo);
+	addConsoleAction("canlisteners", printCanListeners);
 
 	isCanEnabled = false;
 
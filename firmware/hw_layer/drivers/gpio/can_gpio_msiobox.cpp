@@ -241,12 +241,13 @@ private:
 	Timer stateTimer;
 };
 
+// any ID mask, acceptFrame takes a range above m_base which is only known after config()
 MsIoBox::MsIoBox()
-	: CanListener(0), m_bus(0), m_base(0), m_period(20) {
+	: CanListener(0, 0), m_bus(0), m_base(0), m_period(20) {
 }
 
 MsIoBox::MsIoBox(uint32_t bus, uint32_t base, uint16_t period)
-	: CanListener(0), m_bus(bus), m_base(base), m_period(period) {
+	: CanListener(0, 0), m_bus(bus), m_base(base), m_period(period) {
 	/* init state */
 	state = MSIOBOX_WAIT_INIT;
 	stateTimer.reset();
@@ -258,8 +258,69 @@ void printSpiConfig(const char *msg, spi_device_e device) {
 
 #if HAL_USE_ADC
 
-static AdcToken fastMapSampleIndex;
-static AdcToken hipSampleIndex;
+#include "adc_decimator.h"
+
+// oversample and decimate for each fast ADC channel group, see adc_decimator.h
+// Bypass reads one sample per conversion, Cic also divides the rate at which consumers get samples
+#ifndef FAST_MAP_DECIMATION
+#define FAST_MAP_DECIMATION AdcDecimation::Bypass
+#endif
+#ifndef FAST_MAP_DECIMATION_RATIO
+#define FAST_MAP_DECIMATION_RATIO 2
+#endif
+
+#ifndef HIP_DECIMATION
+#define HIP_DECIMATION AdcDecimation::Bypass
+#endif
+#ifndef HIP_DECIMATION_RATIO
+#define HIP_DECIMATION_RATIO 2
+#endif
+
+#define FAST_ADC_CIC_ORDER 2
+
+class FastAdcGroup {
+public:
+	FastAdcGroup(AdcDecimation mode, uint32_t ratio)
+		: m_mode(mode)
+		, m_ratio(ratio)
+	{
+	}
+
+	void configure(AdcToken token) {
+		// read from the fast ADC callback
+		chibios_rt::CriticalSectionLocker csl;
+
+		m_token = token;
+		m_decimator.configure(m_mode == AdcDecimation::Cic ? m_ratio : 1, getFastAdcBurstDepth());
+	}
+
+	/**
+	 * @param adc in ADC counts, with fraction unless bypassed
+	 * @return false while the decimator is still collecting
+	 */
+	bool read(float& adc) {
+		if (m_mode == AdcDecimation::Bypass) {
+			adc = getFastAdc(m_token);
+			return true;
+		}
+
+		if (!m_decimator.add(getFastAdcBurstSum(m_token))) {
+			return false;
+		}
+
+		adc = m_decimator.get();
+		return true;
+	}
+
+private:
+	const AdcDecimation m_mode;
+	const uint32_t m_ratio;
+	AdcToken m_token = invalidAdcToken;
+	AdcDecimator<FAST_ADC_CIC_ORDER> m_decimator;
+};
+
+static FastAdcGroup fastMapAdc(FAST_MAP_DECIMATION, FAST_MAP_DECIMATION_RATIO);
+static FastAdcGroup hipAdc(HIP_DECIMATION, HIP_DECIMATION_RATIO);
 
 #if HAL_TRIGGER_USE_ADC
 static AdcToken triggerSampleIndex;
@@ -290,11 +351,15 @@ void onFastAdcComplete(adcsample_t*) {
 #endif /* EFI_SENSOR_CHART */
 
 #if EFI_MAP_AVERAGING
-	mapAveragingAdcCallback(adcRawValueToScaledVoltage(getFastAdc(fastMapSampleIndex), engineConfiguration->map.sensor.hwChannel));
+	float mapAdc;
+	if (fastMapAdc.read(mapAdc)) {
+		mapAveragingAdcCallback(adcRawValueToScaledVoltage(mapAdc, engineConfiguration->map.sensor.hwChannel));
+	}
 #endif /* EFI_MAP_AVERAGING */
 #if EFI_HIP_9011
-	if (engineConfiguration->isHip9011Enabled) {
-		hipAdcCallback(adcRawValueToScaledVoltage(getFastAdc(hipSampleIndex), engineConfiguration->hipOutputChannel));
+	float hipAdcValue;
+	if (engineConfiguration->isHip9011Enabled && hipAdc.read(hipAdcValue)) {
+		hipAdcCallback(adcRawValueToScaledVoltage(hipAdcValue, engineConfiguration->hipOutputChannel));
 	}
 #endif /* EFI_HIP_9011 */
 }
@@ -302,8 +367,8 @@ void onFastAdcComplete(adcsample_t*) {
 
 static void calcFastAdcIndexes() {
 #if HAL_USE_ADC
-	fastMapSampleIndex = enableFastAdcChannel("Fast MAP", engineConfiguration->map.sensor.hwChannel);
-	hipSampleIndex = enableFastAdcChannel("HIP9011", engineConfiguration->hipOutputChannel);
+	fastMapAdc.configure(enableFastAdcChannel("Fast MAP", engineConfiguration->map.sensor.hwChannel));
+	hipAdc.configure(enableFastAdcChannel("HIP9011", engineConfiguration->hipOutputChannel));
 #if HAL_TRIGGER_USE_ADC
 	triggerSampleIndex = enableFastAdcChannel("Trigger ADC", getAdcChannelForTrigger());
 #endif /* HAL_TRIGGER_USE_ADC */
@@ -33,6 +33,13 @@ static bool sdLoggerReady = false;
 
 #if EFI_PROD_CODE
 
+#if ENABLE_PERF_TRACE
+// streaming perf trace to a Chrome trace .json instead of the usual log, takes effect with the next log session
+// unless a TS link owns the stream by then
+static bool isSdPerfTrace = false;
+static bool isSdPerfTraceActive = false;
+#endif // ENABLE_PERF_TRACE
+
 #include <stdio.h>
 #include <string.h>
 #include "mmc_card.h"
@@ -42,6 +49,9 @@ static bool sdLoggerReady = false;
 #include "hellen_meta.h"
 
 #include "rtc_helper.h"
+#include "mlg_record_ring.h"
+#include "mlg_row_filter.h"
+#include "thread_controller.h"
 
 // TODO: do we need this additioal layer of buffering?
 // FIL structure already have buffer of FF_MAX_SS size
@@ -298,6 +308,8 @@ static void printMmcPinout() {
 //	efiPrintf("MMC MOSI %s:%d", portname(EFI_SPI2_MOSI_PORT), EFI_SPI2_MOSI_PIN);
 }
 
+static void printMlgRingInfo();
+
 static void sdStatistics() {
 	printMmcPinout();
 	efiPrintf("SD enabled=%s status=%s", boolToString(engineConfiguration->isSdCardEnabled),
@@ -312,6 +324,7 @@ static void sdStatistics() {
 	}
 #if EFI_FILE_LOGGING
 	efiPrintf("%d SD card fields", getSdCardFieldsCount());
+	printMlgRingInfo();
 #endif
 }
 
@@ -338,6 +351,13 @@ static void prepareLogFileName() {
 		ptr = itoa10(&logName[PREFIX_LEN], logFileIndex);
 	}
 
+#if ENABLE_PERF_TRACE
+	if (isSdPerfTraceActive) {
+		strcat(ptr, ".json");
+		return;
+	}
+#endif // ENABLE_PERF_TRACE
+
 	if (engineConfiguration->sdTriggerLog) {
 		strcat(ptr, ".teeth");
 	} else {
@@ -613,9 +633,17 @@ static int mlgLogger();
 // Log binary trigger log
 static int sdTriggerLogger();
 
+#if ENABLE_PERF_TRACE
+// Log perf trace as Chrome trace JSON
+static int sdPerfTraceLogger();
+#endif
+
 static bool sdLoggerInitDone = false;
 static bool sdLoggerFailed = false;
 
+static void mlgStartFile();
+static int mlgWritePending();
+
 static int sdLogger(FIL *fd)
 {
 	int ret = 0;
@@ -624,11 +652,16 @@ static int sdLogger(FIL *fd)
 		incLogFileName(fd);
 		sdLoggerCreateFile(fd);
 		logBuffer.start(fd);
-		resetFileLogging();
+		mlgStartFile();
 		sdLoggerInitDone = true;
 	}
 
 	if (!sdLoggerFailed) {
+#if ENABLE_PERF_TRACE
+		if (isSdPerfTraceActive) {
+			ret = sdPerfTraceLogger();
+		} else
+#endif // ENABLE_PERF_TRACE
 		if (engineConfiguration->sdTriggerLog) {
 			ret = sdTriggerLogger();
 		} else {
@@ -645,6 +678,10 @@ static int sdLogger(FIL *fd)
 	// in next write (assume same size as current) will cross LOGGER_MAX_FILE_SIZE boundary
 	// TODO: use f_tell() instead ?
 	if (logBuffer.writen() + ret > LOGGER_MAX_FILE_SIZE) {
+		// records captured so far belong to the old file, not after the header of the new one
+		if (mlgWritePending() < 0) {
+			sdLoggerFailed = true;
+		}
 		logBuffer.stop();
 		sdLoggerCloseFile(fd);
 
@@ -652,7 +689,7 @@ static int sdLogger(FIL *fd)
 		incLogFileName(fd);
 		sdLoggerCreateFile(fd);
 		logBuffer.start(fd);
-		resetFileLogging();
+		mlgStartFile();
 	}
 #endif
 
@@ -664,6 +701,17 @@ static void sdLoggerStart(void)
 	sdLoggerInitDone = false;
 	sdLoggerFailed = false;
 
+#if ENABLE_PERF_TRACE
+	// takes the big buffer, tooth logger stays off for this session
+	isSdPerfTraceActive = isSdPerfTrace && perfTraceStreamStart(&logBuffer);
+	if (isSdPerfTraceActive) {
+		return;
+	}
+	if (isSdPerfTrace) {
+		efiPrintf("SD perf trace: stream is taken, usual log this session");
+	}
+#endif // ENABLE_PERF_TRACE
+
 #if EFI_TOOTH_LOGGER
 	// TODO: cache this config option untill sdLoggerStop()
 	if (engineConfiguration->sdTriggerLog) {
@@ -672,9 +720,19 @@ static void sdLoggerStart(void)
 #endif
 }
 
+static void mlgStopCapture();
+
 static void sdLoggerStop(void)
 {
+	mlgStopCapture();
 	sdLoggerCloseFile(&resources.fd);
+#if ENABLE_PERF_TRACE
+	if (isSdPerfTraceActive) {
+		perfTraceStreamStop(&logBuffer);
+		isSdPerfTraceActive = false;
+		return;
+	}
+#endif // ENABLE_PERF_TRACE
 #if EFI_TOOTH_LOGGER
 	// TODO: cache this config option untill sdLoggerStop()
 	if (engineConfiguration->sdTriggerLog) {
@@ -887,38 +945,193 @@ die:
 	}
 }
 
+#ifndef MLG_RECORD_RING_SIZE
+// With 1-2KB records that's only 8-16 records: 160-320ms of SD card hiccup at the default 50Hz
+// but just 32-64ms at MLG_MAX_FREQUENCY. See 'sdinfo' for the actual coverage and dropped records,
+// boards with spare RAM may go bigger.
+#define MLG_RECORD_RING_SIZE 16384
+#endif
+
+// same as sdCardLogFrequency limit, a ring covering SD card stalls at a higher rate would not fit in RAM
+#define MLG_MAX_FREQUENCY 250
+
+// how long the writer naps once the ring is drained
+#define MLG_WRITER_IDLE_MS 5
+
+static MlgRecordRing<MLG_RECORD_RING_SIZE> mlgRing CCM_OPTIONAL;
+static volatile bool isMlgCaptureEnabled = false;
+// held by the capture thread for the whole snapshot, see mlgStopCapture
+static chibios_rt::Mutex mlgCaptureMutex;
+
+// see mlg_row_filter.h, sdCardLogVariableRate as of log session start
+static bool isMlgVariableRateActive = false;
+static MlgRowFilter mlgRowFilter CCM_OPTIONAL;
+static uint32_t mlgWriterMaxBatch = 0;
+
+static systime_t getMlgCapturePeriod() {
+	auto freq = engineConfiguration->sdCardLogFrequency;
+	if (freq > MLG_MAX_FREQUENCY) {
+		freq = MLG_MAX_FREQUENCY;
+	} else if (freq < 1) {
+		freq = 1;
+	}
+
+	return CH_CFG_ST_FREQUENCY / freq;
+}
+
+/**
+ * Snapshots live data at a fixed rate regardless of how the SD card is doing
+ */
+class MlgCaptureThread final : public ThreadController<3 * UTILITY_THREAD_STACK_SIZE> {
+public:
+	MlgCaptureThread() : ThreadController("MLG capture", PRIO_MLG_CAPTURE) { }
+
+	void ThreadTask() override {
+		while (true) {
+			systime_t before = chVTGetSystemTime();
+
+			{
+				chibios_rt::MutexLocker lock(mlgCaptureMutex);
+				if (isMlgCaptureEnabled) {
+					capture();
+				}
+			}
+
+			chThdSleepUntilWindowed(before, before + getMlgCapturePeriod());
+		}
+	}
+
+private:
+	void capture() {
+		uint8_t* slot = mlgRing.beginWrite();
+		if (!slot) {
+			// writer is behind, droppedCounter already knows
+			return;
+		}
+
+		// serialized straight in to the ring slot
+		if (captureSdLogRecord(slot, mlgRing.getRecordSize()) != mlgRing.getRecordSize()) {
+			return;
+		}
+
+		if (isMlgVariableRateActive && !mlgRowFilter.shouldWrite(slot, mlgRing.getLastWrite(), getTimeNowNt())) {
+			// nothing new, slot is reused by the next capture
+			return;
+		}
+
+		mlgRing.commitWrite();
+	}
+};
+
+static MlgCaptureThread mlgCaptureThread;
+
+/**
+ * Once this returns no snapshot is in progress and none will start, so the ring is ours to reset
+ */
+static void mlgStopCapture() {
+	chibios_rt::MutexLocker lock(mlgCaptureMutex);
+	isMlgCaptureEnabled = false;
+}
+
+static void mlgStartFile() {
+#if ENABLE_PERF_TRACE
+	if (isSdPerfTraceActive) {
+		// every file is a trace of its own
+		perfTraceStreamWriteJsonHeader(logBuffer);
+		return;
+	}
+#endif // ENABLE_PERF_TRACE
+
+	if (engineConfiguration->sdTriggerLog) {
+		return;
+	}
+
+	if (!isMlgCaptureEnabled) {
+		// first file of this session: start from a clean ring, capture is not running yet
+		resetFileLogging();
+		if (!mlgRing.setRecordSize(getSdLogRecordSize())) {
+			criticalError("MLG record of %d bytes does not fit MLG_RECORD_RING_SIZE", getSdLogRecordSize());
+			return;
+		}
+
+		isMlgVariableRateActive = engineConfiguration->sdCardLogVariableRate;
+		if (isMlgVariableRateActive) {
+			mlgRowFilter.init();
+		}
+	}
+
+	// on rotation sdLogger has already written whatever was pending to the previous file
+	writeSdLogHeader(logBuffer);
+
+	mlgCaptureThread.start();
+	isMlgCaptureEnabled = true;
+}
+
+// drains everything captured so far, SD card speed only affects how deep the ring gets
 static int mlgLogger() {
 	// TODO: move this check somewhere out of here!
 	// if the SPI device got un-picked somehow, cancel SD card
 	// Don't do this check at all if using SDMMC interface instead of SPI
 #if EFI_PROD_CODE && !defined(EFI_SDC_DEVICE)
 	if (engineConfiguration->sdCardSpiDevice == SPI_NONE) {
+		mlgStopCapture();
 		return 0;
 	}
 #endif
 
-	systime_t before = chVTGetSystemTime();
+	int writen = mlgWritePending();
+	if (writen == 0) {
+		chThdSleepMilliseconds(MLG_WRITER_IDLE_MS);
+	}
 
-	size_t writen = writeSdLogLine(logBuffer);
+	return writen;
+}
 
-	// Something went wrong (already handled), so cancel further writes
-	if (logBuffer.failed) {
-		return -1;
+/**
+ * Writes the records captured up to now, later ones stay in the ring
+ * @return bytes written, -1 if SD card has failed
+ */
+static int mlgWritePending() {
+	if (!isMlgCaptureEnabled) {
+		return 0;
 	}
 
-	auto freq = engineConfiguration->sdCardLogFrequency;
-	if (freq > 250) {
-		freq = 250;
-	} else if (freq < 1) {
-		freq = 1;
+	size_t writen = 0;
+	uint32_t batch = mlgRing.getPendingCount();
+	for (uint32_t i = 0; i < batch; i++) {
+		// whole records go to the 512 byte sector buffer, f_write only ever sees full sectors
+		logBuffer.write(reinterpret_cast<const char*>(mlgRing.peek()), mlgRing.getRecordSize());
+		mlgRing.release();
+
+		// Something went wrong (already handled), so cancel further writes
+		if (logBuffer.failed) {
+			mlgStopCapture();
+			return -1;
+		}
+
+		writen += mlgRing.getRecordSize();
 	}
 
-	systime_t period = CH_CFG_ST_FREQUENCY / freq;
-	chThdSleepUntilWindowed(before, before + period);
+	if (batch > mlgWriterMaxBatch) {
+		mlgWriterMaxBatch = batch;
+	}
 
 	return writen;
 }
 
+static void printMlgRingInfo() {
+	efiPrintf("MLG: %d records captured, %d dropped, %d pending, max %d pending of %d slots (%d bytes each), max batch %d",
+		(int)mlgRing.capturedCounter, (int)mlgRing.droppedCounter, (int)mlgRing.getPendingCount(),
+		(int)mlgRing.highWaterMark, (int)mlgRing.getCapacity(), (int)mlgRing.getRecordSize(),
+		(int)mlgWriterMaxBatch);
+	efiPrintf("MLG: worst writer lag %dms, ring covers %dms at current rate",
+		(int)(mlgRing.highWaterMark * TIME_I2MS(getMlgCapturePeriod())),
+		(int)(mlgRing.getCapacity() * TIME_I2MS(getMlgCapturePeriod())));
+	efiPrintf("MLG: variable rate %s, %d rows written, %d skipped, %d spans",
+		boolToString(isMlgVariableRateActive), (int)mlgRowFilter.writtenCounter, (int)mlgRowFilter.skippedCounter,
+		(int)mlgRowFilter.getSpanCount());
+}
+
 static int sdTriggerLogger() {
 	size_t toWrite = 0;
 #if EFI_TOOTH_LOGGER
@@ -938,6 +1151,26 @@ static int sdTriggerLogger() {
 	return toWrite;
 }
 
+#if ENABLE_PERF_TRACE
+static int sdPerfTraceLogger() {
+	size_t writen = perfTraceStreamWriteJson(&logBuffer, logBuffer);
+	if (logBuffer.failed) {
+		return -1;
+	}
+
+	if (writen == 0) {
+		chThdSleepMilliseconds(MLG_WRITER_IDLE_MS);
+	}
+
+	return writen;
+}
+
+static void setSdPerfTrace(int value) {
+	isSdPerfTrace = value;
+	efiPrintf("SD perf trace %s, takes effect with next log session", boolToString(isSdPerfTrace));
+}
+#endif // ENABLE_PERF_TRACE
+
 #endif // EFI_PROD_CODE
 
 void updateSdCardLiveFlags() {
@@ -962,6 +1195,9 @@ void initEarlyMmcCard() {
 	addConsoleActionS("del", removeFile);
 	addConsoleActionS("sdmode", sdSetMode);
 	addConsoleAction("delreports", sdCardRemoveReportFiles);
+#if ENABLE_PERF_TRACE
+	addConsoleActionI("perftracesd", setSdPerfTrace);
+#endif
 	//incLogFileName() use same shared FDLogFile, calling it while FDLogFile is used by log writer will cause damage
 	//addConsoleAction("incfilename", incLogFileName);
 #endif // EFI_PROD_CODE
@@ -233,6 +233,18 @@ adcsample_t getFastAdc(AdcToken token) {
 	return fastAdc.getAdcValueByToken(token);
 }
 
+uint32_t getFastAdcBurstSum(AdcToken token) {
+	if (token == invalidAdcToken) {
+		return 0;
+	}
+
+	return fastAdc.getAdcBurstSumByToken(token);
+}
+
+size_t getFastAdcBurstDepth() {
+	return fastAdc.getDepth();
+}
+
 #endif
 
 #ifdef EFI_SOFTWARE_KNOCK
@@ -82,7 +82,7 @@ float HIP9011::getBand(DEFINE_HIP_PARAMS) {
 
 int HIP9011::getBandIndex(DEFINE_HIP_PARAMS) {
 	float freq = getBand(FORWARD_HIP_PARAMS);
-	int i = findIndexMsg("freq", bandFreqLookup, BAND_LOOKUP_SIZE, freq);
+	int i = findIndexMsg("freq", bandFreqLookup, freq);
 	if (i < 0)
 		i = 0;
 	if (i > BAND_LOOKUP_SIZE - 1)
@@ -92,7 +92,7 @@ int HIP9011::getBandIndex(DEFINE_HIP_PARAMS) {
 }
 
 int HIP9011::getGainIndex(DEFINE_HIP_PARAMS) {
-	int i = findIndexMsg("fGain", gainLookupInReverseOrder, GAIN_LOOKUP_SIZE, GET_CONFIG_VALUE(hip9011Gain));
+	int i = findIndexMsg("fGain", gainLookupInReverseOrder, (float)GET_CONFIG_VALUE(hip9011Gain));
 	if (i < 0)
 		i = 0;
 	if (i > GAIN_LOOKUP_SIZE - 1)
@@ -123,17 +123,27 @@ float HIP9011::getRpmByAngleWindowAndTimeUs(int timeUs, float p_angleWindowWidth
  *
  * We know the set of possible integration times, we know the knock detection window width
  */
-void HIP9011::prepareRpmLookup(void) {
+bool HIP9011::prepareRpmLookup(void) {
 	/**
 	 * out binary search method needs increasing order thus the reverse order here
 	 */
 	for (int i = 0; i < INT_LOOKUP_SIZE; i++) {
-		rpmLookup[i] = getRpmByAngleWindowAndTimeUs(integratorValues[INT_LOOKUP_SIZE - i - 1], angleWindowWidth);
+		float rpm = getRpmByAngleWindowAndTimeUs(integratorValues[INT_LOOKUP_SIZE - i - 1], angleWindowWidth);
+		// wide windows push short integration times past what uint16_t holds
+		rpmLookup[i] = rpm < UINT16_MAX ? rpm : UINT16_MAX;
 	}
+
+	// built at runtime, validateConfigOnStartUpOrBurn does not know about it
+	for (int i = 0; i < INT_LOOKUP_SIZE - 1; i++) {
+		if (rpmLookup[i + 1] <= rpmLookup[i]) {
+			return false;
+		}
+	}
+	return true;
 }
 
 int HIP9011::getIntegrationIndexByRpm(float rpm) {
-	int i = findIndexMsg("getIbR", rpmLookup, INT_LOOKUP_SIZE, (uint16_t)(rpm));
+	int i = findIndexMsg("getIbR", rpmLookup, (uint16_t)(rpm));
 	return i == -1 ? INT_LOOKUP_SIZE - 1 : INT_LOOKUP_SIZE - i - 1;
 }
 
@@ -153,7 +163,11 @@ void HIP9011::setAngleWindowWidth(DEFINE_HIP_PARAMS) {
 	if (angleWindowWidth == new_angleWindowWidth)
 		return; // exit if value has not change
 	angleWindowWidth = new_angleWindowWidth;
-	prepareRpmLookup();
+	if (!prepareRpmLookup()) {
+#if EFI_PROD_CODE
+		warning(ObdCode::CUSTOM_KNOCK_WINDOW, "knock window %d: integrator lookup not ascending", (int)angleWindowWidth);
+#endif
+	}
 }
 
 void HIP9011::handleSettings(int rpm DEFINE_PARAM_SUFFIX(DEFINE_HIP_PARAMS)) {
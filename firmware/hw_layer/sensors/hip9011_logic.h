@@ -84,7 +84,10 @@ public:
 	int sendCommandGetReply(uint8_t cmd, uint8_t *reply);
 
 	float getRpmByAngleWindowAndTimeUs(int timeUs, float angleWindowWidth);
-	void prepareRpmLookup(void);
+	/**
+	 * @return false if lookup is not ascending, see findIndexMsg
+	 */
+	bool prepareRpmLookup(void);
 	void setAngleWindowWidth(DEFINE_HIP_PARAMS);
 	void handleSettings(int rpm DEFINE_PARAM_SUFFIX(DEFINE_HIP_PARAMS));
 	int cylinderToChannelIdx(int cylinder);
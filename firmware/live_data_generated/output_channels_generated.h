@@ -1420,9 +1420,81 @@ struct output_channels_s {
 	 */
 	uint32_t mcuSerial = (uint32_t)0;
 	/**
+	 * CAN: listener hits
+	 * units: count
 	 * offset 812
 	 */
-	uint8_t unusedAtTheEnd[48] = {};
+	uint32_t canListenerHitCounter = (uint32_t)0;
+	/**
+	 * CAN: listeners by ID
+	 * units: count
+	 * offset 816
+	 */
+	uint8_t canListenersById = (uint8_t)0;
+	/**
+	 * CAN: listeners by mask
+	 * units: count
+	 * offset 817
+	 */
+	uint8_t canListenersMasked = (uint8_t)0;
+	/**
+	 * CAN: listeners offered last frame
+	 * units: count
+	 * offset 818
+	 */
+	uint8_t canListenersLastVisited = (uint8_t)0;
+	/**
+	 * Lua: CAN RX queue high water
+	 * units: frames
+	 * offset 819
+	 */
+	uint8_t luaCanRxQueueHighWater = (uint8_t)0;
+	/**
+	 * Lua: CAN RX dropped frames
+	 * units: count
+	 * offset 820
+	 */
+	uint16_t luaCanRxDropCounter = (uint16_t)0;
+	/**
+	 * Lua: CAN RX queue overflows
+	 * units: count
+	 * offset 822
+	 */
+	uint16_t luaCanRxOverflowCounter = (uint16_t)0;
+	/**
+	 * Modules: fast pass max
+	 * units: us
+	 * offset 824
+	 */
+	uint16_t moduleFastPassMaxUs = (uint16_t)0;
+	/**
+	 * Modules: slow pass max
+	 * units: us
+	 * offset 826
+	 */
+	uint16_t moduleSlowPassMaxUs = (uint16_t)0;
+	/**
+	 * Modules: overruns
+	 * units: count
+	 * offset 828
+	 */
+	uint16_t moduleOverrunCount = (uint16_t)0;
+	/**
+	 * Modules: slowest module max
+	 * units: us
+	 * offset 830
+	 */
+	uint16_t moduleSlowestMaxUs = (uint16_t)0;
+	/**
+	 * Modules: slowest module
+	 * units: index
+	 * offset 832
+	 */
+	uint8_t moduleSlowestIndex = (uint8_t)0;
+	/**
+	 * offset 833
+	 */
+	uint8_t unusedAtTheEnd[27] = {};
 };
 static_assert(sizeof(output_channels_s) == 860);
 
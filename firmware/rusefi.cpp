@@ -230,6 +230,10 @@ void runRusEfi() {
 	 */
 	initializeConsole();
 
+#if ENABLE_PERF_TRACE
+	initPerfTrace();
+#endif
+
 	// Read configuration from flash memory
 	loadConfiguration();
 
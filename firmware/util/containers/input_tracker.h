@@ -0,0 +1,69 @@
+/**
+ * @file input_tracker.h
+ *
+ * Tells if a value derived from a few slow moving inputs has to be recomputed: inputs are compared
+ * against the ones used for the last recompute, not the last sample, so a slow drift still gets
+ * through once it adds up to more than the deadband.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "local_version_holder.h"
+
+template <size_t TInputCount>
+class InputTracker {
+public:
+	/**
+	 * @param deadbands how far each input may move before the derived value is stale, zero means any change
+	 */
+	explicit InputTracker(const float (&deadbands)[TInputCount]) {
+		for (size_t i = 0; i < TInputCount; i++) {
+			m_deadbands[i] = deadbands[i];
+			m_inputs[i] = 0;
+		}
+	}
+
+	/**
+	 * NaN is a valid input, for example a failed sensor, going from or to NaN counts as a change
+	 * @param version of whatever else the derived value depends on, like tables of the tune
+	 * @return true on first call, on version change or if any input has moved more than its deadband
+	 */
+	bool update(int version, const float (&inputs)[TInputCount]) {
+		// isOld() has to see every version
+		bool isStale = m_version.isOld(version);
+
+		for (size_t i = 0; i < TInputCount && !isStale; i++) {
+			isStale = hasChanged(m_inputs[i], inputs[i], m_deadbands[i]);
+		}
+
+		if (!isStale) {
+			skipCounter++;
+			return false;
+		}
+
+		for (size_t i = 0; i < TInputCount; i++) {
+			m_inputs[i] = inputs[i];
+		}
+		recomputeCounter++;
+		return true;
+	}
+
+	uint32_t recomputeCounter = 0;
+	uint32_t skipCounter = 0;
+
+private:
+	static bool hasChanged(float previous, float current, float deadband) {
+		if (std::isnan(previous) || std::isnan(current)) {
+			return std::isnan(previous) != std::isnan(current);
+		}
+		return std::abs(current - previous) > deadband;
+	}
+
+	LocalVersionHolder m_version;
+	float m_deadbands[TInputCount];
+	float m_inputs[TInputCount];
+};
@@ -12,6 +12,7 @@
 #include "efilib.h"
 #include "efi_ratio.h"
 #include "efi_scaled_channel.h"
+#include "axis_lookup_cache.h"
 #include <rusefi/interpolation.h>
 
 #if EFI_UNIT_TEST
@@ -51,6 +52,13 @@ public:
 		initCols(columnBins);
 	}
 
+	/**
+	 * Lookups within an open cycle of this cache share their bin search with other tables on the same axes
+	 */
+	void setAxisLookupCache(AxisLookupCache* cache) {
+		m_axisLookupCache = cache;
+	}
+
   // RPM is usually X/Column
 	float getValue(float xColumn, float yRow) const final {
 		if (!m_values) {
@@ -58,6 +66,13 @@ public:
 			return 0;
 		}
 
+		if (m_axisLookupCache) {
+			return m_axisLookupCache->interpolate3d(*m_values,
+								*m_rowBins, yRow * m_rowMult,
+								*m_columnBins, xColumn * m_colMult) *
+				m_valueMult;
+		}
+
 		return interpolate3d(*m_values,
 								*m_rowBins, yRow * m_rowMult,
 								*m_columnBins, xColumn * m_colMult) *
@@ -129,6 +144,7 @@ private:
 	float m_rowMult = 1;
 	float m_colMult = 1;
 	float m_valueMult = 1;
+	AxisLookupCache* m_axisLookupCache = nullptr;
 	const char *m_name;
 };
 
@@ -0,0 +1,170 @@
+/**
+ * @file    axis_lookup_cache.h
+ *
+ * Most of our 3D tables are looked up with the same RPM/load pair within one fast callback,
+ * often on the very same axis arrays - per-cylinder fuel and ignition trims for instance
+ * all share one pair of bins. This cache remembers where a value falls on an axis so that
+ * every following table on the same axis skips the bin search and the scaling math.
+ *
+ * Cache is only consulted between beginCycle() and endCycle(), and only by the thread which
+ * opened the cycle: lookups from any other thread or from an ISR are computed from scratch and
+ * never touch the cache. Hits are matched by axis address and value. Axis content is not
+ * compared, instead the cache is dropped as soon as the tune version moves, which is how
+ * a TS write landing in the middle of a cycle is noticed.
+ *
+ * See also libfirmware interpolation.h
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Position of a value on a table axis: bin index and how far into that bin we are
+ */
+struct AxisPosition {
+	size_t Idx;
+	float Frac;
+};
+
+/**
+ * Same clamping as interpolate3d: off-scale low sticks to the first bin, off-scale high to the last one
+ */
+template<typename TBin, int TSize>
+AxisPosition findAxisPosition(const TBin (&bins)[TSize], float value) {
+	static_assert(TSize >= 2, "Table axis needs at least two bins");
+
+	if (std::isnan(value) || value <= (float)bins[0]) {
+		return { 0, 0.0f };
+	}
+
+	if (value >= (float)bins[TSize - 1]) {
+		return { TSize - 2, 1.0f };
+	}
+
+	// value is strictly within the axis here: branchless count of inner bins at or below it, see findIndexMsg
+	size_t idx = 0;
+	for (int i = 1; i < TSize - 1; i++) {
+		idx += (float)bins[i] <= value;
+	}
+
+	float low = bins[idx];
+	float high = bins[idx + 1];
+
+	return { idx, (value - low) / (high - low) };
+}
+
+template<typename TValue, int TRowNum, int TColNum>
+float interpolateAxisPositions(const TValue (&table)[TRowNum][TColNum], AxisPosition row, AxisPosition col) {
+	float lowerLeft = table[row.Idx][col.Idx];
+	float upperLeft = table[row.Idx + 1][col.Idx];
+	float lowerRight = table[row.Idx][col.Idx + 1];
+	float upperRight = table[row.Idx + 1][col.Idx + 1];
+
+	float left = upperLeft * row.Frac + lowerLeft * (1 - row.Frac);
+	float right = upperRight * row.Frac + lowerRight * (1 - row.Frac);
+
+	return right * col.Frac + left * (1 - col.Frac);
+}
+
+#ifndef AXIS_LOOKUP_CACHE_SIZE
+#define AXIS_LOOKUP_CACHE_SIZE 12
+#endif
+
+/**
+ * Thread or ISR doing the lookup
+ */
+inline const void* getAxisLookupContext() {
+#if EFI_UNIT_TEST
+	// single threaded
+	static const char mainThread = 0;
+	return &mainThread;
+#else
+	// within an ISR chThdGetSelfX() is the interrupted thread, which may well be the owner
+	return port_is_isr_context() ? nullptr : chThdGetSelfX();
+#endif
+}
+
+class AxisLookupCache {
+public:
+	/**
+	 * @param tuneVersion has to move on every change of any axis, see Engine::tuneVersion
+	 */
+	void beginCycle(const int& tuneVersion) {
+		m_tuneVersion = &tuneVersion;
+		m_cachedTuneVersion = tuneVersion;
+		m_count = 0;
+		m_owner = getAxisLookupContext();
+	}
+
+	void endCycle() {
+		m_owner = nullptr;
+	}
+
+	template<typename TBin, int TSize>
+	AxisPosition lookup(const TBin (&bins)[TSize], float value) {
+		if (m_owner == nullptr || m_owner != getAxisLookupContext()) {
+			return findAxisPosition(bins, value);
+		}
+
+		if (*m_tuneVersion != m_cachedTuneVersion) {
+			m_cachedTuneVersion = *m_tuneVersion;
+			m_count = 0;
+		}
+
+		for (size_t i = 0; i < m_count; i++) {
+			Entry& entry = m_entries[i];
+			// same array viewed as the same bin type, same value: same answer
+			if (entry.bins == bins && entry.value == value && entry.binType == binTypeTag<TBin>()) {
+				hitCounter++;
+				return entry.position;
+			}
+		}
+
+		missCounter++;
+		AxisPosition position = findAxisPosition(bins, value);
+
+		if (m_count < AXIS_LOOKUP_CACHE_SIZE) {
+			m_entries[m_count++] = { bins, binTypeTag<TBin>(), value, position };
+		}
+
+		return position;
+	}
+
+	/**
+	 * Drop-in replacement for interpolate3d, same argument order
+	 */
+	template<typename TValue, int TRowNum, typename TRow, int TColNum, typename TColumn>
+	float interpolate3d(const TValue (&table)[TRowNum][TColNum],
+			const TRow (&rowBins)[TRowNum], float rowValue,
+			const TColumn (&colBins)[TColNum], float colValue) {
+		return interpolateAxisPositions(table, lookup(rowBins, rowValue), lookup(colBins, colValue));
+	}
+
+	uint32_t hitCounter = 0;
+	uint32_t missCounter = 0;
+
+private:
+	// one unique address per bin type: Map3D looks at scaled bins through their raw type
+	template<typename TBin>
+	static const void* binTypeTag() {
+		static const char tag = 0;
+		return &tag;
+	}
+
+	struct Entry {
+		const void *bins;
+		const void *binType;
+		float value;
+		AxisPosition position;
+	};
+
+	Entry m_entries[AXIS_LOOKUP_CACHE_SIZE];
+	size_t m_count = 0;
+	// whoever opened the current cycle, null outside of a cycle
+	const void* volatile m_owner = nullptr;
+	const volatile int* m_tuneVersion = nullptr;
+	int m_cachedTuneVersion = 0;
+};
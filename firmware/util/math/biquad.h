@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 class Biquad {
 public:
 	Biquad();
@@ -22,6 +24,10 @@ public:
 	void configureLowpass(float samplingFrequency, float cutoffFrequency, float Q = 0.54f);
 
 private:
+	// takes the coefficients over for batch filtering
+	template <size_t TChannelCount>
+	friend class BiquadBank;
+
 	float a0, a1, a2, b1, b2;
 	float z1, z2;
 };
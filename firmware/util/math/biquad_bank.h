@@ -0,0 +1,66 @@
+/**
+ * @file biquad_bank.h
+ *
+ * A number of independent Biquad filters, one sample each per step, stored as structure of arrays
+ * so that one step of all of them is a single branch free loop the compiler can vectorize.
+ * Same math, same order of operations as Biquad::filter.
+ *
+ * CMSIS-DSP biquad cascades run many samples through one channel, here it is the other way around.
+ */
+
+#pragma once
+
+#include "biquad.h"
+
+template <size_t TChannelCount>
+class BiquadBank {
+public:
+	BiquadBank() {
+		for (size_t i = 0; i < TChannelCount; i++) {
+			configure(i, Biquad());
+		}
+	}
+
+	/**
+	 * Takes over coefficients and state of a configured filter
+	 */
+	void configure(size_t index, const Biquad& filter) {
+		a0[index] = filter.a0;
+		a1[index] = filter.a1;
+		a2[index] = filter.a2;
+		b1[index] = filter.b1;
+		b2[index] = filter.b2;
+		z1[index] = filter.z1;
+		z2[index] = filter.z2;
+	}
+
+	// see Biquad::cookSteadyState
+	void cookSteadyState(size_t index, float steadyStateInput) {
+		float Y = steadyStateInput * (a0[index] + a1[index] + a2[index]) / (1 + b1[index] + b2[index]);
+
+		z2[index] = steadyStateInput * a2[index] - Y * b2[index];
+		z1[index] = z2[index] + steadyStateInput * a1[index] - Y * b1[index];
+	}
+
+	/**
+	 * One step of every channel, output may not alias input
+	 */
+	void filter(const float (&input)[TChannelCount], float (&output)[TChannelCount]) {
+		for (size_t i = 0; i < TChannelCount; i++) {
+			float in = input[i];
+			float result = in * a0[i] + z1[i];
+			z1[i] = in * a1[i] + z2[i] - b1[i] * result;
+			z2[i] = in * a2[i] - b2[i] * result;
+			output[i] = result;
+		}
+	}
+
+private:
+	float a0[TChannelCount];
+	float a1[TChannelCount];
+	float a2[TChannelCount];
+	float b1[TChannelCount];
+	float b2[TChannelCount];
+	float z1[TChannelCount];
+	float z2[TChannelCount];
+};
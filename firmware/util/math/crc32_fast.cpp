@@ -0,0 +1,161 @@
+/**
+ * @file    crc32_fast.cpp
+ *
+ * Reflected CRC32, polynomial 0xEDB88320, same as zlib and crc32()
+ */
+
+#include "pch.h"
+
+#include "crc32_fast.h"
+
+#ifndef EFI_CRC32_HW
+#if EFI_PROD_CODE && (defined(STM32F7XX) || defined(STM32H7XX)) && defined(rccEnableCRC)
+// F4 CRC unit can't reflect input or output nor take an initial value, not worth it there
+#define EFI_CRC32_HW TRUE
+#else
+#define EFI_CRC32_HW FALSE
+#endif
+#endif
+
+#define CRC32_POLY_REFLECTED 0xEDB88320
+
+struct Crc32Tables {
+	uint32_t t[8][256];
+};
+
+static constexpr Crc32Tables makeCrc32Tables() {
+	Crc32Tables tables{};
+
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLY_REFLECTED : 0);
+		}
+		tables.t[0][i] = crc;
+	}
+
+	// t[k][i] is the CRC of byte i followed by k zero bytes
+	for (int k = 1; k < 8; k++) {
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t previous = tables.t[k - 1][i];
+			tables.t[k][i] = (previous >> 8) ^ tables.t[0][previous & 0xFF];
+		}
+	}
+
+	return tables;
+}
+
+// generated at compile time, lives in flash
+static constexpr Crc32Tables crcTables = makeCrc32Tables();
+
+static uint32_t bytewiseUpdate(uint32_t state, const uint8_t *data, size_t size) {
+	while (size--) {
+		state = (state >> 8) ^ crcTables.t[0][(state ^ *data++) & 0xFF];
+	}
+	return state;
+}
+
+static uint32_t load32(const uint8_t *data) {
+	// little endian, alignment agnostic - compiles to a single load where unaligned access is fine
+	uint32_t value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static uint32_t slice8Update(uint32_t state, const uint8_t *data, size_t size) {
+	while (size >= 8) {
+		uint32_t low = load32(data) ^ state;
+		uint32_t high = load32(data + 4);
+
+		state = crcTables.t[7][low & 0xFF]
+			^ crcTables.t[6][(low >> 8) & 0xFF]
+			^ crcTables.t[5][(low >> 16) & 0xFF]
+			^ crcTables.t[4][low >> 24]
+			^ crcTables.t[3][high & 0xFF]
+			^ crcTables.t[2][(high >> 8) & 0xFF]
+			^ crcTables.t[1][(high >> 16) & 0xFF]
+			^ crcTables.t[0][high >> 24];
+
+		data += 8;
+		size -= 8;
+	}
+
+	return bytewiseUpdate(state, data, size);
+}
+
+uint32_t crc32SoftwareInc(const void *buf, uint32_t previous, size_t size) {
+	return ~slice8Update(~previous, reinterpret_cast<const uint8_t*>(buf), size);
+}
+
+uint32_t crc32BytewiseInc(const void *buf, uint32_t previous, size_t size) {
+	return ~bytewiseUpdate(~previous, reinterpret_cast<const uint8_t*>(buf), size);
+}
+
+#if EFI_CRC32_HW
+
+// how many words we feed the peripheral without letting anybody else in
+#define CRC32_HW_CHUNK_WORDS 64
+
+static bool isCrcClockEnabled = false;
+
+/**
+ * Peripheral works MSB first, with input reversed per word and output reversed it is our reflected CRC.
+ * Its state register is not readable, but reversed INIT value is exactly where we left off,
+ * so every chunk resumes from the previous one and nobody owns the peripheral for long.
+ */
+static uint32_t hardwareUpdate(uint32_t state, const uint8_t *data, size_t wordCount) {
+	while (wordCount > 0) {
+		size_t chunk = wordCount > CRC32_HW_CHUNK_WORDS ? CRC32_HW_CHUNK_WORDS : wordCount;
+
+		{
+			chibios_rt::CriticalSectionLocker csl;
+
+			if (!isCrcClockEnabled) {
+				rccEnableCRC(true);
+				isCrcClockEnabled = true;
+			}
+
+			CRC->INIT = __RBIT(state);
+			CRC->CR = CRC_CR_REV_IN | CRC_CR_REV_OUT | CRC_CR_RESET;
+
+			for (size_t i = 0; i < chunk; i++) {
+				CRC->DR = load32(data);
+				data += 4;
+			}
+
+			state = CRC->DR;
+		}
+
+		wordCount -= chunk;
+	}
+
+	return state;
+}
+
+uint32_t crc32FastInc(const void *buf, uint32_t previous, size_t size) {
+	const uint8_t *data = reinterpret_cast<const uint8_t*>(buf);
+	uint32_t state = ~previous;
+
+	// not worth the setup for tiny buffers like the response code
+	if (size >= 4 * sizeof(uint32_t)) {
+		size_t head = (4 - ((uintptr_t)data & 3)) & 3;
+		state = bytewiseUpdate(state, data, head);
+		data += head;
+		size -= head;
+
+		size_t wordCount = size / 4;
+		state = hardwareUpdate(state, data, wordCount);
+		data += wordCount * 4;
+		size -= wordCount * 4;
+	}
+
+	return ~bytewiseUpdate(state, data, size);
+}
+
+#else
+
+uint32_t crc32FastInc(const void *buf, uint32_t previous, size_t size) {
+	return crc32SoftwareInc(buf, previous, size);
+}
+
+#endif // EFI_CRC32_HW
@@ -0,0 +1,32 @@
+/**
+ * @file    crc32_fast.h
+ *
+ * CRC32 for the hot TS paths: response framing, scattered reads and full page CRC on connect.
+ * Same polynomial and same results as crc32/crc32inc, only faster:
+ *  - STM32F7/H7 feed the CRC peripheral a word at a time
+ *  - everybody else, including simulator and unit tests, use slice-by-8 tables
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Drop-in replacement for crc32inc: previous is the CRC of everything before buf
+ */
+uint32_t crc32FastInc(const void *buf, uint32_t previous, size_t size);
+
+inline uint32_t crc32Fast(const void *buf, size_t size) {
+	return crc32FastInc(buf, 0, size);
+}
+
+/**
+ * Table implementation only, regardless of hardware support
+ */
+uint32_t crc32SoftwareInc(const void *buf, uint32_t previous, size_t size);
+
+/**
+ * Classic one byte at a time reference, only useful for tests and benchmarks
+ */
+uint32_t crc32BytewiseInc(const void *buf, uint32_t previous, size_t size);
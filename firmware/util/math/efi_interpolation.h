@@ -51,7 +51,8 @@ void ensureArrayIsAscendingOrDefault(const char* msg, const TValue (&values)[TSi
  * @returns	the highest index within sorted array such that array[i] is greater than or equal to the parameter
  * @note If the parameter is smaller than the first element of the array, -1 is returned.
  *
- * See also ensureArrayIsAscending
+ * Array order is not validated here, see ensureArrayIsAscending which runs when configuration is loaded or burnt
+ * See also findIndexMsg overload for arrays with size known at compile time
  */
 template<typename kType>
 int findIndexMsg(const char *msg, const kType array[], int size, kType value) {
@@ -68,33 +69,12 @@ int findIndexMsg(const char *msg, const kType array[], int size, kType value) {
 	int left = 0;
 	int right = size;
 
-	// todo: extract binary search as template method?
 	while (true) {
-#if 0
-		// that's an assertion to make sure we do not loop here
-		size--;
-		efiAssert(ObdCode::CUSTOM_ERR_ASSERT, size > 0, "Unexpected state in binary search", 0);
-#endif
-
-		// todo: compare current implementation with
-		// http://eigenjoy.com/2011/01/21/worlds-fastest-binary-search/
-		// ?
 		middle = (left + right) / 2;
 
-//		print("left=%d middle=%d right=%d: %.2f\r\n", left, middle, right, array[middle]);
-
 		if (middle == left)
 			break;
 
-		if (middle != 0 && array[middle - 1] > array[middle]) {
-#if EFI_UNIT_TEST
-			firmwareError(ObdCode::CUSTOM_ERR_6610, "%s: out of order %.2f %.2f", msg, array[middle - 1], array[middle]);
-#else
-			warning(ObdCode::CUSTOM_ERR_OUT_OF_ORDER, "%s: out of order %.2f %.2f", msg, array[middle - 1], array[middle]);
-
-#endif /* EFI_UNIT_TEST */
-		}
-
 		if (value < array[middle]) {
 			right = middle;
 		} else if (value > array[middle]) {
@@ -107,6 +87,28 @@ int findIndexMsg(const char *msg, const kType array[], int size, kType value) {
 	return middle;
 }
 
+/** @brief	Branchless search for axis with size known at compile time
+ * Our axes are small (8, 16 or 24 bins) so instead of binary search with hard to predict branches
+ * we just count bins which are below or equal to the value. Loop has a fixed trip count so compiler
+ * unrolls it on target and vectorizes it on host.
+ * @returns	same as findIndexMsg above for ascending arrays
+ */
+template<typename kType, int TSize>
+int findIndexMsg(const char *msg, const kType (&array)[TSize], kType value) {
+	float fvalue = (float)value;
+	if (std::isnan(fvalue)) {
+		firmwareError(ObdCode::ERROR_NAN_FIND_INDEX, "NaN in findIndex%s", msg);
+		return 0;
+	}
+
+	int count = 0;
+	for (int i = 0; i < TSize; i++) {
+		count += array[i] <= value;
+	}
+
+	return count - 1;
+}
+
 /**
  * Sets specified value for specified key in a correction curve
  * see also setLinearCurve()
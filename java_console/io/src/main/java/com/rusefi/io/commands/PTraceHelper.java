@@ -5,11 +5,14 @@ import com.rusefi.config.generated.Integration;
 import com.rusefi.tracing.Entry;
 import org.jetbrains.annotations.NotNull;
 
+import java.io.ByteArrayOutputStream;
 import java.util.List;
 
 import static com.rusefi.binaryprotocol.IoHelper.checkResponseCode;
 
 public class PTraceHelper {
+    private static final int STREAM_POLL_MS = 20;
+
     @NotNull
     public static List<Entry> requestWaitAndGetPTrace(BinaryProtocol bp) {
         bp.executeCommand(Integration.TS_PERF_TRACE_BEGIN, "begin trace");
@@ -22,6 +25,41 @@ public class PTraceHelper {
         return executeGetPTraceCommand(bp);
     }
 
+    /**
+     * Same records but read from the firmware ring while it keeps tracing, so not limited to one buffer worth.
+     * Timestamps are raw cycle counts so keep it shorter than the counter wraps around.
+     */
+    @NotNull
+    public static List<Entry> requestStreamedPTrace(BinaryProtocol bp, int durationMs) {
+        executeStreamCommand(bp, Integration.TS_PERF_TRACE_STREAM_START, "start trace stream");
+
+        ByteArrayOutputStream records = new ByteArrayOutputStream();
+        // parseBuffer skips the response code
+        records.write(Integration.TS_RESPONSE_OK);
+        try {
+            long end = System.currentTimeMillis() + durationMs;
+            while (System.currentTimeMillis() < end) {
+                byte[] packet = executeStreamCommand(bp, Integration.TS_PERF_TRACE_STREAM_READ, "read trace stream");
+                records.write(packet, 1, packet.length - 1);
+                Thread.sleep(STREAM_POLL_MS);
+            }
+        } catch (InterruptedException e) {
+            throw new IllegalStateException(e);
+        } finally {
+            executeStreamCommand(bp, Integration.TS_PERF_TRACE_STREAM_STOP, "stop trace stream");
+        }
+
+        return Entry.parseBuffer(records.toByteArray());
+    }
+
+    @NotNull
+    private static byte[] executeStreamCommand(BinaryProtocol bp, int subCommand, String msg) {
+        byte[] packet = bp.executeCommand(Integration.TS_PERF_TRACE_STREAM, new byte[]{(byte) subCommand}, msg);
+        if (!checkResponseCode(packet, (byte) Integration.TS_RESPONSE_OK) || ((packet.length - 1) % 8) != 0)
+            throw new IllegalStateException("Unsupported command or error? " + msg);
+        return packet;
+    }
+
     @NotNull
     private static List<Entry> executeGetPTraceCommand(BinaryProtocol bp) {
         byte[] packet = bp.executeCommand(Integration.TS_PERF_TRACE_GET_BUFFER, "get trace");
@@ -8,6 +8,8 @@ import java.io.*;
 import java.util.ArrayList;
 import java.util.Date;
 import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
 
 /**
  * This tool generates C# or Java class based on enum values from C/C++ header related to rusEfi own Perf Trace
@@ -24,6 +26,8 @@ import java.util.List;
 public class PerfTraceEnumGenerator {
     private static final String ENUM_START_TAG = "enum_start_tag";
     private static final String ENUM_END_TAG = "enum_end_tag";
+    // one "PE_EVENT(Name) \\" line per value of PERF_TRACE_EVENTS
+    private static final Pattern EVENT = Pattern.compile("PE_EVENT\\((\\w+)\\)");
 
     public static void main(String[] args) throws IOException {
         if (args.length != 2) {
@@ -81,10 +85,9 @@ public class PerfTraceEnumGenerator {
             if (!weAreInBusiness)
                 continue;
 
-            line = line.trim().replaceAll("\\s", "");
-
-            if (line.endsWith(",")) {
-                result.add(line.substring(0, line.length() - 1));
+            Matcher matcher = EVENT.matcher(line);
+            if (matcher.find()) {
+                result.add(matcher.group(1));
             }
 
 
@@ -1290,7 +1290,7 @@ public class VariableRegistryValues {
 	public static final int SentInput_INPUT6 = 6;
 	public static final int SentInput_INPUT7 = 7;
 	public static final int SentInput_NONE = 0;
-	public static final int SIGNATURE_HASH = 698864858;
+	public static final int SIGNATURE_HASH = 1544546480;
 	public static final String SIMULATOR_TUNE_BIN_FILE_NAME = "generated/simulator_tune_image.bin";
 	public static final String SIMULATOR_TUNE_BIN_FILE_NAME_PREFIX = "generated/simulator_tune_image";
 	public static final String SIMULATOR_TUNE_BIN_FILE_NAME_SUFFIX = ".bin";
@@ -1528,6 +1528,7 @@ public class VariableRegistryValues {
 	public static final int TS_COMPOSITE_ENABLE = 1;
 	public static final int TS_COMPOSITE_READ = 3;
 	public static final char TS_CRC_CHECK_COMMAND = 'k';
+	public static final char TS_EVENT_TIMING_COMMAND = 'J';
 	public static final char TS_EXECUTE = 'E';
 	public static final char TS_GET_COMPOSITE_BUFFER_DONE_DIFFERENTLY = '8';
 	public static final char TS_GET_CONFIG_ERROR = 'e';
@@ -1541,8 +1542,14 @@ public class VariableRegistryValues {
 	public static final char TS_ONLINE_PROTOCOL = 'z';
 	public static final char TS_OUTPUT_ALL_COMMAND = 'A';
 	public static final char TS_OUTPUT_COMMAND = 'O';
+	public static final char TS_OUTPUT_DELTA_COMMAND = 'D';
+	public static final char TS_OUTPUT_SUBSCRIBE_COMMAND = 'P';
 	public static final char TS_PERF_TRACE_BEGIN = '_';
 	public static final char TS_PERF_TRACE_GET_BUFFER = 'b';
+	public static final char TS_PERF_TRACE_STREAM = 'y';
+	public static final int TS_PERF_TRACE_STREAM_READ = 3;
+	public static final int TS_PERF_TRACE_STREAM_START = 1;
+	public static final int TS_PERF_TRACE_STREAM_STOP = 2;
 	public static final String TS_PROTOCOL = "001";
 	public static final char TS_QUERY_BOOTLOADER = 'L';
 	public static final int TS_QUERY_BOOTLOADER_NONE = 0;
@@ -1553,12 +1560,13 @@ public class VariableRegistryValues {
 	public static final int TS_RESPONSE_CRC_FAILURE = 0x82;
 	public static final int TS_RESPONSE_FRAMING_ERROR = 0x8D;
 	public static final int TS_RESPONSE_OK = 0;
+	public static final int TS_RESPONSE_OUTPUT_PUSH = 1;
 	public static final int TS_RESPONSE_OUT_OF_RANGE = 0x84;
 	public static final int TS_RESPONSE_OVERRUN = 0x81;
 	public static final int TS_RESPONSE_UNDERRUN = 0x80;
 	public static final int TS_RESPONSE_UNRECOGNIZED_COMMAND = 0x83;
 	public static final char TS_SET_LOGGER_SWITCH = 'l';
-	public static final String TS_SIGNATURE = "rusEFI master.2025.02.22.f407-discovery.698864858";
+	public static final String TS_SIGNATURE = "rusEFI master.2025.02.22.f407-discovery.1544546480";
 	public static final char TS_SIMULATE_CAN = '>';
 	public static final char TS_SINGLE_WRITE_COMMAND = 'W';
 	public static final char TS_TEST_COMMAND = 't';
@@ -99,6 +99,31 @@ public class SdCardFieldsGeneratorTest {
                 }, true);
     }
 
+    @Test
+    public void logRateClass() {
+        processAndAssert("struct_no_prefix output_channels_s\n" +
+                        "    struct pid_status_s\n" +
+                        "    \tfloat pTerm;;\"\", 1, 0, -50000, 50000, 2\n" +
+                        "    end_struct\n" +
+                        "bit log_slow sd_present;SD: Present\n" +
+                        "bit sd_logging_internal\n" +
+                        "uint16_t autoscale log_medium RPMValue;feee;\"RPM\",1, 0, 0, 8000, 2, \"myCategory\"\n" +
+                        "uint16_t[2 iterate] log_slow recentErrorCode;;\"error\", 1, 0, 0, 0, 0\n" +
+                        "\tpid_status_s log_medium alternatorStatus\n" +
+                        "\tpid_status_s etbStatus\n" +
+                        "end_struct",
+                "\t{test->reference, 0, 0, \"SD: Present\", \"\", \"none\", LogRateClass::Slow},\n" +
+                "\t{test->reference, 0, 1, \"sd_logging_internal\", \"\"},\n" +
+                "\t{test->reference.RPMValue, \"feee\", \"RPM\", 2, \"myCategory\", LogRateClass::Medium},\n" +
+                "\t{test->reference.recentErrorCode[0], \"recentErrorCode 1\", \"error\", 0, \"none\", LogRateClass::Slow},\n" +
+                "\t{test->reference.recentErrorCode[1], \"recentErrorCode 2\", \"error\", 0, \"none\", LogRateClass::Slow},\n" +
+                "\t{test->reference.alternatorStatus.pTerm, \"alternatorStatus.pTerm\", \"\", 2, \"none\", LogRateClass::Medium},\n" +
+                "\t{test->reference.etbStatus.pTerm, \"etbStatus.pTerm\", \"\", 2},\n",
+                readerState -> {
+
+                }, false);
+    }
+
     @Test
     public void enumField() {
         processAndAssert("struct_no_prefix output_channels_s\n" +
@@ -132,6 +132,11 @@ public interface ConfigField {
             return "";
         }
 
+        @Override
+        public String getLogRateClass() {
+            return null;
+        }
+
         @Override
         public int getDigits() {
             return 0;
@@ -222,6 +227,11 @@ public interface ConfigField {
 
     String getCategory();
 
+    /**
+     * SD card log rate class, 'Slow' for a 'log_slow' name modifier, null if not specified
+     */
+    String getLogRateClass();
+
     String getIterateOriginalName();
 
     int getIterateIndex();
@@ -40,6 +40,7 @@ public class ConfigFieldImpl implements ConfigField {
     public static final String VOID_NAME = "";
     public static final String BOOLEAN_T = "boolean";
     public static final String DIRECTIVE_T = "directive";
+    public static final String LOG_RATE_PREFIX = "log_";
 
     private final String name;
     private final String comment;
@@ -55,6 +56,7 @@ public class ConfigFieldImpl implements ConfigField {
     private final String falseName;
     private final ConfigStructure parentType;
     private boolean isFromIterate;
+    private String logRateClass;
     private String iterateOriginalName;
     private int iterateIndex;
 
@@ -178,6 +180,7 @@ public class ConfigFieldImpl implements ConfigField {
         String name = nameTokens[nameTokens.length - 1];
 
         boolean hasAutoscale = isHasAutoscale(nameTokens);
+        String logRateClass = getLogRateClass(nameTokens);
 
         String comment = matcher.group(10);
         validateComment(comment);
@@ -204,6 +207,7 @@ public class ConfigFieldImpl implements ConfigField {
 
         ConfigFieldImpl field = new ConfigFieldImpl(state, name, comment, arraySizeAsText, type, arraySizes,
                 tsInfo, isIterate, hasAutoscale, null, null);
+        field.setLogRateClass(logRateClass);
         if (log.debugEnabled())
             log.debug("type " + type);
         if (log.debugEnabled())
@@ -225,6 +229,20 @@ public class ConfigFieldImpl implements ConfigField {
         return hasAutoscale;
     }
 
+    /**
+     * 'log_slow' name modifier turns into 'Slow', see LogRateClass
+     * @param nameTokens modifiers followed by the name itself
+     */
+    public static String getLogRateClass(String[] nameTokens) {
+        for (int i = 0; i < nameTokens.length - 1; i++) {
+            String token = nameTokens[i];
+            if (token.startsWith(LOG_RATE_PREFIX) && token.length() > LOG_RATE_PREFIX.length()) {
+                return Character.toUpperCase(token.charAt(LOG_RATE_PREFIX.length())) + token.substring(LOG_RATE_PREFIX.length() + 1);
+            }
+        }
+        return null;
+    }
+
     private static void validateComment(String comment) {
         if (comment == null)
             return;
@@ -435,6 +453,15 @@ public class ConfigFieldImpl implements ConfigField {
         return VariableRegistry.unquote(token);
     }
 
+    @Override
+    public String getLogRateClass() {
+        return logRateClass;
+    }
+
+    public void setLogRateClass(String logRateClass) {
+        this.logRateClass = logRateClass;
+    }
+
     public void setFromIterate(String iterateOriginalName, int iterateIndex) {
         this.iterateOriginalName = iterateOriginalName;
         this.iterateIndex = iterateIndex;
@@ -90,6 +90,8 @@ public class ReaderStateImpl implements ReaderState {
             comment = line.substring(index + 1);
         }
         String[] bitNameParts = bitName.split(",");
+        // optional modifiers before the name, same as for other fields
+        String[] bitNameTokens = bitNameParts[0].trim().split("\\s+");
 
         if (log.debugEnabled())
             log.debug("Need to align before bit " + bitName);
@@ -98,7 +100,8 @@ public class ReaderStateImpl implements ReaderState {
         String trueName = bitNameParts.length > 1 ? bitNameParts[1].replaceAll("\"", "") : null;
         String falseName = bitNameParts.length > 2 ? bitNameParts[2].replaceAll("\"", "") : null;
 
-        ConfigFieldImpl bitField = new ConfigFieldImpl(state, bitNameParts[0], comment, null, BOOLEAN_T, new int[0], null, false, false, trueName, falseName);
+        ConfigFieldImpl bitField = new ConfigFieldImpl(state, bitNameTokens[bitNameTokens.length - 1], comment, null, BOOLEAN_T, new int[0], null, false, false, trueName, falseName);
+        bitField.setLogRateClass(ConfigFieldImpl.getLogRateClass(bitNameTokens));
         if (state.isStackEmpty())
             throw new IllegalStateException("Parent structure expected");
         ConfigStructureImpl structure = state.stack.peek();
@@ -370,6 +373,7 @@ public class ReaderStateImpl implements ReaderState {
                 ConfigFieldImpl element = new ConfigFieldImpl(state, cf.getName() + i, commentWithIndex, null,
                         cf.getTypeName(), new int[0], cf.getTsInfo(), false, cf.isHasAutoscale(), null, null);
                 element.setFromIterate(cf.getName(), i);
+                element.setLogRateClass(cf.getLogRateClass());
                 structure.addTs(element);
             }
         } else if (cf.isDirective()) {
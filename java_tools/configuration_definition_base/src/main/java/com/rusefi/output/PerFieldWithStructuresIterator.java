@@ -14,14 +14,21 @@ class PerFieldWithStructuresIterator extends FieldIterator {
     private final String variableNamePrefix;
     private final Strategy strategy;
     private final String prefixSeparator;
+    // log rate class of the structure field we are iterating, if any
+    private final String parentLogRateClass;
     private final StringBuilder sb = new StringBuilder();
 
     public PerFieldWithStructuresIterator(ReaderState state, List<ConfigField> fields, String variableNamePrefix, Strategy strategy, String prefixSeparator) {
+        this(state, fields, variableNamePrefix, strategy, prefixSeparator, null);
+    }
+
+    private PerFieldWithStructuresIterator(ReaderState state, List<ConfigField> fields, String variableNamePrefix, Strategy strategy, String prefixSeparator, String parentLogRateClass) {
         super(fields);
         this.state = state;
         this.variableNamePrefix = variableNamePrefix;
         this.strategy = strategy;
         this.prefixSeparator = prefixSeparator;
+        this.parentLogRateClass = parentLogRateClass;
     }
 
     public PerFieldWithStructuresIterator(ReaderState state, List<ConfigField> fields, String variableNamePrefix, Strategy strategy) {
@@ -39,7 +46,8 @@ class PerFieldWithStructuresIterator extends FieldIterator {
             } else {
                 // java side of things does not care for 'cs.withPrefix'
                 String extraPrefix = variableNamePrefix + strategy.getArrayElementName(cf) + prefixSeparator;
-                PerFieldWithStructuresIterator fieldIterator = new PerFieldWithStructuresIterator(state, cs.getTsFields(), extraPrefix, strategy, prefixSeparator);
+                String logRateClass = cf.getLogRateClass() != null ? cf.getLogRateClass() : parentLogRateClass;
+                PerFieldWithStructuresIterator fieldIterator = new PerFieldWithStructuresIterator(state, cs.getTsFields(), extraPrefix, strategy, prefixSeparator, logRateClass);
                 fieldIterator.loop(currentPosition);
                 content = fieldIterator.sb.toString();
             }
@@ -50,6 +58,13 @@ class PerFieldWithStructuresIterator extends FieldIterator {
         super.end(currentPosition);
     }
 
+    /**
+     * @return log rate class of the field unless specified, inherited from structure fields it is nested in
+     */
+    public String getLogRateClass(ConfigField field) {
+        return field.getLogRateClass() != null ? field.getLogRateClass() : parentLogRateClass;
+    }
+
     public String getContent() {
         return sb.toString();
     }
@@ -28,7 +28,7 @@ public class SdCardFieldsContent {
         output.write("// generated by " + SdCardFieldsContent.class + "\n");
         output.write(BOARD_LOOKUP_H);
         output.write("static const LogField fields[] = {\n" +
-                "{packedTime, GAUGE_NAME_TIME, \"sec\", 0},\n");
+                "{packedTime, GAUGE_NAME_TIME, \"sec\", 0, \"none\", LogRateClass::Ignore},\n");
         output.write(content);
         output.write("};\n");
     }
@@ -75,12 +75,17 @@ public class SdCardFieldsContent {
         String humanName = DataLogConsumer.getHumanGaugeName(outputNamePrefix, prefix, configField, "");
 
         String categoryStr = configField.getCategory();
+        String logRateClass = perFieldWithStructuresIterator.getLogRateClass(configField);
 
         if (categoryStr == null) {
-            categoryStr = "";
+            // category is positional, rate class comes after it
+            categoryStr = logRateClass == null ? "" : ", " + quote("none");
         } else {
             categoryStr = ", " + categoryStr;
         }
+        if (logRateClass != null) {
+            categoryStr += ", LogRateClass::" + logRateClass;
+        }
 
         boolean isEnum = configField.getTypeName().contains("_e");
         if (isEnum)
@@ -152,7 +152,7 @@ public class LiveDataProcessorTest {
         captor.assertOutput("// generated by class com.rusefi.output.SdCardFieldsContent\n" +
                 "#include \"board_lookup.h\"\n" +
                 "static const LogField fields[] = {\n" +
-                "{packedTime, GAUGE_NAME_TIME, \"sec\", 0},\n" +
+                "{packedTime, GAUGE_NAME_TIME, \"sec\", 0, \"none\", LogRateClass::Ignore},\n" +
                 "\t{engine->wbo1.tempC, \"wb1WBO: Temperature\", \"C\", 0, \"cate\"},\n" +
                 "\t{engine->wbo1, 4, 0, \"wb1bitName1\", \"\"},\n" +
                 "\t{engine->wbo1, 4, 1, \"wb1bitName2\", \"\"},\n" +
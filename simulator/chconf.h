@@ -723,12 +723,18 @@
   /* Idle-leave code here.*/                                                \
 }
 
+#ifdef __cplusplus
+extern "C"
+#endif
+void onSimulatorIdle(void);
+
 /**
  * @brief   Idle Loop hook.
  * @details This hook is continuously invoked by the idle thread loop.
  */
 #define CH_CFG_IDLE_LOOP_HOOK() {                                           \
-  /* Idle loop code here.*/                                                 \
+  /* fast mode moves its clock from here, see sim_time.cpp */              \
+  onSimulatorIdle();                                                        \
 }
 
 /**
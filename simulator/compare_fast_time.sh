@@ -0,0 +1,34 @@
+#!/bin/bash
+
+# Runs the simulator headless in real time and in fast mode, both have to end up in the same state:
+# same trigger synchronizations and errors, RPM within RPM_TOLERANCE since real time can jitter a bit
+set -e
+SECONDS_TO_RUN=${1:-10}
+RPM_TOLERANCE=${2:-10}
+
+./build/rusefi_simulator $SECONDS_TO_RUN > build/real_time.log
+./build/rusefi_simulator $SECONDS_TO_RUN --fast > build/fast_time.log
+
+grep "^Simulated " build/real_time.log build/fast_time.log
+REAL_TIME=$(grep "^Exit state: " build/real_time.log)
+FAST_TIME=$(grep "^Exit state: " build/fast_time.log)
+echo "real time: $REAL_TIME"
+echo "fast time: $FAST_TIME"
+
+# Exit state: time <us> us, synchronizations <n>, trigger errors <n>, RPM <n>
+field() {
+	echo "$1" | sed -n "s/.*$2 \([0-9-]*\).*/\1/p"
+}
+
+for NAME in "synchronizations" "trigger errors"; do
+	if [ "$(field "$REAL_TIME" "$NAME")" != "$(field "$FAST_TIME" "$NAME")" ]; then
+		echo "Fast mode $NAME do not match real time"
+		exit 1
+	fi
+done
+
+RPM_DIFFERENCE=$(( $(field "$REAL_TIME" "RPM") - $(field "$FAST_TIME" "RPM") ))
+if [ ${RPM_DIFFERENCE#-} -gt $RPM_TOLERANCE ]; then
+	echo "Fast mode RPM is $RPM_DIFFERENCE off real time"
+	exit 1
+fi
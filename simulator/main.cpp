@@ -18,7 +18,9 @@
 #include "chprintf.h"
 #include "rusEfiFunctionalTest.h"
 #include "flash_int.h"
+#include "sim_time.h"
 
+#include <chrono>
 #include <iostream>
 #include <filesystem>
 #include <fstream>
@@ -137,12 +139,50 @@ bool verboseMode = true;
 
 static virtual_timer_t exitTimer;
 
+static std::chrono::steady_clock::time_point startTime;
+static int timeoutSeconds;
+static efitimeus_t startTimeUs;
+
+static void onExitTimer(void*) {
+	int elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+	printf("Simulated %d seconds in %.1f seconds\n", timeoutSeconds, elapsedMs / 1000.0);
+	// same in real time and fast mode, see compare_fast_time.sh
+	printf("Exit state: time %d us, synchronizations %d, trigger errors %d, RPM %d\n",
+		(int)(getTimeNowUs() - startTimeUs),
+		engine->triggerCentral.triggerState.getSynchronizationCounter(),
+		(int)engine->triggerCentral.triggerState.totalTriggerErrorCounter,
+		(int)Sensor::getOrZero(SensorType::Rpm));
+	exit(0);
+}
+
 /*------------------------------------------------------------------------*
  * Simulator main.                                                        *
  *------------------------------------------------------------------------*/
 int main(int argc, char** argv) {
 	setbuf(stdout, NULL);
 
+	bool fastTime = false;
+	const char *timeoutArg = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--fast") == 0) {
+			fastTime = true;
+		} else {
+			timeoutArg = argv[i];
+		}
+	}
+
+	if (fastTime) {
+		if (timeoutArg == nullptr) {
+			printf("--fast needs a timeout, nothing would ever stop the simulator\n");
+			return -1;
+		}
+		if (!enableSimulatorFastTime()) {
+			printf("--fast is not supported on this platform\n");
+			return -1;
+		}
+	}
+	startTime = std::chrono::steady_clock::now();
+
 	/*
 	 * System initializations.
 	 * - HAL initialization, this also initializes the configured device drivers
@@ -153,12 +193,13 @@ int main(int argc, char** argv) {
 	halInit();
 	chSysInit();
 
-	if (argc == 2) {
-		int timeoutSeconds = atoi(argv[1]);
-		printf("Running rusEFI simulator for %d seconds, then exiting.\n\n", timeoutSeconds);
+	if (timeoutArg != nullptr) {
+		timeoutSeconds = atoi(timeoutArg);
+		printf("Running rusEFI simulator for %d %sseconds, then exiting.\n\n", timeoutSeconds, fastTime ? "simulated " : "");
 
 		chSysLock();
-		chVTSetI(&exitTimer, MY_US2ST(timeoutSeconds * 1e6), [](void*) { exit(0); }, nullptr);
+		startTimeUs = getTimeNowUs();
+		chVTSetI(&exitTimer, MY_US2ST(timeoutSeconds * 1e6), onExitTimer, nullptr);
 		chSysUnlock();
 	}
 
@@ -33,6 +33,11 @@
 #define EFI_ETHERNET FALSE
 #define EFI_POTENTIOMETER FALSE
 #define EFI_PERF_METRICS FALSE
+#define EFI_MODULE_PROFILER TRUE
+// simulator does not use EventQueue
+#define EFI_EVENT_TIMING_STATS FALSE
+#define EFI_PWM_GROUP TRUE
+#define EFI_INCREMENTAL_ENGINE_STATE TRUE
 #define EFI_WIFI FALSE
 #define EFI_BACKUP_SRAM FALSE
 #define EFI_UART_GPS FALSE
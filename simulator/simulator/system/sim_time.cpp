@@ -0,0 +1,69 @@
+/**
+ * @file	sim_time.cpp
+ *
+ * ChibiOS posix port ticks from its idle path, each time comparing the clock against the time of
+ * the next tick. Fast mode hands the port a virtual clock which only moves in the idle loop hook, one
+ * system tick per pass: the idle thread only runs once all threads wait, so time moves on as soon as
+ * nothing else has to happen, and the port then ticks the usual way. Everything still happens at the
+ * same system tick as in real time.
+ *
+ * Only the port reads the virtual clock, hal_lld.c is built with gettimeofday() renamed to
+ * simPortGetTimeOfDay(), see Makefile
+ */
+
+#include "pch.h"
+#include "sim_time.h"
+
+#if EFI_SIM_FAST_TIME
+
+#include <sys/time.h>
+
+// only written before halInit(), when there is just the one thread
+static bool isFastTime = false;
+// idle thread is both the only writer and the only reader
+static struct timeval virtualTime;
+
+extern "C" int simPortGetTimeOfDay(struct timeval *tv, void *tz) {
+	if (!isFastTime) {
+		return gettimeofday(tv, tz);
+	}
+
+	*tv = virtualTime;
+	return 0;
+}
+
+void onSimulatorIdle() {
+	if (!isFastTime) {
+		return;
+	}
+
+	// the tick is periodic, so the port finds exactly one more tick due
+	static const struct timeval tick = { 0, 1000000 / CH_CFG_ST_FREQUENCY };
+	timeradd(&virtualTime, &tick, &virtualTime);
+}
+
+bool enableSimulatorFastTime() {
+	isFastTime = true;
+	// start where real time is, same as real time mode would
+	gettimeofday(&virtualTime, nullptr);
+	return true;
+}
+
+bool isSimulatorFastTime() {
+	return isFastTime;
+}
+
+#else // EFI_SIM_FAST_TIME
+
+void onSimulatorIdle() {
+}
+
+bool enableSimulatorFastTime() {
+	return false;
+}
+
+bool isSimulatorFastTime() {
+	return false;
+}
+
+#endif // EFI_SIM_FAST_TIME
@@ -0,0 +1,15 @@
+/*
+ * @file    sim_time.h
+ *
+ * Accelerated time for headless simulator runs, see sim_time.cpp
+ */
+
+#pragma once
+
+/**
+ * Has to be called before halInit(), that is when ChibiOS reads the clock for the first time
+ * @return false if this build can not run in fast mode
+ */
+bool enableSimulatorFastTime();
+
+bool isSimulatorFastTime();
@@ -32,7 +32,19 @@
 
 #define EFI_PRINTF_FUEL_DETAILS TRUE
 
+// perf_trace.cpp alone is built with it, see Makefile
+#ifndef ENABLE_PERF_TRACE
 #define ENABLE_PERF_TRACE FALSE
+#endif
+
+#define EFI_MODULE_PROFILER TRUE
+
+#define EFI_EVENT_TIMING_STATS TRUE
+
+// off same as on hardware, PwmGroup has tests of its own
+#define EFI_PWM_GROUP FALSE
+// tests write the tune directly, see isStale()
+#define EFI_INCREMENTAL_ENGINE_STATE FALSE
 
 #define EFI_TOOTH_LOGGER TRUE
 
@@ -8,10 +8,22 @@
 
 #include "pch.h"
 #include <stdlib.h>
+#include "trigger_log_replay.h"
+#include "shard_runner.h"
 
 bool hasInitGtest = false;
 
 GTEST_API_ int main(int argc, char **argv) {
+	if (argc > 1 && strcmp(argv[1], "--replay") == 0) {
+		// offline trigger capture replay, no gtest and no test_results files
+		return runTriggerLogReplayTool(argc - 2, argv + 2);
+	}
+
+	if (isShardedRun(argc, argv)) {
+		// every shard in a child process of its own, see shard_runner.h
+		return runShardedTests(argc, argv);
+	}
+
 	hasInitGtest = true;
 
 	testing::InitGoogleTest(&argc, argv);
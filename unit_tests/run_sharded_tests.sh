@@ -1,16 +1,12 @@
 #!/bin/bash
 
-# This script runs every test in its own process (own invocation of rusefi_test executable)
+# This script runs every test in its own process (own child process of rusefi_test executable)
 # This allows us to test for accidental cross-test leakage that fixes/breaks something
+#
+# Tests run in parallel on all cores, see test-framework/shard_runner.h
+# Use '--shards=600 --exec' instead of '--fork-per-test' for a fresh rusefi_test invocation per shard
+# Any other arguments, like --gtest_filter, are passed on
 
 set -e
 
-export GTEST_TOTAL_SHARDS=600
-for IDX in {0..599}
-do
-	export GTEST_SHARD_INDEX=$IDX
-	build/rusefi_test
-done
-
-unset GTEST_TOTAL_SHARDS
-unset GTEST_SHARD_INDEX
+build/rusefi_test --fork-per-test --shard-timeout=300 --report=test_results/sharded_tests.xml "$@"
@@ -16,6 +16,7 @@
 #include "logicdata.h"
 #include "unit_test_logger.h"
 #include "hardware.h"
+#include "pwm_group.h"
 // https://stackoverflow.com/questions/23427804/cant-find-mkdir-function-in-dirent-h-for-windows
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -123,6 +124,10 @@ extern bool hasInitGtest;
 
 	enginePins.reset();
 	enginePins.unregisterPins();
+#if EFI_PWM_GROUP
+	// members and pending event of the previous test belong to an engine which is gone
+	getSoftwarePwmGroup().reset();
+#endif
 
 	waveChart.init();
 
@@ -366,6 +371,26 @@ void EngineTestHelper::setTimeAndInvokeEventsUs(int targetTimeUs) {
 	setTimeNowUs(targetTimeUs);
 }
 
+void EngineTestHelper::advanceTimeAndInvokeEventsUs(int64_t deltaTimeUs) {
+	efitimeus_t targetTimeUs = getTimeNowUs() + deltaTimeUs;
+	int counter = 0;
+	while (true) {
+	  criticalAssertVoid(counter++ < 100'000, "EngineTestHelper: failing to advanceTimeAndInvokeEventsUs");
+		scheduling_s* nextScheduledEvent = engine.scheduler.getHead();
+		if (nextScheduledEvent == nullptr) {
+			break;
+		}
+		efitimeus_t nextEventTime = nextScheduledEvent->getMomentUs();
+		if (nextEventTime > targetTimeUs) {
+			break;
+		}
+		advanceTimeUs(nextEventTime - getTimeNowUs());
+		engine.scheduler.executeAll(getTimeNowUs());
+	}
+
+	advanceTimeUs(targetTimeUs - getTimeNowUs());
+}
+
 void EngineTestHelper::fireTriggerEvents(int count) {
 	fireTriggerEvents2(count, 5); // 5ms
 }
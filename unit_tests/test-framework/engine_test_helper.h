@@ -67,6 +67,8 @@ public:
 	void smartFireFall(float delayMs);
 	void moveTimeForwardAndInvokeEventsUs(int deltaTimeUs);
 	void setTimeAndInvokeEventsUs(int timeNowUs);
+	// relative moves only, so that long replays are not limited by int microseconds
+	void advanceTimeAndInvokeEventsUs(int64_t deltaTimeUs);
 	void moveTimeForwardAndInvokeEventsSec(int deltaTimeSeconds);
 	/**
 	 * both Rise and Fall
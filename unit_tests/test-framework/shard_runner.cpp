@@ -0,0 +1,402 @@
+/*
+ * @file shard_runner.cpp
+ */
+
+#include "pch.h"
+#include "unit_test_logger.h"
+#include "shard_runner.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if !IS_WINDOWS_COMPILER
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+static std::string getXmlAttribute(const std::string& tag, const char *name) {
+	std::string key = std::string(" ") + name + "=\"";
+	size_t start = tag.find(key);
+	if (start == std::string::npos) {
+		return "";
+	}
+	start += key.size();
+	size_t end = tag.find('"', start);
+	return end == std::string::npos ? "" : tag.substr(start, end - start);
+}
+
+static std::string escapeXml(const char *text) {
+	std::string result;
+	for (; *text != 0; text++) {
+		switch (*text) {
+		case '<': result += "&lt;"; break;
+		case '>': result += "&gt;"; break;
+		case '&': result += "&amp;"; break;
+		case '"': result += "&quot;"; break;
+		default: result += *text;
+		}
+	}
+	return result;
+}
+
+bool appendGtestReport(const std::string& xml, GtestReport& report) {
+	size_t tagStart = xml.find("<testsuites");
+	if (tagStart == std::string::npos) {
+		return false;
+	}
+	size_t tagEnd = xml.find('>', tagStart);
+	size_t closing = xml.rfind("</testsuites>");
+	if (tagEnd == std::string::npos || closing == std::string::npos || closing < tagEnd) {
+		return false;
+	}
+
+	std::string tag = xml.substr(tagStart, tagEnd - tagStart);
+	report.tests += atoi(getXmlAttribute(tag, "tests").c_str());
+	report.failures += atoi(getXmlAttribute(tag, "failures").c_str());
+	report.errors += atoi(getXmlAttribute(tag, "errors").c_str());
+	report.disabled += atoi(getXmlAttribute(tag, "disabled").c_str());
+	report.time += atof(getXmlAttribute(tag, "time").c_str());
+
+	report.testSuites += xml.substr(tagEnd + 1, closing - tagEnd - 1);
+	return true;
+}
+
+void appendShardFailure(GtestReport& report, int shardIndex, const char *message) {
+	std::stringstream suite;
+	suite << "  <testsuite name=\"shard_" << shardIndex << "\" tests=\"1\" failures=\"1\" disabled=\"0\" errors=\"0\" time=\"0\">\n"
+		<< "    <testcase name=\"shard_" << shardIndex << "\" status=\"run\" result=\"completed\" time=\"0\" classname=\"shard_" << shardIndex << "\">\n"
+		<< "      <failure message=\"" << escapeXml(message) << "\" type=\"\"></failure>\n"
+		<< "    </testcase>\n"
+		<< "  </testsuite>\n";
+
+	report.tests++;
+	report.failures++;
+	report.testSuites += suite.str();
+}
+
+std::string formatGtestReport(const GtestReport& report) {
+	std::stringstream xml;
+	xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		<< "<testsuites tests=\"" << report.tests
+		<< "\" failures=\"" << report.failures
+		<< "\" disabled=\"" << report.disabled
+		<< "\" errors=\"" << report.errors
+		<< "\" time=\"" << report.time
+		<< "\" name=\"AllTests\">"
+		<< report.testSuites
+		<< "</testsuites>\n";
+	return xml.str();
+}
+
+static bool startsWith(const char *str, const char *prefix) {
+	return strncmp(str, prefix, strlen(prefix)) == 0;
+}
+
+int countListedTests(const std::string& listing, bool alsoRunDisabled) {
+	int count = 0;
+	bool suiteDisabled = false;
+	std::istringstream lines(listing);
+	std::string line;
+	while (std::getline(lines, line)) {
+		if (line.empty()) {
+			continue;
+		}
+		// "Suite." then "  test" lines, either may be followed by "  # GetParam() = ..."
+		if (line[0] != ' ') {
+			suiteDisabled = startsWith(line.c_str(), "DISABLED_");
+			continue;
+		}
+		bool disabled = suiteDisabled || startsWith(line.c_str() + line.find_first_not_of(' '), "DISABLED_");
+		if (alsoRunDisabled || !disabled) {
+			count++;
+		}
+	}
+	return count;
+}
+
+bool isShardedRun(int argc, char **argv) {
+	for (int i = 1; i < argc; i++) {
+		if (startsWith(argv[i], "--shards=") || strcmp(argv[i], "--fork-per-test") == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#if IS_WINDOWS_COMPILER
+
+int runShardedTests(int, char **) {
+	printf("Sharded run needs fork(), not available on Windows\n");
+	return -1;
+}
+
+#else // IS_WINDOWS_COMPILER
+
+extern bool hasInitGtest;
+
+namespace {
+struct ShardOptions {
+	int shardCount = 0;
+	bool forkPerTest = false;
+	bool exec = false;
+	int jobs = 0;
+	int timeoutSec = 120;
+	const char *reportFile = nullptr;
+};
+
+struct RunningShard {
+	int index;
+	pid_t pid;
+	std::chrono::steady_clock::time_point startTime;
+	bool timedOut;
+};
+}
+
+static std::string getShardFile(int shardIndex, const char *extension) {
+	return std::string(SHARD_RESULTS_DIR) + "/shard_" + std::to_string(shardIndex) + "." + extension;
+}
+
+static bool readFile(const std::string& fileName, std::string& content) {
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	content = buffer.str();
+	return true;
+}
+
+// child side, never returns
+static void runShard(const ShardOptions& options, int shardIndex, const std::vector<char*>& args) {
+	// interleaved output of parallel shards would be useless
+	int log = open(getShardFile(shardIndex, "log").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (log >= 0) {
+		dup2(log, STDOUT_FILENO);
+		dup2(log, STDERR_FILENO);
+		close(log);
+	}
+
+	setenv("GTEST_TOTAL_SHARDS", std::to_string(options.shardCount).c_str(), 1);
+	setenv("GTEST_SHARD_INDEX", std::to_string(shardIndex).c_str(), 1);
+
+	std::string outputArg = "--gtest_output=xml:" + getShardFile(shardIndex, "xml");
+	std::vector<char*> shardArgs(args);
+	shardArgs.push_back(const_cast<char*>(outputArg.c_str()));
+	shardArgs.push_back(nullptr);
+
+	if (options.exec) {
+		execv(shardArgs[0], shardArgs.data());
+		perror("execv");
+		_exit(127);
+	}
+
+	// same as main() would, only without starting a new process
+	hasInitGtest = true;
+	int shardArgc = shardArgs.size() - 1;
+	testing::InitGoogleTest(&shardArgc, shardArgs.data());
+	int result = RUN_ALL_TESTS();
+	fflush(stdout);
+	fflush(stderr);
+	_exit(result == 0 ? 0 : 1);
+}
+
+// filter and friends are only known to gtest once initialized, so ask a child to list what would run
+static int countTestsToRun(const std::vector<char*>& args) {
+	bool alsoRunDisabled = false;
+	for (char *arg : args) {
+		if (strcmp(arg, "--gtest_also_run_disabled_tests") == 0 || strcmp(arg, "--gtest_also_run_disabled_tests=1") == 0) {
+			alsoRunDisabled = true;
+		}
+	}
+
+	int fds[2];
+	if (pipe(fds) != 0) {
+		perror("pipe");
+		return -1;
+	}
+	fflush(nullptr);
+	pid_t pid = fork();
+	if (pid == 0) {
+		close(fds[0]);
+		dup2(fds[1], STDOUT_FILENO);
+		close(fds[1]);
+
+		const char *listArg = "--gtest_list_tests";
+		std::vector<char*> listArgs(args);
+		listArgs.push_back(const_cast<char*>(listArg));
+		listArgs.push_back(nullptr);
+		int listArgc = listArgs.size() - 1;
+		hasInitGtest = true;
+		testing::InitGoogleTest(&listArgc, listArgs.data());
+		int result = RUN_ALL_TESTS();
+		fflush(stdout);
+		_exit(result == 0 ? 0 : 1);
+	}
+	close(fds[1]);
+	if (pid < 0) {
+		perror("fork");
+		close(fds[0]);
+		return -1;
+	}
+
+	std::string listing;
+	char buffer[4096];
+	ssize_t size;
+	while ((size = read(fds[0], buffer, sizeof(buffer))) > 0) {
+		listing.append(buffer, size);
+	}
+	close(fds[0]);
+
+	int status;
+	if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		printf("Listing tests failed\n");
+		return -1;
+	}
+	return countListedTests(listing, alsoRunDisabled);
+}
+
+static void printShardLog(int shardIndex) {
+	std::string log;
+	if (readFile(getShardFile(shardIndex, "log"), log)) {
+		fwrite(log.data(), 1, log.size(), stdout);
+	}
+}
+
+int runShardedTests(int argc, char **argv) {
+	ShardOptions options;
+	// passed on to shards, starting with ourselves
+	std::vector<char*> args = { argv[0] };
+
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if (startsWith(arg, "--shards=")) {
+			options.shardCount = atoi(arg + strlen("--shards="));
+		} else if (strcmp(arg, "--fork-per-test") == 0) {
+			options.forkPerTest = true;
+		} else if (strcmp(arg, "--exec") == 0) {
+			options.exec = true;
+		} else if (startsWith(arg, "--jobs=")) {
+			options.jobs = atoi(arg + strlen("--jobs="));
+		} else if (startsWith(arg, "--shard-timeout=")) {
+			options.timeoutSec = atoi(arg + strlen("--shard-timeout="));
+		} else if (startsWith(arg, "--report=")) {
+			options.reportFile = arg + strlen("--report=");
+		} else {
+			args.push_back(argv[i]);
+		}
+	}
+
+	if (options.forkPerTest) {
+		// gtest deals tests to shards one by one, with as many shards as tests every shard gets at most one
+		// gtest is only initialized in shards, --gtest_output has to be known by then
+		options.shardCount = countTestsToRun(args);
+	}
+	if (options.shardCount < 1) {
+		printf("Nothing to run\n");
+		return -1;
+	}
+	if (options.jobs < 1) {
+		options.jobs = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	mkdir(TEST_RESULTS_DIR, 0777);
+	mkdir(SHARD_RESULTS_DIR, 0777);
+
+	printf("Running %d shards, %d at a time%s\n", options.shardCount, options.jobs, options.exec ? ", exec" : "");
+	auto startTime = std::chrono::steady_clock::now();
+
+	std::vector<RunningShard> running;
+	std::vector<int> exitCodes(options.shardCount, 0);
+	std::vector<bool> timedOut(options.shardCount, false);
+	int nextShard = 0;
+
+	while (nextShard < options.shardCount || !running.empty()) {
+		while (nextShard < options.shardCount && (int)running.size() < options.jobs) {
+			// report of a previous run would hide a crash
+			remove(getShardFile(nextShard, "xml").c_str());
+			// nothing buffered may be written twice
+			fflush(nullptr);
+			pid_t pid = fork();
+			if (pid == 0) {
+				runShard(options, nextShard, args);
+			}
+			if (pid < 0) {
+				perror("fork");
+				return -1;
+			}
+			running.push_back({ nextShard, pid, std::chrono::steady_clock::now(), false });
+			nextShard++;
+		}
+
+		int status;
+		pid_t pid = waitpid(-1, &status, WNOHANG);
+		if (pid > 0) {
+			for (size_t i = 0; i < running.size(); i++) {
+				if (running[i].pid != pid) {
+					continue;
+				}
+				int index = running[i].index;
+				timedOut[index] = running[i].timedOut;
+				exitCodes[index] = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+				running.erase(running.begin() + i);
+				break;
+			}
+			continue;
+		}
+
+		auto now = std::chrono::steady_clock::now();
+		for (auto& shard : running) {
+			if (!shard.timedOut && now - shard.startTime > std::chrono::seconds(options.timeoutSec)) {
+				kill(shard.pid, SIGKILL);
+				shard.timedOut = true;
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+
+	GtestReport report;
+	int failedShards = 0;
+	for (int i = 0; i < options.shardCount; i++) {
+		std::string xml;
+		bool hasReport = readFile(getShardFile(i, "xml"), xml) && appendGtestReport(xml, report);
+
+		if (exitCodes[i] == 0 && hasReport) {
+			continue;
+		}
+		failedShards++;
+
+		std::string message;
+		if (timedOut[i]) {
+			message = "shard timed out after " + std::to_string(options.timeoutSec) + "s";
+		} else if (!hasReport) {
+			// test failures are in the report, no report means the shard crashed
+			message = "shard did not finish, exit code " + std::to_string(exitCodes[i]);
+		}
+		if (!message.empty()) {
+			appendShardFailure(report, i, message.c_str());
+		}
+
+		printf("\n=== shard %d failed%s%s, %s\n", i, message.empty() ? "" : ": ", message.c_str(), getShardFile(i, "log").c_str());
+		printShardLog(i);
+	}
+
+	if (options.reportFile != nullptr) {
+		std::ofstream file(options.reportFile, std::ios::binary);
+		file << formatGtestReport(report);
+	}
+
+	int elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+	printf("\n%d shards, %d tests, %d failures, %d failed shards in %.1fs\n",
+		options.shardCount, report.tests, report.failures, failedShards, elapsedMs / 1000.0);
+
+	return failedShards == 0 ? 0 : -1;
+}
+
+#endif // IS_WINDOWS_COMPILER
@@ -0,0 +1,54 @@
+/*
+ * @file shard_runner.h
+ *
+ * Runs the test suite split into gtest shards, each shard in its own child process so that one test
+ * can not leak state into another. Shards run in parallel, every shard has a timeout and the gtest
+ * XML reports of all shards are merged into one.
+ *
+ * --shards=N          split into N shards
+ * --fork-per-test     one shard per test left after --gtest_filter
+ * --exec              children exec a fresh rusefi_test instead of only forking
+ * --jobs=N            shards running at the same time, all cores by default
+ * --shard-timeout=S   seconds before a shard is killed, 120 by default
+ * --report=FILE       merged gtest XML report
+ *
+ * Every other argument, like --gtest_filter, is passed on to the shards.
+ */
+
+#pragma once
+
+#include <string>
+
+#define SHARD_RESULTS_DIR TEST_RESULTS_DIR "/shards"
+
+struct GtestReport {
+	int tests = 0;
+	int failures = 0;
+	int errors = 0;
+	int disabled = 0;
+	double time = 0;
+	// <testsuite> elements of all reports
+	std::string testSuites;
+};
+
+/**
+ * @return false if this does not look like a gtest XML report
+ */
+bool appendGtestReport(const std::string& xml, GtestReport& report);
+
+void appendShardFailure(GtestReport& report, int shardIndex, const char *message);
+
+std::string formatGtestReport(const GtestReport& report);
+
+/**
+ * @param listing output of --gtest_list_tests
+ * @return number of tests gtest would actually run, which is what it deals to shards
+ */
+int countListedTests(const std::string& listing, bool alsoRunDisabled);
+
+/**
+ * @return true if arguments ask for sharded run
+ */
+bool isShardedRun(int argc, char **argv);
+
+int runShardedTests(int argc, char **argv);
@@ -0,0 +1,198 @@
+/*
+ * @file trigger_edge_stream.cpp
+ */
+
+#include "trigger_edge_stream.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+static const char BINARY_MAGIC[4] = { 'T', 'E', 'S', '1' };
+
+struct FileCloser {
+	void operator()(FILE *fp) const {
+		fclose(fp);
+	}
+};
+
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+// whole file in one read, parsing from memory is what makes this fast
+static bool readWholeFile(const char *fileName, std::vector<char>& content) {
+	FilePtr fp(fopen(fileName, "rb"));
+	if (!fp) {
+		return false;
+	}
+
+	fseek(fp.get(), 0, SEEK_END);
+	long size = ftell(fp.get());
+	fseek(fp.get(), 0, SEEK_SET);
+	if (size < 0) {
+		return false;
+	}
+
+	// terminator keeps strtod from running off the end
+	content.resize(size + 1);
+	content[size] = 0;
+	return fread(content.data(), 1, size, fp.get()) == (size_t)size;
+}
+
+static const char* skipSpaces(const char *p) {
+	while (*p == ' ' || *p == '\t') {
+		p++;
+	}
+	return p;
+}
+
+static const char* nextLine(const char *p) {
+	while (*p != 0 && *p != '\n') {
+		p++;
+	}
+	return *p == '\n' ? p + 1 : p;
+}
+
+// past the next comma, nullptr at the end of the line
+static const char* nextColumn(const char *p) {
+	while (*p != 0 && *p != ',' && *p != '\n') {
+		p++;
+	}
+	return *p == ',' ? p + 1 : nullptr;
+}
+
+void TriggerEdgeStream::clear(size_t channelCount) {
+	m_channelCount = channelCount;
+	m_startUs = 0;
+	m_durationUs = 0;
+	m_lastUs = 0;
+	m_deltaUs.clear();
+	m_states.clear();
+}
+
+bool TriggerEdgeStream::add(int64_t timeUs, uint8_t states) {
+	if (m_deltaUs.empty()) {
+		m_startUs = timeUs;
+		m_lastUs = timeUs;
+	}
+
+	int64_t deltaUs = timeUs - m_lastUs;
+	if (deltaUs < INT32_MIN) {
+		return false;
+	}
+	// a pause longer than a delta can hold becomes samples repeating the previous states, replay only acts on changes
+	for (; deltaUs > INT32_MAX; deltaUs -= INT32_MAX) {
+		m_deltaUs.push_back(INT32_MAX);
+		m_states.push_back(m_states.back());
+	}
+
+	m_deltaUs.push_back(deltaUs);
+	m_states.push_back(states);
+	m_lastUs = timeUs;
+	m_durationUs = timeUs - m_startUs;
+	return true;
+}
+
+bool TriggerEdgeStream::loadCsv(const char *fileName, size_t channelCount, size_t skipColumns) {
+	if (channelCount > TRIGGER_EDGE_STREAM_MAX_CHANNELS) {
+		return false;
+	}
+	clear(channelCount);
+
+	std::vector<char> content;
+	if (!readWholeFile(fileName, content)) {
+		return false;
+	}
+
+	// about 30 characters per line
+	m_deltaUs.reserve(content.size() / 30);
+	m_states.reserve(content.size() / 30);
+
+	// skip header
+	const char *line = nextLine(content.data());
+
+	for (; *line != 0; line = nextLine(line)) {
+		char *end;
+		double timeStamp = strtod(line, &end);
+		if (end == line) {
+			// blank or broken line
+			continue;
+		}
+
+		const char *column = end;
+		for (size_t i = 0; i < skipColumns && column != nullptr; i++) {
+			column = nextColumn(column);
+		}
+
+		uint8_t states = 0;
+		for (size_t i = 0; i < channelCount; i++) {
+			column = column == nullptr ? nullptr : nextColumn(column);
+			if (column == nullptr) {
+				printf("%s: not enough columns at sample %d\n", fileName, (int)size());
+				return false;
+			}
+			if (*skipSpaces(column) == '1') {
+				states |= 1 << i;
+			}
+		}
+
+		if (!add((int64_t)(1'000'000 * timeStamp), states)) {
+			printf("%s: time going back too far at sample %d\n", fileName, (int)size());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool TriggerEdgeStream::loadBinary(const char *fileName) {
+	FilePtr fp(fopen(fileName, "rb"));
+	if (!fp) {
+		return false;
+	}
+
+	char magic[sizeof(BINARY_MAGIC)];
+	uint32_t channelCount;
+	uint64_t count;
+	int64_t startUs;
+	if (fread(magic, sizeof(magic), 1, fp.get()) != 1
+			|| memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0
+			|| fread(&channelCount, sizeof(channelCount), 1, fp.get()) != 1
+			|| fread(&count, sizeof(count), 1, fp.get()) != 1
+			|| fread(&startUs, sizeof(startUs), 1, fp.get()) != 1
+			|| channelCount > TRIGGER_EDGE_STREAM_MAX_CHANNELS) {
+		return false;
+	}
+
+	clear(channelCount);
+	m_deltaUs.resize(count);
+	m_states.resize(count);
+	if (fread(m_deltaUs.data(), sizeof(int32_t), count, fp.get()) != count
+			|| fread(m_states.data(), sizeof(uint8_t), count, fp.get()) != count) {
+		clear(0);
+		return false;
+	}
+
+	m_startUs = startUs;
+	for (int32_t delta : m_deltaUs) {
+		m_durationUs += delta;
+	}
+	m_lastUs = m_startUs + m_durationUs;
+	return true;
+}
+
+bool TriggerEdgeStream::saveBinary(const char *fileName) const {
+	FilePtr fp(fopen(fileName, "wb"));
+	if (!fp) {
+		return false;
+	}
+
+	uint32_t channelCount = m_channelCount;
+	uint64_t count = size();
+	return fwrite(BINARY_MAGIC, sizeof(BINARY_MAGIC), 1, fp.get()) == 1
+		&& fwrite(&channelCount, sizeof(channelCount), 1, fp.get()) == 1
+		&& fwrite(&count, sizeof(count), 1, fp.get()) == 1
+		&& fwrite(&m_startUs, sizeof(m_startUs), 1, fp.get()) == 1
+		&& fwrite(m_deltaUs.data(), sizeof(int32_t), count, fp.get()) == count
+		&& fwrite(m_states.data(), sizeof(uint8_t), count, fp.get()) == count;
+}
@@ -0,0 +1,67 @@
+/*
+ * @file trigger_edge_stream.h
+ *
+ * Trigger captures converted once into a compact stream: each sample is the time since the previous
+ * sample plus one bit per capture column. Converting is where all the text parsing happens, replaying
+ * a stream is just walking two arrays.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// one bit of TriggerEdgeStream::states per column
+#define TRIGGER_EDGE_STREAM_MAX_CHANNELS 8
+
+class TriggerEdgeStream {
+public:
+	/**
+	 * Capture as exported by logic analyzers: header line, then timestamp in seconds and one 0/1 column per channel
+	 * @param skipColumns columns between the timestamp and the first channel we want
+	 */
+	bool loadCsv(const char *fileName, size_t channelCount, size_t skipColumns = 0);
+
+	bool loadBinary(const char *fileName);
+	bool saveBinary(const char *fileName) const;
+
+	size_t size() const {
+		return m_deltaUs.size();
+	}
+
+	size_t getChannelCount() const {
+		return m_channelCount;
+	}
+
+	// time of the first sample, same truncation CsvReader does
+	int64_t getStartUs() const {
+		return m_startUs;
+	}
+
+	int64_t getDurationUs() const {
+		return m_durationUs;
+	}
+
+	int32_t getDeltaUs(size_t index) const {
+		return m_deltaUs[index];
+	}
+
+	uint8_t getStates(size_t index) const {
+		return m_states[index];
+	}
+
+private:
+	void clear(size_t channelCount);
+	// false if time goes back further than a delta can hold
+	bool add(int64_t timeUs, uint8_t states);
+
+	size_t m_channelCount = 0;
+	int64_t m_startUs = 0;
+	int64_t m_durationUs = 0;
+	int64_t m_lastUs = 0;
+
+	// first delta is always zero
+	std::vector<int32_t> m_deltaUs;
+	std::vector<uint8_t> m_states;
+};
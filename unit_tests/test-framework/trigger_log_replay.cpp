@@ -0,0 +1,221 @@
+/*
+ * @file trigger_log_replay.cpp
+ */
+
+#include "pch.h"
+#include "trigger_log_replay.h"
+#include "trigger_simulator.h"
+#include "unit_test_logger.h"
+
+#include <chrono>
+
+TriggerLogReplay::TriggerLogReplay(const TriggerEdgeStream& stream, size_t triggerCount, size_t vvtCount)
+	: m_stream(stream)
+	, m_triggerCount(triggerCount)
+	, m_vvtCount(vvtCount)
+{
+	efiAssertVoid(ObdCode::OBD_PCM_Processor_Fault, triggerCount + vvtCount <= stream.getChannelCount(), "replay channels");
+}
+
+size_t TriggerLogReplay::replay(EngineTestHelper *eth, size_t maxSamples) {
+	size_t count = 0;
+
+	for (; count < maxSamples && haveMore(); count++) {
+		// engine may already be past the start of the capture, first sample then happens right away
+		int64_t deltaUs = m_index == 0
+			? std::max<int64_t>(0, m_stream.getStartUs() + timestampOffsetUs - getTimeNowUs())
+			: m_stream.getDeltaUs(m_index);
+		eth->advanceTimeAndInvokeEventsUs(deltaUs);
+
+		processSample(m_stream.getStates(m_index));
+		m_index++;
+	}
+
+	return count;
+}
+
+// same order of events as CsvReader::processLine()
+void TriggerLogReplay::processSample(uint8_t states) {
+	bool newTriggerState[TRIGGER_INPUT_PIN_COUNT];
+	bool newVvtState[CAM_INPUTS_COUNT];
+
+	for (size_t i = 0; i < m_triggerCount; i++) {
+		newTriggerState[triggerColumnIndeces[i]] = (states >> i) & 1;
+	}
+	for (size_t i = 0; i < m_vvtCount; i++) {
+		newVvtState[vvtColumnIndeces[i]] = (states >> (m_triggerCount + i)) & 1;
+	}
+
+	for (size_t index = 0; index < m_triggerCount; index++) {
+		if (m_currentState[index] == newTriggerState[index]) {
+			continue;
+		}
+
+		bool invert = index == 0 ? engineConfiguration->invertPrimaryTriggerSignal : engineConfiguration->invertSecondaryTriggerSignal;
+		hwHandleShaftSignal(index, newTriggerState[index] ^ flipOnRead ^ invert, getTimeNowNt());
+
+		m_currentState[index] = newTriggerState[index];
+	}
+
+	for (size_t vvtIndex = 0; vvtIndex < m_vvtCount; vvtIndex++) {
+		if (m_currentVvtState[vvtIndex] == newVvtState[vvtIndex]) {
+			continue;
+		}
+
+		TriggerValue event = newVvtState[vvtIndex] ^ flipVvtOnRead ^ engineConfiguration->invertCamVVTSignal ? TriggerValue::RISE : TriggerValue::FALL;
+		int bankIndex = twoBanksSingleCamMode ? vvtIndex : vvtIndex / 2;
+		int camIndex = twoBanksSingleCamMode ? 0 : vvtIndex % 2;
+		hwHandleVvtCamSignal(event, getTimeNowNt(), bankIndex * 2 + camIndex);
+
+		m_currentVvtState[vvtIndex] = newVvtState[vvtIndex];
+	}
+
+	writeUnitTestLogLine();
+}
+
+TriggerLogDecodeStats decodeTriggerLog(
+		const TriggerEdgeStream& stream,
+		size_t triggerCount,
+		TriggerDecoderBase& decoder,
+		const TriggerWaveform& shape,
+		const TriggerConfiguration& triggerConfiguration,
+		const int* triggerColumnIndeces) {
+	TriggerLogDecodeStats stats;
+
+	bool currentState[TRIGGER_INPUT_PIN_COUNT] = {};
+	int64_t timeUs = stream.getStartUs();
+
+	for (size_t sample = 0; sample < stream.size(); sample++) {
+		timeUs += stream.getDeltaUs(sample);
+		uint8_t states = stream.getStates(sample);
+
+		bool newState[TRIGGER_INPUT_PIN_COUNT];
+		for (size_t i = 0; i < triggerCount; i++) {
+			newState[triggerColumnIndeces[i]] = (states >> i) & 1;
+		}
+
+		for (size_t index = 0; index < triggerCount; index++) {
+			if (currentState[index] == newState[index]) {
+				continue;
+			}
+			currentState[index] = newState[index];
+
+			bool isPrimary = index == 0;
+			if (!isPrimary && !shape.needSecondTriggerInput) {
+				continue;
+			}
+
+			trigger_event_e signal = isPrimary
+				? (newState[index] ? SHAFT_PRIMARY_RISING : SHAFT_PRIMARY_FALLING)
+				: (newState[index] ? SHAFT_SECONDARY_RISING : SHAFT_SECONDARY_FALLING);
+			if (!isUsefulSignal(signal, shape)) {
+				continue;
+			}
+
+			decoder.decodeTriggerEvent("replay", shape, nullptr, triggerConfiguration, signal, US2NT(timeUs));
+			stats.edges++;
+		}
+	}
+
+	stats.synchronizations = decoder.getSynchronizationCounter();
+	stats.triggerErrors = decoder.totalTriggerErrorCounter;
+	stats.orderingErrors = decoder.orderingErrorCounter;
+	return stats;
+}
+
+static bool endsWith(const char *str, const char *suffix) {
+	size_t length = strlen(str);
+	size_t suffixLength = strlen(suffix);
+	return length >= suffixLength && strcmp(str + length - suffixLength, suffix) == 0;
+}
+
+static int printReplayUsage() {
+	printf("usage: rusefi_test --replay <capture.csv|capture.edges> <trigger type> [triggerCount [vvtCount]]"
+		" [--decoder-only] [--save capture.edges]\n");
+	return -1;
+}
+
+int runTriggerLogReplayTool(int argc, char **argv) {
+	const char *fileName = nullptr;
+	const char *saveFileName = nullptr;
+	int triggerType = -1;
+	size_t numbers[2] = { 1, 0 };
+	size_t numberCount = 0;
+	bool decoderOnly = false;
+
+	for (int i = 0; i < argc; i++) {
+		if (strcmp(argv[i], "--decoder-only") == 0) {
+			decoderOnly = true;
+		} else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+			saveFileName = argv[++i];
+		} else if (fileName == nullptr) {
+			fileName = argv[i];
+		} else if (triggerType == -1) {
+			triggerType = atoi(argv[i]);
+		} else if (numberCount < efi::size(numbers)) {
+			numbers[numberCount++] = atoi(argv[i]);
+		} else {
+			return printReplayUsage();
+		}
+	}
+	size_t triggerCount = numbers[0];
+	size_t vvtCount = numbers[1];
+
+	if (fileName == nullptr || triggerType < 0 || triggerCount + vvtCount > TRIGGER_EDGE_STREAM_MAX_CHANNELS) {
+		return printReplayUsage();
+	}
+
+	auto startTime = std::chrono::steady_clock::now();
+	auto elapsedMs = [&startTime]() {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+	};
+
+	TriggerEdgeStream stream;
+	bool isLoaded = endsWith(fileName, ".edges")
+		? stream.loadBinary(fileName)
+		: stream.loadCsv(fileName, triggerCount + vvtCount);
+	if (!isLoaded || stream.getChannelCount() < triggerCount + vvtCount) {
+		printf("Failed to read %s\n", fileName);
+		return -1;
+	}
+	printf("%s: %d samples, %.1f seconds of capture, loaded in %dms\n", fileName,
+		(int)stream.size(), stream.getDurationUs() / 1e6, (int)elapsedMs());
+
+	if (saveFileName != nullptr) {
+		if (!stream.saveBinary(saveFileName)) {
+			printf("Failed to write %s\n", saveFileName);
+			return -1;
+		}
+		printf("Saved %s\n", saveFileName);
+	}
+
+	try {
+		EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+		eth.setTriggerType((trigger_type_e)triggerType);
+
+		startTime = std::chrono::steady_clock::now();
+
+		if (decoderOnly) {
+			TriggerDecoderBase decoder("replay");
+			TriggerLogDecodeStats stats = decodeTriggerLog(stream, triggerCount, decoder,
+				engine->triggerCentral.triggerShape, engine->triggerCentral.primaryTriggerConfiguration);
+			printf("%d edges, %d synchronizations, %d trigger errors, %d ordering errors\n",
+				(int)stats.edges, stats.synchronizations, (int)stats.triggerErrors, (int)stats.orderingErrors);
+		} else {
+			TriggerLogReplay replay(stream, triggerCount, vvtCount);
+			replay.replay(&eth);
+			printf("%d synchronizations, %d trigger errors, %d warnings, final RPM %.1f\n",
+				engine->triggerCentral.triggerState.getSynchronizationCounter(),
+				(int)engine->triggerCentral.triggerState.totalTriggerErrorCounter,
+				eth.getWarningCounter(),
+				Sensor::getOrZero(SensorType::Rpm));
+		}
+	} catch (std::exception& e) {
+		printf("Replay failed: %s\n", e.what());
+		return -1;
+	}
+
+	auto replayMs = elapsedMs();
+	printf("Replayed in %dms, %.0f samples per second\n", (int)replayMs, stream.size() * 1000.0 / (replayMs > 0 ? replayMs : 1));
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * @file trigger_log_replay.h
+ *
+ * Replays a TriggerEdgeStream either through the whole engine, same as CsvReader::processLine() does
+ * line by line, or straight into a TriggerDecoderBase for offline analysis of long captures.
+ *
+ * Command line: rusefi_test --replay <capture.csv|capture.edges> <trigger type> [triggerCount [vvtCount]]
+ *   [--decoder-only] [--save capture.edges]
+ */
+
+#pragma once
+
+#include "logicdata_csv_reader.h"
+#include "trigger_edge_stream.h"
+
+class TriggerLogReplay {
+public:
+	TriggerLogReplay(const TriggerEdgeStream& stream, size_t triggerCount, size_t vvtCount);
+
+	// see CsvReader
+	const int* triggerColumnIndeces = NORMAL_ORDER;
+	const int* vvtColumnIndeces = NORMAL_ORDER;
+	bool twoBanksSingleCamMode = true;
+	bool flipOnRead = false;
+	bool flipVvtOnRead = false;
+	int64_t timestampOffsetUs = 0;
+
+	bool haveMore() const {
+		return m_index < m_stream.size();
+	}
+
+	// index of the next sample, same meaning as CsvReader::lineIndex() once the first one is processed
+	size_t position() const {
+		return m_index;
+	}
+
+	/**
+	 * Feeds samples into the engine, moving time forward and running scheduled events in between
+	 * @return number of samples processed
+	 */
+	size_t replay(EngineTestHelper *eth, size_t maxSamples = SIZE_MAX);
+
+private:
+	void processSample(uint8_t states);
+
+	const TriggerEdgeStream& m_stream;
+	const size_t m_triggerCount;
+	const size_t m_vvtCount;
+
+	size_t m_index = 0;
+
+	bool m_currentState[TRIGGER_INPUT_PIN_COUNT] = {};
+	bool m_currentVvtState[CAM_INPUTS_COUNT] = {};
+};
+
+struct TriggerLogDecodeStats {
+	size_t edges = 0;
+	int synchronizations = 0;
+	uint32_t triggerErrors = 0;
+	uint32_t orderingErrors = 0;
+};
+
+/**
+ * Primary trigger channels only, no engine around: no scheduling, no RPM, just the decoder
+ */
+TriggerLogDecodeStats decodeTriggerLog(
+		const TriggerEdgeStream& stream,
+		size_t triggerCount,
+		TriggerDecoderBase& decoder,
+		const TriggerWaveform& shape,
+		const TriggerConfiguration& triggerConfiguration,
+		const int* triggerColumnIndeces = NORMAL_ORDER);
+
+int runTriggerLogReplayTool(int argc, char **argv);
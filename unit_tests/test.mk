@@ -1,6 +1,9 @@
 FRAMEWORK_SRC_CPP = test-framework/unit_test_framework.cpp \
 	test-framework/engine_test_helper.cpp \
 	test-framework/logicdata_csv_reader.cpp \
+	test-framework/trigger_edge_stream.cpp \
+	test-framework/trigger_log_replay.cpp \
+	test-framework/shard_runner.cpp \
 	boards.cpp \
 	test-framework/test_executor.cpp \
 	test_basic_math/test_find_index.cpp \
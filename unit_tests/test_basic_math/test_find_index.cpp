@@ -27,3 +27,42 @@ TEST(misc, testSetTableValue) {
 	ASSERT_FLOAT_EQ(1.4, config.cltFuelCorr[0]);
 
 }
+
+template<int TSize>
+static void fillAscending(float (&bins)[TSize], uint32_t& seed) {
+	float value = -100;
+	for (int i = 0; i < TSize; i++) {
+		seed = seed * 1664525 + 1013904223;
+		value += 1 + (seed >> 8) % 500;
+		bins[i] = value;
+	}
+}
+
+template<int TSize>
+static void assertSameAsBinarySearch() {
+	uint32_t seed = TSize;
+	float bins[TSize];
+
+	for (int round = 0; round < 50; round++) {
+		fillAscending(bins, seed);
+		for (float value = bins[0] - 10; value < bins[TSize - 1] + 10; value += 3.7f) {
+			ASSERT_EQ(findIndexMsg("test", bins, TSize, value), findIndexMsg("test", bins, value)) << value;
+		}
+		// exact bin values
+		for (int i = 0; i < TSize; i++) {
+			ASSERT_EQ(i, findIndexMsg("test", bins, bins[i]));
+			ASSERT_EQ(i, findIndexMsg("test", bins, TSize, bins[i]));
+		}
+	}
+}
+
+TEST(misc, findIndexBranchlessMatchesBinarySearch) {
+	assertSameAsBinarySearch<8>();
+	assertSameAsBinarySearch<16>();
+	assertSameAsBinarySearch<24>();
+
+	uint16_t intBins[] = { 500, 1000, 1500, 2000 };
+	ASSERT_EQ(-1, findIndexMsg("test", intBins, (uint16_t)400));
+	ASSERT_EQ(1, findIndexMsg("test", intBins, (uint16_t)1499));
+	ASSERT_EQ(3, findIndexMsg("test", intBins, (uint16_t)9000));
+}
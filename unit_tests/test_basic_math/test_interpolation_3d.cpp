@@ -158,3 +158,121 @@ TEST(misc, testInterpolate3d) {
 
 	newTestToComfirmInterpolation();
 }
+
+TEST(misc, axisLookupCacheMatchesInterpolate3d) {
+	int tuneVersion = 0;
+	AxisLookupCache cache;
+	cache.beginCycle(tuneVersion);
+
+	for (float rpm = -50; rpm < 650; rpm += 7.3f) {
+		for (float maf = -1; maf < 6; maf += 0.37f) {
+			EXPECT_NEAR_M4(interpolate3d(map, mafBins, maf, rpmBins, rpm),
+				cache.interpolate3d(map, mafBins, maf, rpmBins, rpm));
+			EXPECT_NEAR_M4(interpolate3d(map, mafBinsScaledInt, maf, rpmBinsScaledByte, rpm),
+				cache.interpolate3d(map, mafBinsScaledInt, maf, rpmBinsScaledByte, rpm));
+			EXPECT_NEAR(interpolate3d(mapScaledChannel, mafBins, maf, rpmBins, rpm),
+				cache.interpolate3d(mapScaledChannel, mafBins, maf, rpmBins, rpm), 1e-3);
+		}
+		// new cycle for each rpm value
+		cache.beginCycle(tuneVersion);
+	}
+
+	cache.endCycle();
+}
+
+TEST(misc, axisLookupCacheMatchesByAddress) {
+	float rpmBinsCopy[RPM_COUNT] = { 100, 200, 300, 400, 500 };
+
+	int tuneVersion = 0;
+	AxisLookupCache cache;
+
+	// not within a cycle: nothing is cached
+	cache.interpolate3d(map, mafBins, 2.5, rpmBins, 250);
+	EXPECT_EQ(0u, cache.hitCounter);
+	EXPECT_EQ(0u, cache.missCounter);
+
+	cache.beginCycle(tuneVersion);
+	cache.interpolate3d(map, mafBins, 2.5, rpmBins, 250);
+	EXPECT_EQ(0u, cache.hitCounter);
+	EXPECT_EQ(2u, cache.missCounter);
+
+	// same axes again
+	cache.interpolate3d(map, mafBins, 2.5, rpmBins, 250);
+	EXPECT_EQ(2u, cache.hitCounter);
+
+	// separate array is a lookup of its own even with identical content
+	EXPECT_NEAR_M4(interpolate3d(map, mafBins, 2.5, rpmBinsCopy, 250),
+		cache.interpolate3d(map, mafBins, 2.5, rpmBinsCopy, 250));
+	EXPECT_EQ(3u, cache.hitCounter);
+	EXPECT_EQ(3u, cache.missCounter);
+
+	// different value is a miss
+	cache.interpolate3d(map, mafBins, 2.5, rpmBins, 260);
+	EXPECT_EQ(4u, cache.hitCounter);
+	EXPECT_EQ(4u, cache.missCounter);
+
+	// same array viewed as a different bin type is a miss
+	uint16_t rawBins[RPM_COUNT] = { 100, 200, 300, 400, 500 };
+	auto& scaledBins = reinterpret_cast<scaled_channel<uint16_t, 10>(&)[RPM_COUNT]>(rawBins);
+	cache.lookup(rawBins, 25);
+	cache.lookup(scaledBins, 25);
+	EXPECT_EQ(6u, cache.missCounter);
+
+	cache.endCycle();
+}
+
+TEST(misc, axisLookupCacheDroppedOnTuneChange) {
+	float bins[RPM_COUNT] = { 100, 200, 300, 400, 500 };
+
+	int tuneVersion = 0;
+	AxisLookupCache cache;
+	cache.beginCycle(tuneVersion);
+
+	EXPECT_NEAR(0.5f, cache.lookup(bins, 250).Frac, EPS4D);
+	EXPECT_EQ(1u, cache.lookup(bins, 250).Idx);
+	EXPECT_EQ(1u, cache.hitCounter);
+
+	// online tuning in the middle of the cycle
+	bins[1] = 150;
+	tuneVersion++;
+	AxisPosition position = cache.lookup(bins, 250);
+	EXPECT_EQ(1u, position.Idx);
+	EXPECT_NEAR(100.0f / 150, position.Frac, EPS4D);
+	EXPECT_EQ(1u, cache.hitCounter);
+	EXPECT_EQ(2u, cache.missCounter);
+
+	cache.endCycle();
+}
+
+TEST(misc, axisLookupCacheMap3D) {
+	static scaled_channel<uint16_t, 10> table[VALUE_COUNT][RPM_COUNT];
+	static scaled_channel<uint16_t, 10> loadBins[VALUE_COUNT] = { 10, 20, 30, 40 };
+	static uint16_t rpmBinsRaw[RPM_COUNT] = { 100, 200, 300, 400, 500 };
+	for (int row = 0; row < VALUE_COUNT; row++) {
+		for (int col = 0; col < RPM_COUNT; col++) {
+			table[row][col] = map[row][col];
+		}
+	}
+
+	Map3D<RPM_COUNT, VALUE_COUNT, uint16_t, uint16_t, uint16_t> direct("direct");
+	direct.initTable(table, rpmBinsRaw, loadBins);
+
+	int tuneVersion = 0;
+	AxisLookupCache cache;
+	Map3D<RPM_COUNT, VALUE_COUNT, uint16_t, uint16_t, uint16_t> cached("cached");
+	cached.initTable(table, rpmBinsRaw, loadBins);
+	cached.setAxisLookupCache(&cache);
+
+	cache.beginCycle(tuneVersion);
+	for (float rpm = 50; rpm < 550; rpm += 13.1f) {
+		for (float load = 5; load < 45; load += 1.7f) {
+			ASSERT_FLOAT_EQ(direct.getValue(rpm, load), cached.getValue(rpm, load));
+			// second table on the same axes, like VE followed by idle VE
+			ASSERT_FLOAT_EQ(direct.getValue(rpm, load), cached.getValue(rpm, load));
+		}
+		cache.beginCycle(tuneVersion);
+	}
+	cache.endCycle();
+
+	EXPECT_GT(cache.hitCounter, 0u);
+}
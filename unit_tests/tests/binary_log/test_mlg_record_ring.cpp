@@ -0,0 +1,104 @@
+#include "pch.h"
+
+#include "binary_logging.h"
+#include "mlg_record_ring.h"
+
+static void captureNumbered(MlgRecordRing<64>& ring, uint8_t number) {
+	uint8_t* slot = ring.beginWrite();
+	if (slot) {
+		memset(slot, number, ring.getRecordSize());
+		ring.commitWrite();
+	}
+}
+
+TEST(MlgRecordRing, fifoOrder) {
+	MlgRecordRing<64> ring;
+	ASSERT_TRUE(ring.setRecordSize(10));
+	EXPECT_EQ(6u, ring.getCapacity());
+	EXPECT_EQ(nullptr, ring.peek());
+
+	// wrap around a few times, keeping one record pending
+	captureNumbered(ring, 0);
+	for (uint8_t i = 1; i < 20; i++) {
+		captureNumbered(ring, i);
+		captureNumbered(ring, i + 100);
+
+		const uint8_t* record = ring.peek();
+		ASSERT_NE(nullptr, record);
+		EXPECT_EQ(i == 1 ? 0 : 100 + i - 1, record[0]);
+		EXPECT_EQ(record[0], record[9]);
+		ring.release();
+
+		EXPECT_EQ(i, ring.peek()[0]);
+		ring.release();
+	}
+
+	EXPECT_EQ(39u, ring.capturedCounter);
+	EXPECT_EQ(0u, ring.droppedCounter);
+	EXPECT_EQ(1u, ring.getPendingCount());
+	EXPECT_EQ(3u, ring.highWaterMark);
+}
+
+TEST(MlgRecordRing, dropsWhenWriterStalls) {
+	MlgRecordRing<64> ring;
+	ASSERT_TRUE(ring.setRecordSize(16));
+
+	for (uint8_t i = 0; i < 10; i++) {
+		captureNumbered(ring, i);
+	}
+
+	// first four made it, the newest ones were dropped
+	EXPECT_EQ(4u, ring.capturedCounter);
+	EXPECT_EQ(6u, ring.droppedCounter);
+	EXPECT_EQ(4u, ring.highWaterMark);
+
+	for (uint8_t i = 0; i < 4; i++) {
+		EXPECT_EQ(i, ring.peek()[0]);
+		ring.release();
+	}
+	EXPECT_EQ(nullptr, ring.peek());
+
+	EXPECT_FALSE(ring.setRecordSize(65));
+	EXPECT_EQ(nullptr, ring.beginWrite());
+}
+
+TEST(MlgRecordRing, recordWriterBounds) {
+	uint8_t buffer[6];
+	memset(buffer, 0xAA, sizeof(buffer));
+
+	MlgRecordWriter writer(buffer, 4);
+	EXPECT_EQ(3u, writer.write("abc", 3));
+	EXPECT_EQ(1u, writer.write("def", 3));
+	EXPECT_EQ(4u, writer.size());
+	EXPECT_EQ('d', buffer[3]);
+	EXPECT_EQ(0xAA, buffer[4]);
+}
+
+TEST(MlgRecordRing, capturedRecordsMatchLogLine) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	size_t recordSize = getSdLogRecordSize();
+	static MlgRecordRing<8192> ring;
+	ASSERT_TRUE(ring.setRecordSize(recordSize));
+
+	resetFileLogging();
+	for (int i = 0; i < 3; i++) {
+		MlgRecordWriter writer(ring.beginWrite(), recordSize);
+		EXPECT_EQ(recordSize, captureSdLogRecord(writer));
+		ring.commitWrite();
+	}
+
+	// rolling counter keeps counting in capture order
+	for (int i = 0; i < 3; i++) {
+		const uint8_t* record = ring.peek();
+		EXPECT_EQ(0, record[0]);
+		EXPECT_EQ(i, record[1]);
+
+		uint8_t sum = 0;
+		for (size_t j = 4; j < recordSize - 1; j++) {
+			sum += record[j];
+		}
+		EXPECT_EQ(sum, record[recordSize - 1]);
+		ring.release();
+	}
+}
@@ -0,0 +1,183 @@
+#include "pch.h"
+
+#include "binary_logging.h"
+#include "log_field.h"
+#include "mlg_row_filter.h"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+static const LogField* findField(const char* name, size_t* offset = nullptr) {
+	size_t position = 4;
+	for (int i = 0; i < getSdCardFieldsCount(); i++) {
+		const LogField& field = getSdLogField(i);
+		if (strcmp(field.getName(), name) == 0) {
+			if (offset) {
+				*offset = position;
+			}
+			return &field;
+		}
+		position += field.getSize();
+	}
+	return nullptr;
+}
+
+static uint16_t getField(const uint8_t* record, size_t offset) {
+	// big endian like LogField
+	return record[offset] << 8 | record[offset + 1];
+}
+
+TEST(MlgRowFilter, rateClassesComeWithFields) {
+	EXPECT_EQ(LogRateClass::Ignore, findField(GAUGE_NAME_TIME)->getRateClass());
+	EXPECT_EQ(LogRateClass::Fast, findField("RPM")->getRateClass());
+	EXPECT_EQ(LogRateClass::Fast, findField("MAP")->getRateClass());
+	EXPECT_EQ(LogRateClass::Slow, findField("CLT")->getRateClass());
+	EXPECT_EQ(LogRateClass::Slow, findField("SD: Logging")->getRateClass());
+	EXPECT_EQ(LogRateClass::Medium, findField("Error: TPS")->getRateClass());
+	EXPECT_EQ(LogRateClass::Medium, findField("Oil Pressure")->getRateClass());
+}
+
+class MlgRowFilterReplay {
+public:
+	MlgRowFilterReplay()
+		: m_record(getSdLogRecordSize())
+		, m_previous(getSdLogRecordSize())
+	{
+		m_filter.init();
+		findField("RPM", &m_rpmOffset);
+	}
+
+	// serializes current output channels and runs them through the filter
+	void capture(efitimeus_t nowUs) {
+		ASSERT_EQ(m_record.size(), serializeSdLogRecord(m_record.data(), m_record.size()));
+		m_rows++;
+
+		uint16_t rpm = getField(m_record.data(), m_rpmOffset);
+		if (m_rows == 1 || rpm != m_lastSourceRpm) {
+			m_sourceRpmChanges++;
+			m_lastSourceRpm = rpm;
+		}
+
+		if (!m_filter.shouldWrite(m_record.data(), m_hasPrevious ? m_previous.data() : nullptr, US2NT(nowUs))) {
+			return;
+		}
+
+		EXPECT_EQ(m_expectedSequence++, m_record[1]);
+		if (!m_hasPrevious || rpm != getField(m_previous.data(), m_rpmOffset)) {
+			m_writtenRpmChanges++;
+		}
+		if (m_hasPrevious) {
+			m_maxGapUs = std::max(m_maxGapUs, nowUs - m_lastWriteUs);
+		}
+
+		m_previous = m_record;
+		m_hasPrevious = true;
+		m_lastWriteUs = nowUs;
+	}
+
+	MlgRowFilter m_filter;
+	int m_rows = 0;
+	int m_sourceRpmChanges = 0;
+	int m_writtenRpmChanges = 0;
+	efitimeus_t m_maxGapUs = 0;
+
+private:
+	std::vector<uint8_t> m_record;
+	std::vector<uint8_t> m_previous;
+	bool m_hasPrevious = false;
+	size_t m_rpmOffset = 0;
+	uint16_t m_lastSourceRpm = 0;
+	uint8_t m_expectedSequence = 0;
+	efitimeus_t m_lastWriteUs = 0;
+};
+
+/**
+ * Key on, engine off: only the heartbeat goes to the card no matter how fast we capture
+ */
+TEST(MlgRowFilter, engineOff) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	MlgRowFilterReplay replay;
+
+	for (int i = 0; i < 500 * 10; i++) {
+		// slow channels creep all the time
+		engine->outputChannels.coolant = 20 + i / 1000.0f;
+		replay.capture(i * 2000);
+	}
+
+	EXPECT_EQ(5000u, replay.m_filter.writtenCounter + replay.m_filter.skippedCounter);
+	EXPECT_EQ(20u, replay.m_filter.writtenCounter);
+	EXPECT_LE(replay.m_maxGapUs, MLG_SLOW_PERIOD_MS * 1000);
+}
+
+/**
+ * 60 seconds of a running engine, 15Hz MS2 log: RPM, MAP, TPS and AFR move between almost any
+ * two rows, so variable rate mode writes nearly all of them. Saving here is well below one percent.
+ */
+TEST(MlgRowFilter, realLogEngineRunning) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	MlgRowFilterReplay replay;
+
+	std::ifstream log("../misc/ms_logs/2013-01-20_02.30.36.msl");
+	ASSERT_TRUE(log.is_open());
+
+	std::string line;
+	// two lines of banner, column names, units
+	std::getline(log, line);
+	std::getline(log, line);
+	std::getline(log, line);
+	std::vector<std::string> columns;
+	{
+		std::istringstream names(line);
+		std::string name;
+		while (std::getline(names, name, '\t')) {
+			columns.push_back(name);
+		}
+	}
+	std::getline(log, line);
+
+	auto column = [&](const char* name) {
+		return std::find(columns.begin(), columns.end(), name) - columns.begin();
+	};
+	size_t time = column("Time");
+	size_t rpm = column("RPM");
+	size_t map = column("MAP");
+	size_t tps = column("TP");
+	size_t afr = column("AFR");
+	size_t clt = column("CLT");
+	size_t iat = column("MAT");
+	size_t vbatt = column("Batt V");
+	size_t timing = column("SparkAdv");
+	size_t pw = column("PW");
+	ASSERT_LT(pw, columns.size());
+
+	while (std::getline(log, line)) {
+		std::vector<float> values;
+		std::istringstream cells(line);
+		std::string cell;
+		while (std::getline(cells, cell, '\t')) {
+			values.push_back(atof(cell.c_str()));
+		}
+		if (values.size() != columns.size()) {
+			continue;
+		}
+
+		engine->outputChannels.RPMValue = values[rpm];
+		engine->outputChannels.MAPValue = values[map];
+		engine->outputChannels.TPSValue = values[tps];
+		engine->outputChannels.AFRValue = values[afr];
+		engine->outputChannels.coolant = (values[clt] - 32) / 1.8f;
+		engine->outputChannels.intake = (values[iat] - 32) / 1.8f;
+		engine->outputChannels.VBatt = values[vbatt];
+		engine->outputChannels.ignitionAdvanceCyl[0] = values[timing];
+		engine->outputChannels.actualLastInjection = values[pw];
+
+		replay.capture(values[time] * 1e6);
+	}
+
+	ASSERT_EQ(967, replay.m_rows);
+	// not a single RPM change lost
+	EXPECT_EQ(replay.m_sourceRpmChanges, replay.m_writtenRpmChanges);
+	// 962 rows of 967
+	EXPECT_EQ(5u, replay.m_filter.skippedCounter);
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "can_listener.h"
+#include "can_listener_index.h"
 
 using ::testing::StrictMock;
 using ::testing::_;
@@ -39,7 +40,7 @@ TEST(CanListener, FrameNotAccepted) {
 }
 
 struct CanListenerNoDecode : public CanListener {
-	CanListenerNoDecode(uint32_t id) : CanListener(id) { }
+	CanListenerNoDecode(uint32_t id, uint32_t mask = CAN_LISTENER_EXACT_MASK) : CanListener(id, mask) { }
 
 	void decodeFrame(const CANRxFrame& frame, efitick_t nowNt) override { }
 };
@@ -65,3 +66,155 @@ TEST(CanListener, FrameNotAcceptedChecksId) {
 
 	EXPECT_FALSE(dut.acceptFrame(frame));
 }
+
+struct CanListenerRangeNoDecode : public CanListenerNoDecode {
+	// four IDs starting at id, id has to be a multiple of four
+	CanListenerRangeNoDecode(uint32_t id) : CanListenerNoDecode(id, ~3u) { }
+};
+
+// narrows its ID down further without saying so in the mask
+struct CanListenerDlcNoDecode : public CanListenerNoDecode {
+	CanListenerDlcNoDecode(uint32_t id) : CanListenerNoDecode(id) { }
+
+	bool acceptFrame(const CANRxFrame& frame) const override {
+		return CanListenerNoDecode::acceptFrame(frame) && frame.DLC == 8;
+	}
+};
+
+static CANRxFrame makeFrame(uint32_t id) {
+	CANRxFrame frame;
+	frame.SID = id;
+	frame.IDE = false;
+	frame.DLC = 8;
+	return frame;
+}
+
+TEST(CanListenerIndex, DispatchesOnlyMatchingIds) {
+	CanListenerNoDecode a(0x300);
+	CanListenerNoDecode b(0x100);
+	CanListenerNoDecode c(0x200);
+	CanListenerNoDecode sameIdAsC(0x200);
+	CanListenerRangeNoDecode range(0x400);
+
+	CanListenerIndex dut;
+	EXPECT_TRUE(dut.add(a));
+	EXPECT_TRUE(dut.add(b));
+	EXPECT_TRUE(dut.add(c));
+	EXPECT_TRUE(dut.add(sameIdAsC));
+	EXPECT_TRUE(dut.add(range));
+
+	EXPECT_EQ(4u, dut.getIndexedCount());
+	EXPECT_EQ(1u, dut.getFallbackCount());
+
+	dut.dispatch(makeFrame(0x200), 0);
+	// both 0x200 listeners, the range listener is outside of its mask
+	EXPECT_EQ(2u, dut.visitedCounter);
+
+	dut.dispatch(makeFrame(0x100), 0);
+	EXPECT_EQ(1u, dut.visitedCounter);
+
+	dut.dispatch(makeFrame(0x402), 0);
+	EXPECT_EQ(1u, dut.visitedCounter);
+
+	dut.dispatch(makeFrame(0x404), 0);
+	EXPECT_EQ(0u, dut.visitedCounter);
+
+	dut.dispatch(makeFrame(0x250), 0);
+	EXPECT_EQ(0u, dut.visitedCounter);
+
+	EXPECT_EQ(0u, a.getHitCounter());
+	EXPECT_EQ(1u, b.getHitCounter());
+	EXPECT_EQ(1u, c.getHitCounter());
+	EXPECT_EQ(1u, sameIdAsC.getHitCounter());
+	EXPECT_EQ(1u, range.getHitCounter());
+	EXPECT_EQ(4u, dut.hitCounter);
+}
+
+TEST(CanListenerIndex, ExactMatchFromMask) {
+	CanListenerNoDecode exact(0x123);
+	CanListenerRangeNoDecode range(0x400);
+	CanListenerNoDecode any(0, 0);
+	// overriding acceptFrame alone does not change where the listener is indexed
+	CanListenerDlcNoDecode dlc(0x124);
+
+	EXPECT_TRUE(exact.isIdExactMatch());
+	EXPECT_FALSE(range.isIdExactMatch());
+	EXPECT_FALSE(any.isIdExactMatch());
+	EXPECT_TRUE(dlc.isIdExactMatch());
+
+	CanListenerIndex dut;
+	EXPECT_TRUE(dut.add(exact));
+	EXPECT_TRUE(dut.add(range));
+	EXPECT_TRUE(dut.add(any));
+	EXPECT_TRUE(dut.add(dlc));
+
+	EXPECT_EQ(2u, dut.getIndexedCount());
+	EXPECT_EQ(2u, dut.getFallbackCount());
+
+	dut.dispatch(makeFrame(0x123), 0);
+	// exact and any
+	EXPECT_EQ(2u, dut.visitedCounter);
+
+	CANRxFrame shortFrame = makeFrame(0x124);
+	shortFrame.DLC = 2;
+	dut.dispatch(shortFrame, 0);
+	// dlc and any, dlc turns it down
+	EXPECT_EQ(2u, dut.visitedCounter);
+	EXPECT_EQ(0u, dlc.getHitCounter());
+
+	dut.dispatch(makeFrame(0x124), 0);
+	EXPECT_EQ(1u, dlc.getHitCounter());
+
+	dut.dispatch(makeFrame(0x403), 0);
+	EXPECT_EQ(1u, range.getHitCounter());
+	EXPECT_EQ(4u, any.getHitCounter());
+}
+
+// registers another listener from inside dispatch, like registerCanListener() on another thread would
+struct CanListenerAddingOther : public CanListenerNoDecode {
+	CanListenerAddingOther(uint32_t id, CanListenerIndex& index, CanListener& other)
+		: CanListenerNoDecode(id)
+		, m_index(index)
+		, m_other(other)
+	{
+	}
+
+	void decodeFrame(const CANRxFrame&, efitick_t) override {
+		m_index.add(m_other);
+	}
+
+	CanListenerIndex& m_index;
+	CanListener& m_other;
+};
+
+TEST(CanListenerIndex, AddDuringDispatch) {
+	CanListenerIndex dut;
+	CanListenerNoDecode lowerId(0x100);
+	CanListenerNoDecode after(0x200);
+	// shifts both 0x200 listeners by one while the first one decodes
+	CanListenerAddingOther first(0x200, dut, lowerId);
+
+	EXPECT_TRUE(dut.add(first));
+	EXPECT_TRUE(dut.add(after));
+
+	dut.dispatch(makeFrame(0x200), 0);
+	EXPECT_EQ(2u, dut.visitedCounter);
+	EXPECT_EQ(1u, first.getHitCounter());
+	EXPECT_EQ(1u, after.getHitCounter());
+	EXPECT_EQ(3u, dut.getIndexedCount());
+}
+
+TEST(CanListenerIndex, Full) {
+	CanListenerNoDecode listener(0x123);
+
+	CanListenerIndex dut;
+	// the index itself does not check for duplicates, registerCanListener does
+	for (size_t i = 0; i < CAN_LISTENER_INDEX_SIZE; i++) {
+		EXPECT_TRUE(dut.add(listener));
+	}
+
+	EXPECT_FALSE(dut.add(listener));
+
+	dut.dispatch(makeFrame(0x123), 0);
+	EXPECT_EQ((size_t)CAN_LISTENER_INDEX_SIZE, dut.visitedCounter);
+}
@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "event_phase_index.h"
+
+static uint32_t getExpected(const float* angles, size_t count, float currentPhase, float nextPhase) {
+	uint32_t expected = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (isPhaseInRange(angles[i], currentPhase, nextPhase)) {
+			expected |= 1u << i;
+		}
+	}
+	return expected;
+}
+
+TEST(EventPhaseIndex, candidates) {
+	EventPhaseIndex<MAX_CYLINDER_COUNT> index;
+	float angles[] = { 0, 90, 180, 270, 360, 450, 540, 630 };
+	index.rebuild(efi::size(angles), 720, [&](size_t i) { return angles[i]; });
+	ASSERT_TRUE(index.isValid(efi::size(angles), 720));
+	EXPECT_FALSE(index.isValid(efi::size(angles), 360));
+
+	// tooth window with an event right on its start
+	EXPECT_EQ(1u << 2, index.getCandidates(180, 186));
+	// nothing close
+	EXPECT_EQ(0u, index.getCandidates(200, 206));
+	// within the margin, handlers sort that out
+	EXPECT_EQ(1u << 3, index.getCandidates(272, 278));
+	// wrap around the end of the cycle
+	EXPECT_EQ(1u << 0, index.getCandidates(714, 6));
+	// empty window is everything, same as isPhaseInRange
+	EXPECT_EQ(0xFFu, index.getCandidates(100, 100));
+}
+
+TEST(EventPhaseIndex, notIndexable) {
+	EventPhaseIndex<MAX_CYLINDER_COUNT> index;
+	float angles[] = { 100, NAN, 200 };
+	index.rebuild(efi::size(angles), 720, [&](size_t i) { return angles[i]; });
+
+	// NaN event is a candidate on every tooth, isPhaseInRange rejects it later
+	EXPECT_EQ(1u << 1, index.getCandidates(300, 306));
+	EXPECT_EQ((1u << 0) | (1u << 1), index.getCandidates(96, 102));
+
+	// becoming a number needs a rebuild
+	index.onAngleChanged(1, 150);
+	EXPECT_FALSE(index.isValid(efi::size(angles), 720));
+}
+
+TEST(EventPhaseIndex, drift) {
+	EventPhaseIndex<MAX_CYLINDER_COUNT> index;
+	float angles[] = { 100, 719 };
+	index.rebuild(efi::size(angles), 720, [&](size_t i) { return angles[i]; });
+
+	index.onAngleChanged(0, 100 + EVENT_PHASE_INDEX_MARGIN - 0.5f);
+	// the short way around the cycle
+	index.onAngleChanged(1, 1);
+	EXPECT_TRUE(index.isValid(efi::size(angles), 720));
+
+	index.onAngleChanged(0, 100 + EVENT_PHASE_INDEX_MARGIN + 0.5f);
+	EXPECT_FALSE(index.isValid(efi::size(angles), 720));
+}
+
+TEST(EventPhaseIndex, supersetOfPhaseInRange) {
+	EventPhaseIndex<MAX_CYLINDER_COUNT> index;
+	uint32_t seed = 1;
+	auto random = [&](float max) {
+		seed = seed * 1664525 + 1013904223;
+		return max * (seed >> 8) / (float)(1 << 24);
+	};
+
+	int rebuildCount = 0;
+	int candidateCount = 0;
+	int eventCount = 0;
+	for (float engineCycle : { 360.0f, 720.0f }) {
+		for (size_t count : { 1, 4, 6, 12 }) {
+			float angles[MAX_CYLINDER_COUNT];
+			for (size_t i = 0; i < count; i++) {
+				angles[i] = random(engineCycle);
+			}
+
+			// 60-2 wheel, a few thousand teeth of angles wandering around
+			for (int tooth = 0; tooth < 5000; tooth++) {
+				size_t event = tooth % count;
+				float angle = angles[event] + random(4) - 2;
+				if (angle < 0) {
+					angle += engineCycle;
+				}
+				if (angle >= engineCycle) {
+					angle -= engineCycle;
+				}
+				angles[event] = angle;
+				index.onAngleChanged(event, angle);
+
+				if (!index.isValid(count, engineCycle)) {
+					index.rebuild(count, engineCycle, [&](size_t i) { return angles[i]; });
+					rebuildCount++;
+				}
+
+				float currentPhase = (tooth % 120) * 6 + random(1);
+				if (currentPhase >= engineCycle) {
+					currentPhase -= engineCycle;
+				}
+				float nextPhase = currentPhase + 6;
+				if (nextPhase >= engineCycle) {
+					nextPhase -= engineCycle;
+				}
+
+				uint32_t expected = getExpected(angles, count, currentPhase, nextPhase);
+				uint32_t candidates = index.getCandidates(currentPhase, nextPhase);
+				ASSERT_EQ(expected, candidates & expected) << engineCycle << "/" << count << "/" << tooth;
+				candidateCount += __builtin_popcount(candidates);
+				eventCount += count;
+			}
+		}
+	}
+
+	// far from visiting every event on every tooth
+	EXPECT_LT(candidateCount, eventCount / 10);
+	// drift within the margin does not need a rebuild on every change
+	EXPECT_LT(rebuildCount, 8 * 5000 / 4);
+}
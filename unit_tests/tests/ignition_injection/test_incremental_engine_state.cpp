@@ -0,0 +1,100 @@
+#include "pch.h"
+
+#include "fuel_math.h"
+#include "tunerstudio.h"
+#include "bench_test.h"
+
+static float getCltCoefficient() {
+	return engine->fuelComputer.running.coolantTemperatureCoefficient;
+}
+
+// what TS does on a curve edit
+static void writeCltFuelCorr(float value) {
+	float curve[CLT_FUEL_CURVE_SIZE];
+	for (size_t i = 0; i < efi::size(curve); i++) {
+		curve[i] = value;
+	}
+
+	::testing::NiceMock<MockTsChannel> channel;
+	TunerStudio instance;
+	instance.handleWriteChunkCommand(&channel, 0, offsetof(persistent_config_s, cltFuelCorr), sizeof(curve), curve);
+}
+
+#if EFI_INCREMENTAL_ENGINE_STATE
+TEST(IncrementalEngineState, recomputeOnlyWhenInputsMove) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	Sensor::setMockValue(SensorType::Clt, 70);
+
+	EngineState& state = engine->engineState;
+	engine->periodicFastCallback();
+	EXPECT_EQ(1u, state.cltCorrectionInputs.recomputeCounter);
+	EXPECT_FLOAT_EQ(getCltFuelCorrection(), getCltCoefficient());
+
+	engine->periodicFastCallback();
+	// within deadband
+	Sensor::setMockValue(SensorType::Clt, 70.05f);
+	engine->periodicFastCallback();
+	EXPECT_EQ(1u, state.cltCorrectionInputs.recomputeCounter);
+	EXPECT_EQ(2u, state.cltCorrectionInputs.skipCounter);
+
+	Sensor::setMockValue(SensorType::Clt, 75);
+	engine->periodicFastCallback();
+	EXPECT_EQ(2u, state.cltCorrectionInputs.recomputeCounter);
+	EXPECT_FLOAT_EQ(getCltFuelCorrection(), getCltCoefficient());
+
+	// any RPM change counts, no deadband
+	uint32_t baroRecomputes = state.baroCorrectionInputs.recomputeCounter;
+	Sensor::setMockValue(SensorType::BarometricPressure, 101.325f);
+	engine->periodicFastCallback();
+	Sensor::setMockValue(SensorType::Rpm, 1001);
+	engine->periodicFastCallback();
+	Sensor::setMockValue(SensorType::Rpm, 1002);
+	engine->periodicFastCallback();
+	EXPECT_EQ(baroRecomputes + 3, state.baroCorrectionInputs.recomputeCounter);
+}
+#endif // EFI_INCREMENTAL_ENGINE_STATE
+
+TEST(IncrementalEngineState, onlineTuningAppliedRightAway) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	Sensor::setMockValue(SensorType::Clt, 70);
+
+	engine->periodicFastCallback();
+	ASSERT_NE(2, getCltCoefficient());
+
+	writeCltFuelCorr(2);
+	engine->periodicFastCallback();
+	EXPECT_FLOAT_EQ(2, getCltCoefficient());
+}
+
+static void checkPresetIsApplied(uint16_t subsystem, uint16_t index) {
+	Sensor::setMockValue(SensorType::Clt, 70);
+
+	writeCltFuelCorr(2);
+	engine->periodicFastCallback();
+	ASSERT_FLOAT_EQ(2, getCltCoefficient());
+
+	executeTSCommand(subsystem, index);
+	EXPECT_TRUE(wasPresetJustApplied());
+	// TS still has the old page and writes it back, that write is dropped
+	writeCltFuelCorr(2);
+
+	engine->periodicFastCallback();
+	EXPECT_NE(2, getCltCoefficient());
+	EXPECT_FLOAT_EQ(getCltFuelCorrection(), getCltCoefficient());
+}
+
+TEST(IncrementalEngineState, engineTypeChange) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	checkPresetIsApplied(TS_SET_ENGINE_TYPE, (uint16_t)engine_type_e::TEST_ENGINE);
+
+	eth.moveTimeForwardSec(2);
+	EXPECT_FALSE(wasPresetJustApplied());
+	writeCltFuelCorr(3);
+	engine->periodicFastCallback();
+	EXPECT_FLOAT_EQ(3, getCltCoefficient());
+}
+
+TEST(IncrementalEngineState, resetToDefaults) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	checkPresetIsApplied(TS_SET_DEFAULT_ENGINE, 0);
+}
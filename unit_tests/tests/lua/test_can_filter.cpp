@@ -48,3 +48,44 @@ TEST(CanFilterTest, orderOfBusinessTwo) {
 	ASSERT_EQ(CALLBACK_ALL, getFilterForId(/*bus*/0, /*id*/ 0)->Callback);
 	ASSERT_EQ(CALLBACK_239, getFilterForId(/*bus*/0, /*id*/ 239)->Callback);
 }
+
+#define CALLBACK_BUS_2 7
+#define CALLBACK_MASKED 9
+
+TEST(CanFilterTest, exactFiltersRespectBusAndOrder) {
+	resetLuaCanRx();
+
+	addLuaCanRxFilter(/*eid*/0x300, FILTER_SPECIFIC, /*bus*/1, CALLBACK_BUS_2);
+	addLuaCanRxFilter(/*eid*/0x100, FILTER_SPECIFIC, ANY_BUS, CALLBACK_239);
+	// 0x300-0x30F on any bus, added after the bus 2 only exact filter
+	addLuaCanRxFilter(/*eid*/0x300, 0x7F0, ANY_BUS, CALLBACK_MASKED);
+	addLuaCanRxFilter(/*eid*/0x300, FILTER_SPECIFIC, ANY_BUS, CALLBACK_ALL);
+
+	ASSERT_EQ(CALLBACK_BUS_2, getFilterForId(/*bus*/1, /*id*/ 0x300)->Callback);
+	// the masked filter was added before the exact filter for any bus
+	ASSERT_EQ(CALLBACK_MASKED, getFilterForId(/*bus*/0, /*id*/ 0x300)->Callback);
+	ASSERT_EQ(CALLBACK_MASKED, getFilterForId(/*bus*/1, /*id*/ 0x305)->Callback);
+	ASSERT_EQ(CALLBACK_239, getFilterForId(/*bus*/0, /*id*/ 0x100)->Callback);
+
+	ASSERT_EQ(nullptr, getFilterForId(/*bus*/0, /*id*/ 0x101));
+	ASSERT_EQ(nullptr, getFilterForId(/*bus*/0, /*id*/ 0x310));
+}
+
+TEST(CanFilterTest, manyExactFilters) {
+	resetLuaCanRx();
+
+	// added in descending order, index keeps them sorted
+	for (int id = 40; id > 0; id--) {
+		addLuaCanRxFilter(/*eid*/id * 3, FILTER_SPECIFIC, ANY_BUS, /*callback*/id);
+	}
+
+	for (int id = 0; id <= 125; id++) {
+		auto filter = getFilterForId(/*bus*/0, id);
+		if (id > 0 && id <= 120 && id % 3 == 0) {
+			ASSERT_NE(nullptr, filter) << id;
+			ASSERT_EQ(id / 3, filter->Callback);
+		} else {
+			ASSERT_EQ(nullptr, filter) << id;
+		}
+	}
+}
@@ -0,0 +1,171 @@
+#include "pch.h"
+#include "rusefi_lua.h"
+#include "can_filter.h"
+
+static CANRxFrame makeFrame(uint32_t id, uint8_t dlc) {
+	CANRxFrame frame;
+	frame.SID = id;
+	frame.IDE = false;
+	frame.DLC = dlc;
+	for (size_t i = 0; i < 8; i++) {
+		frame.data8[i] = id + i;
+	}
+	return frame;
+}
+
+static int getGlobalInteger(lua_State* l, const char* name) {
+	lua_getglobal(l, name);
+	int result = lua_tointeger(l, -1);
+	lua_pop(l, 1);
+	return result;
+}
+
+static int getFunctionRef(lua_State* l, const char* name) {
+	lua_getglobal(l, name);
+	return luaL_ref(l, LUA_REGISTRYINDEX);
+}
+
+static const char* canRxScript = R"(
+	perFrameCount = 0
+	batchCount = 0
+	batchCalls = 0
+	lastDataLength = 0
+	lastByte = 0
+	reusedTables = 0
+	local firstFrame = nil
+
+	function onCanRx(bus, id, dlc, data)
+		perFrameCount = perFrameCount + 1
+		lastByte = data[1]
+	end
+
+	function onBatch(bus, frames, count)
+		batchCalls = batchCalls + 1
+		batchCount = batchCount + count
+		if firstFrame == frames[1] then
+			reusedTables = reusedTables + 1
+		end
+		firstFrame = frames[1]
+		lastDataLength = #frames[count].data
+		lastByte = frames[count].data[1] + frames[count].id
+	end
+)";
+
+TEST(LuaCanRx, batchDeliversAllFramesInOneCall) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	auto ls = testLuaLoadScript(canRxScript);
+	resetLuaCanRx();
+
+	EXPECT_TRUE(setLuaCanRxBatchHandler(ls, 0, getFunctionRef(ls, "onBatch")));
+	EXPECT_TRUE(hasLuaCanRxBatchHandler(0));
+	EXPECT_FALSE(hasLuaCanRxBatchHandler(1));
+
+	CANRxFrame frames[3] = { makeFrame(0x100, 8), makeFrame(0x101, 8), makeFrame(0x102, 2) };
+	const CANRxFrame* pointers[3] = { &frames[0], &frames[1], &frames[2] };
+
+	handleLuaCanFrameBatch(ls, 0, pointers, 3);
+	EXPECT_EQ(1, getGlobalInteger(ls, "batchCalls"));
+	EXPECT_EQ(3, getGlobalInteger(ls, "batchCount"));
+	EXPECT_EQ(2, getGlobalInteger(ls, "lastDataLength"));
+	EXPECT_EQ(0x02 + 0x102, getGlobalInteger(ls, "lastByte"));
+
+	// second tick gets the same frame tables back
+	handleLuaCanFrameBatch(ls, 0, pointers, 1);
+	EXPECT_EQ(2, getGlobalInteger(ls, "batchCalls"));
+	EXPECT_EQ(4, getGlobalInteger(ls, "batchCount"));
+	EXPECT_EQ(8, getGlobalInteger(ls, "lastDataLength"));
+	EXPECT_EQ(1, getGlobalInteger(ls, "reusedTables"));
+
+	// nothing registered for bus 2
+	handleLuaCanFrameBatch(ls, 1, pointers, 3);
+	EXPECT_EQ(2, getGlobalInteger(ls, "batchCalls"));
+
+	resetLuaCanRxBatch();
+	EXPECT_FALSE(hasLuaCanRxBatchHandler(0));
+}
+
+TEST(LuaCanRx, replacedBatchHandlerIsReleased) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	auto ls = testLuaLoadScript(canRxScript);
+	resetLuaCanRx();
+
+	int first = getFunctionRef(ls, "onBatch");
+	EXPECT_TRUE(setLuaCanRxBatchHandler(ls, 0, first));
+	EXPECT_TRUE(setLuaCanRxBatchHandler(ls, 0, getFunctionRef(ls, "onCanRx")));
+
+	// the registry slot of the first handler is free again
+	EXPECT_EQ(first, getFunctionRef(ls, "onBatch"));
+
+	resetLuaCanRxBatch();
+}
+
+TEST(LuaCanRx, batchHandlerAndFilterCallbacksExcludeEachOther) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	auto ls = testLuaLoadScript(canRxScript);
+	resetLuaCanRx();
+
+	// filters without their own callback are fine, their frames go to the batch
+	addLuaCanRxFilter(0x100, FILTER_SPECIFIC, 0, NO_CALLBACK);
+	EXPECT_TRUE(setLuaCanRxBatchHandler(ls, 0, getFunctionRef(ls, "onBatch")));
+
+	EXPECT_FALSE(canUseLuaCanRxFilterCallback(0));
+	EXPECT_FALSE(canUseLuaCanRxFilterCallback(ANY_BUS));
+	EXPECT_TRUE(canUseLuaCanRxFilterCallback(1));
+
+	// bus 2 filter with a callback keeps bus 2 from getting a batch handler
+	addLuaCanRxFilter(0x200, FILTER_SPECIFIC, 1, getFunctionRef(ls, "onCanRx"));
+	EXPECT_FALSE(setLuaCanRxBatchHandler(ls, 1, getFunctionRef(ls, "onBatch")));
+	EXPECT_FALSE(hasLuaCanRxBatchHandler(1));
+
+	resetLuaCanRx();
+	resetLuaCanRxBatch();
+
+	// any bus callback blocks both buses
+	addLuaCanRxFilter(0x300, FILTER_SPECIFIC, ANY_BUS, getFunctionRef(ls, "onCanRx"));
+	EXPECT_FALSE(setLuaCanRxBatchHandler(ls, 0, getFunctionRef(ls, "onBatch")));
+
+	resetLuaCanRx();
+}
+
+TEST(LuaCanRx, batchAllocatesNothingPerTick) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	auto ls = testLuaLoadScript(canRxScript);
+	resetLuaCanRx();
+	EXPECT_TRUE(setLuaCanRxBatchHandler(ls, 0, getFunctionRef(ls, "onBatch")));
+
+	// one full Lua RX queue per tick
+	constexpr size_t framesPerTick = 32;
+	constexpr size_t ticks = 100;
+
+	CANRxFrame frames[framesPerTick];
+	const CANRxFrame* pointers[framesPerTick];
+	for (size_t i = 0; i < framesPerTick; i++) {
+		frames[i] = makeFrame(0x200 + i, 8);
+		pointers[i] = &frames[i];
+	}
+
+	// first tick grows the frame table pool
+	handleLuaCanFrameBatch(ls, 0, pointers, framesPerTick);
+
+	lua_gc(ls, LUA_GCSTOP);
+	auto getHeapBytes = [&]() {
+		return lua_gc(ls, LUA_GCCOUNT) * 1024 + lua_gc(ls, LUA_GCCOUNTB);
+	};
+
+	int before = getHeapBytes();
+	for (size_t tick = 0; tick < ticks; tick++) {
+		handleLuaCanFrameBatch(ls, 0, pointers, framesPerTick);
+	}
+	EXPECT_EQ(before, getHeapBytes());
+	EXPECT_EQ((int)((ticks + 1) * framesPerTick), getGlobalInteger(ls, "batchCount"));
+
+	// while per frame delivery builds a table for every frame
+	before = getHeapBytes();
+	for (size_t i = 0; i < framesPerTick; i++) {
+		handleLuaCanFrame(ls, 0, NO_CALLBACK, frames[i]);
+	}
+	EXPECT_LT(before, getHeapBytes());
+
+	lua_gc(ls, LUA_GCRESTART);
+	resetLuaCanRxBatch();
+}
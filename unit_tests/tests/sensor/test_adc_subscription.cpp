@@ -0,0 +1,83 @@
+#include "pch.h"
+
+#include "adc_subscription.h"
+
+class RecordingSensor final : public FunctionalSensorBase {
+public:
+	RecordingSensor() : FunctionalSensorBase(SensorType::Invalid, MS2NT(50)) { }
+
+	void postRawValue(float inputValue, efitick_t /*timestamp*/) override {
+		lastValue = inputValue;
+		postCounter++;
+	}
+
+	void showInfo(const char* /*sensorName*/) const override { }
+
+	float lastValue = 0;
+	int postCounter = 0;
+};
+
+// same cutoffs and dividers as the actual subscribers, from fuel level to TPS
+static float getCutoff(size_t index) {
+	static const float cutoffs[] = { 0.05f, 2, 10, 20, 50, 100, 200 };
+	return cutoffs[index % efi::size(cutoffs)];
+}
+
+static float getMcuVolts(size_t index, int step) {
+	// something noisy around a per entry level
+	uint32_t seed = (index + 1) * 2654435761u + step * 40503u;
+	return 0.2f * index + (seed >> 20) / 8192.0f;
+}
+
+TEST(AdcSubscription, tableMatchesPerEntryFilters) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	AdcSubscriptionTable table;
+	RecordingSensor sensors[ADC_SUBSCRIPTION_COUNT];
+	// what UpdateSubscribers did before the table: one Biquad per entry
+	Biquad reference[ADC_SUBSCRIPTION_COUNT];
+	bool referenceHasUpdated[ADC_SUBSCRIPTION_COUNT] = {};
+
+	FunctionalSensorBase* subscribed[ADC_SUBSCRIPTION_COUNT] = {};
+	for (size_t i = 0; i < ADC_SUBSCRIPTION_COUNT; i++) {
+		// every third entry stays free
+		if (i % 3 == 2) {
+			continue;
+		}
+		subscribed[i] = &sensors[i];
+		table.entries[i].Sensor = &sensors[i];
+		table.voltsPerAdcVolt[i] = i % 2 ? 1 : 1.47f;
+		reference[i].configureLowpass(SLOW_ADC_RATE, getCutoff(i));
+		table.filters.configure(i, reference[i]);
+	}
+
+	for (int step = 0; step < 2000; step++) {
+		float mcuVolts[ADC_SUBSCRIPTION_COUNT];
+		for (size_t i = 0; i < ADC_SUBSCRIPTION_COUNT; i++) {
+			mcuVolts[i] = subscribed[i] ? getMcuVolts(i, step) : 0;
+		}
+
+		table.update(subscribed, mcuVolts, getTimeNowNt());
+
+		for (size_t i = 0; i < ADC_SUBSCRIPTION_COUNT; i++) {
+			if (!subscribed[i]) {
+				EXPECT_EQ(0, sensors[i].postCounter);
+				continue;
+			}
+
+			float sensorVolts = mcuVolts[i] * table.voltsPerAdcVolt[i];
+			if (!referenceHasUpdated[i]) {
+				reference[i].cookSteadyState(sensorVolts);
+				referenceHasUpdated[i] = true;
+			}
+			float expected = reference[i].filter(sensorVolts);
+
+			ASSERT_NEAR(expected, sensors[i].lastValue, 1e-5) << "entry " << i << " step " << step;
+			EXPECT_EQ(sensorVolts, table.entries[i].sensorVolts);
+		}
+	}
+
+	EXPECT_EQ(2000, sensors[0].postCounter);
+	EXPECT_TRUE(table.entries[0].HasUpdated);
+	EXPECT_FALSE(table.entries[2].HasUpdated);
+}
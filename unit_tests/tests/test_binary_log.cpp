@@ -1,7 +1,11 @@
+#include "pch.h"
+
 #include "log_field.h"
 #include "buffered_writer.h"
+#include "binary_logging.h"
 
 #include <gmock/gmock.h>
+#include <vector>
 
 using ::testing::_;
 using ::testing::ElementsAre;
@@ -60,3 +64,84 @@ TEST(BinaryLogField, Value) {
 	// Check that big endian data was written, and bytes after weren't touched
 	EXPECT_THAT(buffer, ElementsAre(0x00, 0xbc, 0x61, 0x4e, 0xAA, 0xAA));
 }
+
+TEST(BinaryLogField, RecordDataMatchesWriteData) {
+	scaled_channel<uint32_t, 1> u32 = 12345678;
+	scaled_channel<int16_t, 10> s16 = -123.4;
+	scaled_channel<int8_t, 1> s8 = -5;
+	float f = 3.14f;
+	uint32_t bits = 0x00040100;
+
+	const LogField logFields[] = {
+		{ u32, "u32", "", 0 },
+		{ s16, "s16", "", 1 },
+		{ s8, "s8", "", 0 },
+		{ f, "f", "", 2 },
+		{ bits, 0, 8, "bit 8", "" },
+		{ bits, 0, 9, "bit 9", "" },
+		{ bits, 0, 18, "bit 18", "" },
+	};
+
+	for (const auto& field : logFields) {
+		char expected[8];
+		uint8_t actual[8];
+		memset(expected, 0xAA, sizeof(expected));
+		memset(actual, 0xAA, sizeof(actual));
+
+		size_t size = field.writeData(expected, nullptr);
+		EXPECT_EQ(size, field.writeRecordData(actual, 0)) << field.getName();
+		EXPECT_EQ(0, memcmp(expected, actual, sizeof(actual))) << field.getName();
+	}
+}
+
+// the way records were built before: scratch buffer, byte by byte sum and a Writer call per field
+static size_t writeRecordPerField(Writer& writer) {
+	char buffer[16] = { 0 };
+	writer.write(buffer, 4);
+	size_t size = 4;
+
+	uint8_t sum = 0;
+	for (int i = 0; i < getSdCardFieldsCount(); i++) {
+		void* offset = i == 0 ? nullptr : engine;
+		size_t entrySize = getSdLogField(i).writeData(buffer, offset);
+		for (size_t byteIndex = 0; byteIndex < entrySize; byteIndex++) {
+			sum += buffer[byteIndex];
+		}
+		writer.write(buffer, entrySize);
+		size += entrySize;
+	}
+
+	buffer[0] = sum;
+	writer.write(buffer, 1);
+	return size + 1;
+}
+
+class RecordBufferWriter final : public BufferedWriter<512> {
+public:
+	std::vector<uint8_t> bytes;
+
+protected:
+	size_t writeInternal(const char* buffer, size_t count) override {
+		bytes.insert(bytes.end(), buffer, buffer + count);
+		return count;
+	}
+};
+
+TEST(BinaryLogField, RecordMatchesPerFieldWriter) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engine->outputChannels.RPMValue = 3456;
+	engine->outputChannels.coolant = 87.5;
+
+	size_t recordSize = getSdLogRecordSize();
+	std::vector<uint8_t> record(recordSize);
+	ASSERT_EQ(recordSize, serializeSdLogRecord(record.data(), recordSize));
+	EXPECT_EQ(0u, serializeSdLogRecord(record.data(), recordSize - 1));
+
+	RecordBufferWriter writer;
+	ASSERT_EQ(recordSize, writeRecordPerField(writer));
+	writer.flush();
+	ASSERT_EQ(recordSize, writer.bytes.size());
+
+	// everything past block type, counter and timestamp, checksum included
+	EXPECT_EQ(0, memcmp(record.data() + 4, writer.bytes.data() + 4, recordSize - 4));
+}
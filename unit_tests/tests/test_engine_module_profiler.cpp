@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "engine_module_profiler.h"
+
+namespace {
+struct ProfiledTestModule : public EngineModule {
+	void onFastCallback() override {
+		fastCounter++;
+	}
+
+	int fastCounter = 0;
+};
+}
+
+// registrations live as long as the process, timings are reset for every test
+class EngineModuleProfiler : public ::testing::Test {
+protected:
+	void SetUp() override {
+		resetModuleProfiles();
+	}
+};
+
+TEST_F(EngineModuleProfiler, timing) {
+	ModuleTiming timing;
+	EXPECT_EQ(0u, timing.getAverage());
+
+	timing.record(10, 100);
+	timing.record(30, 100);
+	timing.record(200, 100);
+
+	EXPECT_EQ(3u, timing.count);
+	EXPECT_EQ(10u, timing.minTicks);
+	EXPECT_EQ(200u, timing.maxTicks);
+	EXPECT_EQ(80u, timing.getAverage());
+	EXPECT_EQ(1u, timing.overrunCount);
+
+	timing.reset();
+	EXPECT_EQ(0u, timing.count);
+	EXPECT_EQ(0u, timing.maxTicks);
+}
+
+TEST_F(EngineModuleProfiler, registration) {
+	ModuleProfile* profile = getModuleProfileFor<ProfiledTestModule>();
+	ASSERT_NE(nullptr, profile);
+	// same type, same entry
+	EXPECT_EQ(profile, getModuleProfileFor<ProfiledTestModule>());
+	EXPECT_EQ(profile, registerModuleProfile(getModuleSignature<ProfiledTestModule>()));
+
+	char name[64];
+	getModuleProfileName(*profile, name, sizeof(name));
+	EXPECT_NE(nullptr, strstr(name, "ProfiledTestModule"));
+
+	// truncated but terminated
+	getModuleProfileName(*profile, name, 4);
+	EXPECT_EQ(3u, strlen(name));
+}
+
+TEST_F(EngineModuleProfiler, callsThrough) {
+	ProfiledTestModule module;
+	ModuleProfile* profile = getModuleProfileFor<ProfiledTestModule>();
+
+	CALL_ENGINE_MODULE(ModuleCallback::Fast, module, onFastCallback);
+	CALL_ENGINE_MODULE(ModuleCallback::Fast, module, onFastCallback);
+
+	EXPECT_EQ(2, module.fastCounter);
+	EXPECT_EQ(2u, profile->fast.count);
+	EXPECT_EQ(0u, profile->slow.count);
+}
+
+template <typename TModule>
+static void expectModuleProfile(uint32_t fastCount, uint32_t slowCount) {
+	const char* signature = getModuleSignature<TModule>();
+	ModuleProfile* profile = getModuleProfileFor<TModule>();
+	ASSERT_NE(nullptr, profile) << signature;
+	EXPECT_EQ(fastCount, profile->fast.count) << signature;
+	EXPECT_EQ(slowCount, profile->slow.count) << signature;
+}
+
+template <typename... TModules>
+static void expectModuleProfiles(uint32_t fastCount, uint32_t slowCount) {
+	(expectModuleProfile<TModules>(fastCount, slowCount), ...);
+}
+
+TEST_F(EngineModuleProfiler, engineCallbacks) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	// helper has already run a slow callback
+	resetModuleProfiles();
+
+	for (int i = 0; i < 5; i++) {
+		engine->periodicFastCallback();
+	}
+	engine->periodicSlowCallback();
+
+	// any order, engineModules is free to change it
+	expectModuleProfiles<
+		TriggerScheduler,
+		FuelPumpController,
+		MainRelayController,
+		FanControl1,
+		FanControl2,
+		PrimeController,
+		DfcoController,
+		KnockController,
+		SensorChecker,
+		LimpManager,
+		BoostController,
+		TpsAccelEnrichment
+	>(5, 1);
+
+	EXPECT_EQ(5u, getModuleCallbackTotal(ModuleCallback::Fast).count);
+	EXPECT_EQ(1u, getModuleCallbackTotal(ModuleCallback::Slow).count);
+	// the test module is never called by the engine
+	EXPECT_EQ(0u, getModuleProfileFor<ProfiledTestModule>()->fast.count);
+}
+
+TEST_F(EngineModuleProfiler, outputChannels) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	// helper has already run a slow callback
+	resetModuleProfiles();
+
+	ModuleProfile* fuelPump = getModuleProfileFor<FuelPumpController>();
+	ASSERT_NE(nullptr, fuelPump);
+	ModuleProfile* knock = getModuleProfileFor<KnockController>();
+	ASSERT_NE(nullptr, knock);
+
+	// budget is 1/10 of the period: fast callback 5ms so 500us, slow 50ms so 5ms
+	uint32_t ticksPerUs = getModuleBudgetTicks(ModuleCallback::Fast) / 500;
+	fuelPump->fast.record(3000 * ticksPerUs, getModuleBudgetTicks(ModuleCallback::Fast));
+	knock->slow.record(1500 * ticksPerUs, getModuleBudgetTicks(ModuleCallback::Slow));
+	knock->slow.record(6000 * ticksPerUs, getModuleBudgetTicks(ModuleCallback::Slow));
+	getModuleCallbackTotal(ModuleCallback::Fast).record(4000 * ticksPerUs, UINT32_MAX);
+	getModuleCallbackTotal(ModuleCallback::Slow).record(7000 * ticksPerUs, UINT32_MAX);
+
+	publishModuleProfiles();
+
+	EXPECT_EQ(4000, engine->outputChannels.moduleFastPassMaxUs);
+	EXPECT_EQ(7000, engine->outputChannels.moduleSlowPassMaxUs);
+	EXPECT_EQ(2, engine->outputChannels.moduleOverrunCount);
+	EXPECT_EQ(6000, engine->outputChannels.moduleSlowestMaxUs);
+	EXPECT_EQ(knock - &getModuleProfile(0), engine->outputChannels.moduleSlowestIndex);
+
+	// saturates rather than wraps
+	getModuleCallbackTotal(ModuleCallback::Fast).record(100000 * ticksPerUs, UINT32_MAX);
+	publishModuleProfiles();
+	EXPECT_EQ(UINT16_MAX, engine->outputChannels.moduleFastPassMaxUs);
+}
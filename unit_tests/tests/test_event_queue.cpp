@@ -8,6 +8,10 @@
 #include "pch.h"
 
 #include "event_queue.h"
+#include "event_timing_stats.h"
+#include "pwm_group.h"
+#include "spark_logic.h"
+#include "main_trigger_callback.h"
 
 static int callbackCounter = 0;
 
@@ -97,9 +101,10 @@ TEST(EventQueue, complex) {
 
 	ASSERT_EQ(4, eq.size());
 	ASSERT_EQ(10, eq.getHead()->getMomentNt());
-	ASSERT_EQ(10, eq.getHead()->nextScheduling_s->getMomentNt());
-	ASSERT_EQ(11, eq.getHead()->nextScheduling_s->nextScheduling_s->getMomentNt());
-	ASSERT_EQ(12, eq.getHead()->nextScheduling_s->nextScheduling_s->nextScheduling_s->getMomentNt());
+	ASSERT_EQ(&s1, eq.getElementAtIndexForUnitText(0));
+	ASSERT_EQ(&s4, eq.getElementAtIndexForUnitText(1));
+	ASSERT_EQ(11, eq.getElementAtIndexForUnitText(2)->getMomentNt());
+	ASSERT_EQ(12, eq.getElementAtIndexForUnitText(3)->getMomentNt());
 
 	callbackCounter = 0;
 	eq.executeAll(10);
@@ -213,3 +218,108 @@ TEST_F(EventQueueRemoveTest, removeNotPresent) {
 	ASSERT_EQ(&s3, dut.getElementAtIndexForUnitText(2));
 	ASSERT_EQ(nullptr, dut.getElementAtIndexForUnitText(3));
 }
+
+TEST(EventQueue, sameMomentIsFifo) {
+	EventQueue eq;
+	scheduling_s s1, s2, s3;
+
+	eq.insertTask(&s1, 10, { orderCallback, (void*)1 });
+	eq.insertTask(&s2, 10, { orderCallback, (void*)2 });
+	eq.insertTask(&s3, 10, { orderCallback, (void*)3 });
+
+	prevValue = 0;
+	ASSERT_EQ(3, eq.executeAll(10));
+	ASSERT_EQ(3u, prevValue);
+}
+
+TEST(EventQueue, insertReportsNewHead) {
+	EventQueue eq;
+	scheduling_s s1, s2, s3;
+
+	ASSERT_TRUE(eq.insertTask(&s1, 100, callback));
+	ASSERT_FALSE(eq.insertTask(&s2, 200, callback));
+	ASSERT_TRUE(eq.insertTask(&s3, 50, callback));
+	ASSERT_EQ(&s3, eq.getHead());
+
+	eq.remove(&s3);
+	ASSERT_EQ(&s1, eq.getHead());
+}
+
+TEST(EventQueue, timingBuckets) {
+	EXPECT_EQ(0u, getEventTimingBucket(0));
+	EXPECT_EQ(1u, getEventTimingBucket(1));
+	EXPECT_EQ(2u, getEventTimingBucket(2));
+	EXPECT_EQ(2u, getEventTimingBucket(3));
+	EXPECT_EQ(10u, getEventTimingBucket(1000));
+	// everything too late ends up in the last bucket
+	EXPECT_EQ(EVENT_TIMING_BUCKET_COUNT - 1u, getEventTimingBucket(1 << 20));
+}
+
+TEST(EventQueue, eventClass) {
+	EXPECT_EQ(EventClass::Spark, getEventClass(action_s(&turnSparkPinHighStartCharging, (IgnitionEvent*)nullptr).getCallback()));
+	EXPECT_EQ(EventClass::Spark, getEventClass(action_s(&fireSparkAndPrepareNextSchedule, (IgnitionEvent*)nullptr).getCallback()));
+	EXPECT_EQ(EventClass::Injection, getEventClass(action_s(&turnInjectionPinHigh, (uintptr_t)0).getCallback()));
+	EXPECT_EQ(EventClass::Injection, getEventClass(action_s(&turnInjectionPinLow, (InjectionEvent*)nullptr).getCallback()));
+	EXPECT_EQ(EventClass::Pwm, getEventClass(action_s(&pwmTimerCallback, (PwmConfig*)nullptr).getCallback()));
+	EXPECT_EQ(EventClass::Pwm, getEventClass(action_s(&pwmGroupCallback, (PwmGroup*)nullptr).getCallback()));
+	EXPECT_EQ(EventClass::Generic, getEventClass(action_s(callback).getCallback()));
+}
+
+static void slowCallback(void*) {
+	advanceTimeUs(300);
+}
+
+TEST(EventQueue, timingStats) {
+	EventQueue eq;
+	scheduling_s s;
+	resetEventTiming();
+
+	setTimeNowUs(1000);
+	// 50us late by the time the queue gets to it
+	eq.insertTask(&s, US2NT(950), slowCallback);
+	ASSERT_EQ(1, eq.executeAll(getTimeNowNt()));
+
+	event_timing_report_s report;
+	getEventTimingReport(report, true);
+	EXPECT_EQ(EVENT_CLASS_COUNT, report.classCount);
+	EXPECT_EQ(US_TO_NT_MULTIPLIER, report.ticksPerUs);
+
+	const event_class_timing_s& generic = report.classes[(size_t)EventClass::Generic];
+	EXPECT_EQ(1u, generic.count);
+	EXPECT_EQ(US2NT(50), generic.lateness.max);
+	EXPECT_EQ(1u, generic.lateness.buckets[getEventTimingBucket(50)]);
+	EXPECT_EQ(US2NT(300), generic.duration.max);
+	EXPECT_EQ(1u, generic.duration.buckets[getEventTimingBucket(300)]);
+	EXPECT_EQ(0u, report.classes[(size_t)EventClass::Spark].count);
+
+	// previous read did reset
+	getEventTimingReport(report);
+	EXPECT_EQ(0u, report.classes[(size_t)EventClass::Generic].count);
+}
+
+TEST(EventQueue, moreThanHeapSize) {
+	static scheduling_s events[EVENT_QUEUE_HEAP_SIZE + 50];
+	const int count = efi::size(events);
+
+	EventQueue eq;
+	// descending so that late arrivals are due first and spilled events have to win over heap ones
+	for (int i = 0; i < count; i++) {
+		eq.insertTask(&events[i], 10 * (count - i), { orderCallback, (void*)(intptr_t)(count - i) });
+	}
+	ASSERT_EQ(count, eq.size());
+	ASSERT_EQ(&events[count - 1], eq.getHead());
+	ASSERT_EQ(&events[count - 2], eq.getElementAtIndexForUnitText(1));
+	ASSERT_EQ(&events[0], eq.getElementAtIndexForUnitText(count - 1));
+
+	// cancel both from the heap and from the spill list
+	eq.remove(&events[0]);
+	eq.remove(&events[count - 1]);
+	ASSERT_EQ(count - 2, eq.size());
+	ASSERT_EQ(&events[count - 2], eq.getHead());
+
+	prevValue = 0;
+	ASSERT_EQ(count - 2, eq.executeAll(10 * count));
+	ASSERT_EQ((uintptr_t)(count - 1), prevValue);
+	ASSERT_EQ(0, eq.size());
+	ASSERT_EQ(nullptr, eq.getHead());
+}
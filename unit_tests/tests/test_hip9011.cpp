@@ -31,7 +31,7 @@ TEST(hip9011, rpmLookup) {
 	HIP9011 instance(NULL);
 
 	instance.angleWindowWidth = 50.0;
-	instance.prepareRpmLookup();
+	ASSERT_TRUE(instance.prepareRpmLookup());
 
 	EXPECT_EQ(31, instance.getIntegrationIndexByRpm(1));
 	EXPECT_EQ(21, instance.getIntegrationIndexByRpm(1100));
@@ -39,6 +39,22 @@ TEST(hip9011, rpmLookup) {
 	EXPECT_EQ(0, instance.getIntegrationIndexByRpm(16600));
 }
 
+TEST(hip9011, rpmLookupValidation) {
+	HIP9011 instance(NULL);
+
+	instance.angleWindowWidth = 360.0;
+	EXPECT_TRUE(instance.prepareRpmLookup());
+	EXPECT_NEAR(47746, instance.rpmLookup[INT_LOOKUP_SIZE - 1], 1);
+
+	// 40us would be 95k RPM, way past uint16_t
+	instance.angleWindowWidth = 720.0;
+	EXPECT_FALSE(instance.prepareRpmLookup());
+	EXPECT_EQ(UINT16_MAX, instance.rpmLookup[INT_LOOKUP_SIZE - 1]);
+
+	instance.angleWindowWidth = 0;
+	EXPECT_FALSE(instance.prepareRpmLookup());
+}
+
 TEST(hip9011, band) {
 	HIP9011 instance(NULL);
 
@@ -0,0 +1,146 @@
+#include "pch.h"
+
+BigBufferUser getBigBufferCurrentUser();
+
+#define TRACE_ENTRY_SIZE 8
+#define TRACE_RING_LENGTH (BIG_BUFFER_SIZE / TRACE_ENTRY_SIZE)
+
+static int tsLink;
+static int sdCard;
+
+// consecutive events, INVALID is what an unfinished slot looks like so skip it
+static PE nthEvent(uint32_t index) {
+	return static_cast<PE>(1 + index % static_cast<uint32_t>(PE::LuaCanRxBatchCallback));
+}
+
+// drains everything pending, checks records are whole and in order
+static uint32_t readAll(PerfTraceStreamOwner owner, uint32_t firstIndex) {
+	uint32_t index = firstIndex;
+	const uint8_t* data;
+	size_t size;
+	while ((size = perfTraceStreamPeek(owner, data)) != 0) {
+		EXPECT_EQ(0u, size % TRACE_ENTRY_SIZE);
+		for (size_t offset = 0; offset < size; offset += TRACE_ENTRY_SIZE) {
+			EXPECT_EQ(static_cast<uint8_t>(nthEvent(index)), data[offset]) << index;
+			index++;
+		}
+		perfTraceStreamRelease(owner, size);
+	}
+	return index - firstIndex;
+}
+
+static void record(uint32_t firstIndex, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		perfEventInstantGlobal(nthEvent(firstIndex + i));
+	}
+}
+
+TEST(PerfTrace, streamWrapsAround) {
+	ASSERT_TRUE(perfTraceStreamStart(&tsLink));
+
+	// leave the tail in the middle of the ring
+	record(0, TRACE_RING_LENGTH / 2 + 3);
+	EXPECT_EQ(TRACE_RING_LENGTH / 2 + 3, readAll(&tsLink, 0));
+
+	// a full ring worth crosses the end
+	record(1000, TRACE_RING_LENGTH);
+	const uint8_t* data;
+	// first peek stops at the end of the ring
+	EXPECT_EQ((TRACE_RING_LENGTH / 2 - 3) * TRACE_ENTRY_SIZE, perfTraceStreamPeek(&tsLink, data));
+	EXPECT_EQ(TRACE_RING_LENGTH, readAll(&tsLink, 1000));
+
+	PerfTraceStreamStats stats = perfTraceStreamGetStats();
+	EXPECT_EQ(TRACE_RING_LENGTH * 3 / 2 + 3, stats.recorded);
+	EXPECT_EQ(0u, stats.dropped);
+	EXPECT_EQ(TRACE_RING_LENGTH, stats.highWaterMark);
+
+	perfTraceStreamStop(&tsLink);
+}
+
+TEST(PerfTrace, streamOverflowDrops) {
+	ASSERT_TRUE(perfTraceStreamStart(&tsLink));
+
+	record(0, TRACE_RING_LENGTH + 10);
+
+	PerfTraceStreamStats stats = perfTraceStreamGetStats();
+	EXPECT_EQ(TRACE_RING_LENGTH, stats.recorded);
+	EXPECT_EQ(10u, stats.dropped);
+	EXPECT_EQ(TRACE_RING_LENGTH, stats.highWaterMark);
+
+	// the oldest ones are kept, newest are lost
+	EXPECT_EQ(TRACE_RING_LENGTH, readAll(&tsLink, 0));
+
+	// room again once read
+	record(5, 1);
+	EXPECT_EQ(1u, readAll(&tsLink, 5));
+	EXPECT_EQ(10u, perfTraceStreamGetStats().dropped);
+
+	perfTraceStreamStop(&tsLink);
+}
+
+TEST(PerfTrace, streamStop) {
+	ASSERT_TRUE(perfTraceStreamStart(&tsLink));
+	EXPECT_TRUE(perfTraceIsStreaming());
+	EXPECT_EQ(BigBufferUser::PerfTrace, getBigBufferCurrentUser());
+
+	record(0, 20);
+	perfTraceStreamStop(&tsLink);
+
+	EXPECT_FALSE(perfTraceIsStreaming());
+	// unread records are gone with the buffer
+	EXPECT_EQ(BigBufferUser::None, getBigBufferCurrentUser());
+	const uint8_t* data;
+	EXPECT_EQ(0u, perfTraceStreamPeek(&tsLink, data));
+
+	// nothing is recorded any more
+	record(0, 5);
+	EXPECT_EQ(20u, perfTraceStreamGetStats().recorded);
+
+	// stopping twice is harmless
+	perfTraceStreamStop(&tsLink);
+}
+
+TEST(PerfTrace, streamHasSingleOwner) {
+	ASSERT_TRUE(perfTraceStreamStart(&tsLink));
+	record(0, 3);
+
+	// SD card is turned away, and can neither read nor stop
+	EXPECT_FALSE(perfTraceStreamStart(&sdCard));
+	EXPECT_FALSE(perfTraceStreamIsOwner(&sdCard));
+	const uint8_t* data;
+	EXPECT_EQ(0u, perfTraceStreamPeek(&sdCard, data));
+	perfTraceStreamRelease(&sdCard, 3 * TRACE_ENTRY_SIZE);
+	perfTraceStreamStop(&sdCard);
+	EXPECT_TRUE(perfTraceIsStreaming());
+	// one buffer worth mode shares the buffer
+	EXPECT_FALSE(perfTraceEnable());
+
+	// owner still has all of it
+	EXPECT_EQ(3u, readAll(&tsLink, 0));
+
+	perfTraceStreamStop(&tsLink);
+	EXPECT_TRUE(perfTraceStreamStart(&sdCard));
+	EXPECT_FALSE(perfTraceStreamStart(&tsLink));
+	perfTraceStreamStop(&sdCard);
+}
+
+TEST(PerfTrace, streamStopsOnceOwnerIsIdle) {
+	setTimeNowUs(0);
+	ASSERT_TRUE(perfTraceStreamStart(&tsLink));
+
+	// reading keeps it going
+	setTimeNowUs(MS2US(PERF_TRACE_STREAM_IDLE_TIMEOUT_MS));
+	EXPECT_EQ(0u, readAll(&tsLink, 0));
+	setTimeNowUs(MS2US(2 * PERF_TRACE_STREAM_IDLE_TIMEOUT_MS));
+	perfTraceStreamStopIfIdle(&tsLink);
+	// somebody else's timer has no say
+	setTimeNowUs(MS2US(3 * PERF_TRACE_STREAM_IDLE_TIMEOUT_MS));
+	perfTraceStreamStopIfIdle(&sdCard);
+	EXPECT_TRUE(perfTraceIsStreaming());
+
+	perfTraceStreamStopIfIdle(&tsLink);
+	EXPECT_FALSE(perfTraceIsStreaming());
+	EXPECT_EQ(BigBufferUser::None, getBigBufferCurrentUser());
+	EXPECT_TRUE(perfTraceStreamStart(&sdCard));
+	perfTraceStreamStop(&sdCard);
+}
@@ -0,0 +1,180 @@
+#include "pch.h"
+#include "pwm_group.h"
+
+static void startGroupedPwm(PwmGroup& group, SimplePwm& pwm, TestExecutor& executor, OutputPin& pin, float dutyCycle) {
+	pwm.m_group = &group;
+	startSimplePwm(&pwm, "unit_test", &executor, &pin, 1000 /* frequency */, dutyCycle);
+}
+
+TEST(PwmGroup, sharedTimeline) {
+	setTimeNowUs(0);
+
+	PwmGroup group("test group");
+	TestExecutor executor;
+
+	OutputPin pin1;
+	SimplePwm pwm1("pwm1");
+	startGroupedPwm(group, pwm1, executor, pin1, 0.5);
+
+	OutputPin pin2;
+	SimplePwm pwm2("pwm2");
+	startGroupedPwm(group, pwm2, executor, pin2, 0.25);
+
+	EXPECT_EQ(2u, group.getMemberCount());
+	EXPECT_TRUE(pin1.currentLogicValue);
+	EXPECT_TRUE(pin2.currentLogicValue);
+	// one event for the whole group
+	ASSERT_EQ(1, executor.size());
+	EXPECT_EQ(250, executor.getHead()->getMomentUs());
+
+	setTimeNowUs(250);
+	ASSERT_EQ(1, executor.executeAll(250));
+	EXPECT_TRUE(pin1.currentLogicValue);
+	EXPECT_FALSE(pin2.currentLogicValue);
+	EXPECT_EQ(500, executor.getHead()->getMomentUs());
+
+	setTimeNowUs(500);
+	ASSERT_EQ(1, executor.executeAll(500));
+	EXPECT_FALSE(pin1.currentLogicValue);
+	EXPECT_FALSE(pin2.currentLogicValue);
+	EXPECT_EQ(1000, executor.getHead()->getMomentUs());
+
+	// both rising edges on the same event
+	uint32_t toggles = group.toggleCounter;
+	setTimeNowUs(1000);
+	ASSERT_EQ(1, executor.executeAll(1000));
+	EXPECT_TRUE(pin1.currentLogicValue);
+	EXPECT_TRUE(pin2.currentLogicValue);
+	EXPECT_EQ(toggles + 2, group.toggleCounter);
+	EXPECT_EQ(2u, group.maxBatch);
+	ASSERT_EQ(1, executor.size());
+}
+
+TEST(PwmGroup, sameFrequencyLinesUp) {
+	setTimeNowUs(0);
+
+	PwmGroup group("test group");
+	TestExecutor executor;
+
+	OutputPin pin1;
+	SimplePwm pwm1("pwm1");
+	startGroupedPwm(group, pwm1, executor, pin1, 0.5);
+
+	// joining mid cycle: nothing happens until the next cycle start of pwm1
+	setTimeNowUs(300);
+	OutputPin pin2;
+	SimplePwm pwm2("pwm2");
+	startGroupedPwm(group, pwm2, executor, pin2, 0.25);
+
+	EXPECT_FALSE(pin2.currentLogicValue);
+	EXPECT_EQ(US2NT(500), group.getNextSwitchNt(0));
+	EXPECT_EQ(US2NT(1000), group.getNextSwitchNt(1));
+
+	setTimeNowUs(500);
+	executor.executeAll(500);
+	EXPECT_FALSE(pin1.currentLogicValue);
+	EXPECT_FALSE(pin2.currentLogicValue);
+
+	// first pulse of pwm2 is a regular one, rising together with pwm1
+	setTimeNowUs(1000);
+	ASSERT_EQ(1, executor.executeAll(1000));
+	EXPECT_TRUE(pin1.currentLogicValue);
+	EXPECT_TRUE(pin2.currentLogicValue);
+	EXPECT_EQ(2u, group.maxBatch);
+	EXPECT_EQ(US2NT(1250), group.getNextSwitchNt(1));
+
+	for (int us = 1250; us <= 2000; us += 250) {
+		setTimeNowUs(us);
+		executor.executeAll(us);
+	}
+
+	// from now on every rising edge is shared
+	EXPECT_EQ(US2NT(2250), group.getNextSwitchNt(1));
+	EXPECT_EQ(US2NT(2500), group.getNextSwitchNt(0));
+	EXPECT_TRUE(pin1.currentLogicValue);
+	EXPECT_TRUE(pin2.currentLogicValue);
+}
+
+TEST(PwmGroup, stop) {
+	setTimeNowUs(0);
+
+	PwmGroup group("test group");
+	TestExecutor executor;
+
+	OutputPin pin1;
+	SimplePwm pwm1("pwm1");
+	startGroupedPwm(group, pwm1, executor, pin1, 0.5);
+
+	OutputPin pin2;
+	SimplePwm pwm2("pwm2");
+	startGroupedPwm(group, pwm2, executor, pin2, 0.25);
+
+	pwm2.stop();
+	setTimeNowUs(250);
+	executor.executeAll(250);
+	EXPECT_EQ(0, group.getNextSwitchNt(1));
+	EXPECT_EQ(US2NT(500), group.getNextSwitchNt(0));
+	ASSERT_EQ(1, executor.size());
+
+	// stopped slot is taken by the next one
+	OutputPin pin3;
+	SimplePwm pwm3("pwm3");
+	startGroupedPwm(group, pwm3, executor, pin3, 0.5);
+	EXPECT_EQ(2u, group.getMemberCount());
+	EXPECT_EQ(&pwm3, group.getMember(1));
+
+	pwm1.stop();
+	pwm3.stop();
+	setTimeNowUs(500);
+	executor.executeAll(500);
+	setTimeNowUs(1500);
+	executor.executeAll(1500);
+	// nothing left to run
+	EXPECT_EQ(0, executor.size());
+}
+
+TEST(PwmGroup, differentFrequencyStartsRightAway) {
+	setTimeNowUs(0);
+
+	PwmGroup group("test group");
+	TestExecutor executor;
+
+	OutputPin pin1;
+	SimplePwm pwm1("pwm1");
+	startGroupedPwm(group, pwm1, executor, pin1, 0.5);
+
+	setTimeNowUs(300);
+	OutputPin pin2;
+	SimplePwm pwm2("pwm2");
+	pwm2.m_group = &group;
+	startSimplePwm(&pwm2, "unit_test", &executor, &pin2, 500 /* frequency */, 0.5);
+
+	// no grid to line up with
+	EXPECT_TRUE(pin2.currentLogicValue);
+	EXPECT_EQ(US2NT(1300), group.getNextSwitchNt(1));
+}
+
+TEST(PwmGroup, reset) {
+	setTimeNowUs(0);
+
+	PwmGroup group("test group");
+	OutputPin pin1;
+	SimplePwm pwm1("pwm1");
+
+	{
+		TestExecutor executor;
+		startGroupedPwm(group, pwm1, executor, pin1, 0.5);
+		ASSERT_EQ(1, executor.size());
+		// executor goes away with our event in it
+		group.reset();
+	}
+
+	EXPECT_EQ(0u, group.getMemberCount());
+
+	// a fresh executor is fine, including the cancel of an event which is not there
+	TestExecutor executor;
+	startGroupedPwm(group, pwm1, executor, pin1, 0.5);
+	EXPECT_EQ(1u, group.getMemberCount());
+	ASSERT_EQ(1, executor.size());
+	EXPECT_EQ(500, executor.getHead()->getMomentUs());
+}
@@ -0,0 +1,55 @@
+#include "pch.h"
+#include "unit_test_logger.h"
+#include "shard_runner.h"
+
+static const char *SHARD_REPORT =
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<testsuites tests=\"2\" failures=\"1\" disabled=\"1\" errors=\"0\" time=\"0.25\" timestamp=\"2023-01-01T00:00:00\" name=\"AllTests\">\n"
+	"  <testsuite name=\"Suite\" tests=\"2\" failures=\"1\" disabled=\"1\" errors=\"0\" time=\"0.25\">\n"
+	"    <testcase name=\"a\" status=\"run\" result=\"completed\" time=\"0.1\" classname=\"Suite\" />\n"
+	"  </testsuite>\n"
+	"</testsuites>\n";
+
+TEST(ShardRunner, mergeReports) {
+	GtestReport report;
+	ASSERT_TRUE(appendGtestReport(SHARD_REPORT, report));
+	ASSERT_TRUE(appendGtestReport(SHARD_REPORT, report));
+	EXPECT_FALSE(appendGtestReport("", report));
+	EXPECT_FALSE(appendGtestReport("<testsuites tests=\"1\">", report));
+
+	EXPECT_EQ(4, report.tests);
+	EXPECT_EQ(2, report.failures);
+	EXPECT_EQ(2, report.disabled);
+	EXPECT_NEAR(0.5, report.time, 1e-6);
+
+	appendShardFailure(report, 7, "shard timed out <after> 2s");
+	EXPECT_EQ(5, report.tests);
+	EXPECT_EQ(3, report.failures);
+
+	std::string xml = formatGtestReport(report);
+	EXPECT_NE(std::string::npos, xml.find("<testsuites tests=\"5\" failures=\"3\""));
+	EXPECT_NE(std::string::npos, xml.find("<testsuite name=\"shard_7\""));
+	EXPECT_NE(std::string::npos, xml.find("timed out &lt;after&gt; 2s"));
+
+	// merged report merges again
+	GtestReport again;
+	ASSERT_TRUE(appendGtestReport(xml, again));
+	EXPECT_EQ(5, again.tests);
+	EXPECT_EQ(report.testSuites, again.testSuites);
+}
+
+TEST(ShardRunner, countListedTests) {
+	const char *listing =
+		"Suite.\n"
+		"  a\n"
+		"  DISABLED_b\n"
+		"Param/Suite.  # TypeParam = int\n"
+		"  c/0  # GetParam() = 1\n"
+		"  c/1  # GetParam() = 2\n"
+		"DISABLED_Suite.\n"
+		"  d\n";
+
+	EXPECT_EQ(3, countListedTests(listing, false));
+	EXPECT_EQ(5, countListedTests(listing, true));
+	EXPECT_EQ(0, countListedTests("", false));
+}
@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "tunerstudio.h"
 #include "tunerstudio_io.h"
+#include "live_data_delta.h"
+#include "event_timing_stats.h"
 
 static uint8_t st5TestBuffer[16000];
 
@@ -84,3 +86,206 @@ TEST(TunerstudioCommands, writeChunkEngineConfig) {
 
 	EXPECT_EQ(configBytes[100], 50);
 }
+
+#define DELTA_TEST_SIZE 1000
+
+// what a client does with our responses
+static void applyLiveDataDelta(uint8_t* clientCopy, size_t offset, const uint8_t* payload, size_t size) {
+	if (payload[0] == LIVE_DATA_KEYFRAME) {
+		memcpy(clientCopy + offset, payload + LIVE_DATA_DELTA_HEADER_SIZE, size - LIVE_DATA_DELTA_HEADER_SIZE);
+		return;
+	}
+
+	ASSERT_EQ(LIVE_DATA_DELTA, payload[0]);
+	size_t position = offset;
+	for (size_t i = LIVE_DATA_DELTA_HEADER_SIZE; i < size;) {
+		position += payload[i++];
+		size_t length = payload[i++];
+		memcpy(clientCopy + position, payload + i, length);
+		position += length;
+		i += length;
+	}
+}
+
+TEST(binary, liveDataDelta) {
+	static uint8_t ecuData[DELTA_TEST_SIZE];
+	static uint8_t clientCopy[DELTA_TEST_SIZE];
+	static uint8_t payload[DELTA_TEST_SIZE + LIVE_DATA_DELTA_HEADER_SIZE];
+	static LiveDataDelta<DELTA_TEST_SIZE> dut;
+
+	auto read = [](uint8_t* destination, size_t offset, size_t size) {
+		memcpy(destination, ecuData + offset, size);
+	};
+
+	for (size_t i = 0; i < DELTA_TEST_SIZE; i++) {
+		ecuData[i] = i * 7;
+	}
+
+	// first response is a keyframe
+	size_t size = dut.encode(100, 800, 0, read, payload);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, payload[0]);
+	EXPECT_EQ(802u, size);
+	applyLiveDataDelta(clientCopy, 100, payload, size);
+
+	// nothing changed: only the header
+	EXPECT_EQ(2u, dut.encode(100, 800, 0, read, payload));
+	EXPECT_EQ(LIVE_DATA_DELTA, payload[0]);
+
+	// few scattered changes, one long gap and one long run
+	ecuData[100]++;
+	ecuData[101]++;
+	ecuData[500]++;
+	for (size_t i = 600; i < 880; i++) {
+		ecuData[i]++;
+	}
+	size = dut.encode(100, 800, 0, read, payload);
+	EXPECT_EQ(LIVE_DATA_DELTA, payload[0]);
+	EXPECT_LT(size, 300u);
+	applyLiveDataDelta(clientCopy, 100, payload, size);
+	EXPECT_EQ(0, memcmp(clientCopy + 100, ecuData + 100, 800));
+
+	// sub-range of what the client already has is still a delta
+	ecuData[150]++;
+	size = dut.encode(120, 100, 0, read, payload);
+	EXPECT_EQ(LIVE_DATA_DELTA, payload[0]);
+	applyLiveDataDelta(clientCopy, 120, payload, size);
+	EXPECT_EQ(0, memcmp(clientCopy + 100, ecuData + 100, 800));
+
+	// everything changed: fall back to a keyframe, never larger than that
+	for (size_t i = 0; i < DELTA_TEST_SIZE; i += 2) {
+		ecuData[i]++;
+	}
+	size = dut.encode(100, 800, 0, read, payload);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, payload[0]);
+	EXPECT_EQ(802u, size);
+	EXPECT_EQ(1u, dut.fallbackCounter);
+	applyLiveDataDelta(clientCopy, 100, payload, size);
+	EXPECT_EQ(0, memcmp(clientCopy + 100, ecuData + 100, 800));
+
+	// range never sent before, client request and a new client all get a keyframe
+	dut.encode(0, 200, 0, read, payload);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, payload[0]);
+	dut.encode(0, 200, LIVE_DATA_FORCE_KEYFRAME, read, payload);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, payload[0]);
+	dut.encode(0, 200, 0, read, payload);
+	EXPECT_EQ(LIVE_DATA_DELTA, payload[0]);
+	dut.reset();
+	dut.encode(0, 200, 0, read, payload);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, payload[0]);
+
+	// periodic keyframe
+	int deltas = 0;
+	for (int i = 0; i < LIVE_DATA_KEYFRAME_PERIOD; i++) {
+		dut.encode(0, 200, 0, read, payload);
+		deltas += payload[0] == LIVE_DATA_DELTA;
+	}
+	EXPECT_EQ(LIVE_DATA_KEYFRAME_PERIOD - 1, deltas);
+}
+
+TEST(TunerstudioCommands, outputChannelsSubscription) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	BufferTsChannel channel;
+	TunerStudio instance;
+
+	engine->outputChannels.RPMValue = 1234;
+
+	uint16_t rpmOffset = offsetof(output_channels_s, RPMValue);
+	// period 10ms: RPM as 2 bytes (type 2), first byte of output channels (type 1)
+	uint16_t request[] = { 10, (uint16_t)((2 << 13) | rpmOffset), (1 << 13) | 0 };
+
+	setTimeNowUs(1000);
+	instance.handleSubscribeCommand(&channel, reinterpret_cast<uint8_t*>(request), sizeof(request));
+	// acknowledged with an empty OK
+	ASSERT_EQ(7u, channel.writeIdx);
+	EXPECT_EQ(TS_RESPONSE_OK, st5TestBuffer[2]);
+
+	// first snapshot right away
+	channel.reset();
+	instance.pushSubscription(&channel);
+	ASSERT_EQ(7u + 4 + 2 + 1, channel.writeIdx);
+	EXPECT_EQ(TS_RESPONSE_OUTPUT_PUSH, st5TestBuffer[2]);
+	uint16_t rpm;
+	memcpy(&rpm, &st5TestBuffer[3 + 4], sizeof(rpm));
+	EXPECT_EQ(1234, rpm);
+
+	// nothing until the period has passed
+	channel.reset();
+	advanceTimeUs(5000);
+	instance.pushSubscription(&channel);
+	EXPECT_EQ(0u, channel.writeIdx);
+
+	advanceTimeUs(5000);
+	instance.pushSubscription(&channel);
+	EXPECT_EQ(14u, channel.writeIdx);
+	EXPECT_EQ(2u, channel.subscription.pushCounter);
+
+	// client went quiet for too long
+	advanceTimeUs(MS2US(LIVE_DATA_SUBSCRIPTION_TIMEOUT_MS));
+	EXPECT_FALSE(channel.subscription.isActive(getTimeNowNt()));
+
+	// offset beyond output channels is refused
+	uint16_t badRequest[] = { 10, (uint16_t)((4 << 13) | (TS_TOTAL_OUTPUT_SIZE - 4)) };
+	channel.reset();
+	instance.handleSubscribeCommand(&channel, reinterpret_cast<uint8_t*>(badRequest), sizeof(badRequest));
+	EXPECT_EQ(TS_RESPONSE_OUT_OF_RANGE, st5TestBuffer[2]);
+	EXPECT_FALSE(channel.subscription.isActive(getTimeNowNt()));
+}
+
+TEST(TunerstudioCommands, outputChannelsDeltaLinkSwitch) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	BufferTsChannel usb;
+	BufferTsChannel bluetooth;
+	TunerStudio instance;
+
+	instance.cmdOutputChannelsDelta(&usb, 0, 100, 0);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, st5TestBuffer[3]);
+	usb.reset();
+	instance.cmdOutputChannelsDelta(&usb, 0, 100, 0);
+	EXPECT_EQ(LIVE_DATA_DELTA, st5TestBuffer[3]);
+
+	// second client starts from a keyframe
+	instance.cmdOutputChannelsDelta(&bluetooth, 0, 100, 0);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, st5TestBuffer[3]);
+	bluetooth.reset();
+	instance.cmdOutputChannelsDelta(&bluetooth, 0, 100, 0);
+	EXPECT_EQ(LIVE_DATA_DELTA, st5TestBuffer[3]);
+
+	// and so does the first one once it is back since there is only one baseline
+	usb.reset();
+	instance.cmdOutputChannelsDelta(&usb, 0, 100, 0);
+	EXPECT_EQ(LIVE_DATA_KEYFRAME, st5TestBuffer[3]);
+	usb.reset();
+	instance.cmdOutputChannelsDelta(&usb, 0, 100, 0);
+	EXPECT_EQ(LIVE_DATA_DELTA, st5TestBuffer[3]);
+}
+
+TEST(TunerstudioCommands, eventTiming) {
+	BufferTsChannel channel;
+	TunerStudio instance;
+
+	resetEventTiming();
+	recordEventTiming(EventClass::Spark, US2NT(3), US2NT(20));
+
+	uint8_t keep = 0;
+	instance.handleEventTimingCommand(&channel, &keep, sizeof(keep));
+	ASSERT_EQ(7u + sizeof(event_timing_report_s), channel.writeIdx);
+	EXPECT_EQ(TS_RESPONSE_OK, st5TestBuffer[2]);
+
+	event_timing_report_s report;
+	memcpy(&report, &st5TestBuffer[3], sizeof(report));
+	EXPECT_EQ(EVENT_TIMING_BUCKET_COUNT, report.bucketCount);
+	EXPECT_EQ(1u, report.classes[(size_t)EventClass::Spark].count);
+	EXPECT_EQ(1u, report.classes[(size_t)EventClass::Spark].lateness.buckets[2]);
+
+	// read and reset
+	uint8_t reset = 1;
+	channel.reset();
+	instance.handleEventTimingCommand(&channel, &reset, sizeof(reset));
+	memcpy(&report, &st5TestBuffer[3], sizeof(report));
+	EXPECT_EQ(1u, report.classes[(size_t)EventClass::Spark].count);
+
+	channel.reset();
+	instance.handleEventTimingCommand(&channel, nullptr, 0);
+	memcpy(&report, &st5TestBuffer[3], sizeof(report));
+	EXPECT_EQ(0u, report.classes[(size_t)EventClass::Spark].count);
+}
@@ -4,6 +4,7 @@ TESTS_SRC_CPP = \
 	tests/trigger/test_symmetrical_crank.cpp \
 	tests/trigger/test_trigger_decoder.cpp \
 	tests/trigger/test_trigger_decoder_2.cpp \
+	tests/trigger/test_trigger_log_replay.cpp \
 	tests/trigger/test_coil.cpp \
 	tests/trigger/test_trigger_noiseless.cpp \
 	tests/trigger/test_trigger_multi_sync.cpp \
@@ -38,14 +39,17 @@ TESTS_SRC_CPP = \
 	tests/trigger/test_nissan_vq_vvt.cpp \
 	tests/trigger/test_override_gaps.cpp \
 	tests/trigger/test_injection_scheduling.cpp \
+	tests/trigger/test_trigger_scheduler.cpp \
 	tests/sent/test_sent.cpp \
 	tests/ignition_injection/injection_mode_transition.cpp \
 	tests/ignition_injection/test_startOfCrankingPrimingPulse.cpp \
 	tests/ignition_injection/test_multispark.cpp \
 	tests/ignition_injection/test_hd_cranking.cpp \
 	tests/ignition_injection/test_ignition_scheduling.cpp \
+	tests/ignition_injection/test_event_phase_index.cpp \
 	tests/ignition_injection/test_fuelCut.cpp \
 	tests/ignition_injection/test_fuel_computer.cpp \
+	tests/ignition_injection/test_incremental_engine_state.cpp \
 	tests/ignition_injection/test_injector_model.cpp \
 	tests/ignition_injection/test_odd_firing_engine.cpp \
 	tests/ignition_injection/test_three_cylinder.cpp \
@@ -107,9 +111,12 @@ TESTS_SRC_CPP = \
 	tests/lua/test_lua_hooks.cpp \
 	tests/lua/test_lua_Leiderman_Khlystov.cpp \
 	tests/lua/test_can_filter.cpp \
+	tests/lua/test_lua_can_rx.cpp \
 	tests/lua/test_lua_vin.cpp \
 	tests/test_change_engine_type.cpp \
 	tests/test_big_buffer.cpp \
+	tests/test_perf_trace.cpp \
+	tests/test_engine_module_profiler.cpp \
 	tests/system/test_periodic_thread_controller.cpp \
 	tests/test_util.cpp \
 	tests/test_start_stop.cpp \
@@ -129,6 +136,8 @@ TESTS_SRC_CPP = \
 	tests/test_one_cylinder_logic.cpp \
 	tests/test_tunerstudio.cpp \
 	tests/test_pwm_generator.cpp \
+	tests/test_pwm_group.cpp \
+	tests/test_shard_runner.cpp \
 	tests/test_log_buffer.cpp \
 	tests/test_event_queue.cpp \
 	tests/test_cpp_memory_layout.cpp \
@@ -141,6 +150,7 @@ TESTS_SRC_CPP = \
 	tests/test_lambda_monitor.cpp \
 	tests/sensor/basic_sensor.cpp \
 	tests/sensor/func_sensor.cpp \
+	tests/sensor/test_adc_subscription.cpp \
 	tests/sensor/function_pointer_sensor.cpp \
 	tests/sensor/mock_sensor.cpp \
 	tests/sensor/sensor_reader.cpp \
@@ -158,6 +168,8 @@ TESTS_SRC_CPP = \
 	tests/test_fuel_math.cpp \
 	tests/test_binary_log.cpp \
 	tests/binary_log/test_bit_logger_field.cpp \
+	tests/binary_log/test_mlg_record_ring.cpp \
+	tests/binary_log/test_mlg_row_filter.cpp \
 	tests/test_dynoview.cpp \
 	tests/test_gpio.cpp \
 	tests/test_limp.cpp \
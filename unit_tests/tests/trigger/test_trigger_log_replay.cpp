@@ -0,0 +1,167 @@
+#include "pch.h"
+
+#include "trigger_log_replay.h"
+
+#define REPLAY_CAPTURE "tests/trigger/resources/4b11-running.csv"
+
+struct ReplayResult {
+	int synchronizations;
+	uint32_t triggerErrors;
+	float rpm;
+	efitimeus_t timeUs;
+};
+
+static ReplayResult getReplayResult() {
+	return {
+		engine->triggerCentral.triggerState.getSynchronizationCounter(),
+		engine->triggerCentral.triggerState.totalTriggerErrorCounter,
+		Sensor::getOrZero(SensorType::Rpm),
+		getTimeNowUs(),
+	};
+}
+
+static void setup4b11() {
+	engineConfiguration->isFasterEngineSpinUpEnabled = true;
+	engineConfiguration->alwaysInstantRpm = true;
+}
+
+TEST(TriggerLogReplay, sameAsCsvReader) {
+	ReplayResult expected;
+	{
+		CsvReader reader(1, /* vvtCount */ 0);
+		reader.open(REPLAY_CAPTURE);
+		EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+		setup4b11();
+		eth.setTriggerType(trigger_type_e::TT_36_2_1);
+
+		while (reader.haveMore()) {
+			reader.processLine(&eth);
+		}
+		expected = getReplayResult();
+	}
+
+	TriggerEdgeStream stream;
+	ASSERT_TRUE(stream.loadCsv(REPLAY_CAPTURE, 1));
+
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	setup4b11();
+	eth.setTriggerType(trigger_type_e::TT_36_2_1);
+
+	TriggerLogReplay replay(stream, 1, /* vvtCount */ 0);
+	bool gotRpm = false;
+	// a few samples at a time, like a test checking something along the way would
+	while (replay.haveMore()) {
+		replay.replay(&eth, 5);
+
+		if (!gotRpm && Sensor::getOrZero(SensorType::Rpm)) {
+			gotRpm = true;
+			EXPECT_NEAR(1436, Sensor::getOrZero(SensorType::Rpm), 1);
+		}
+	}
+	EXPECT_TRUE(gotRpm);
+
+	ReplayResult actual = getReplayResult();
+	EXPECT_GT(actual.synchronizations, 0);
+	EXPECT_EQ(expected.synchronizations, actual.synchronizations);
+	EXPECT_EQ(expected.triggerErrors, actual.triggerErrors);
+	EXPECT_FLOAT_EQ(expected.rpm, actual.rpm);
+	EXPECT_EQ(expected.timeUs, actual.timeUs);
+	ASSERT_EQ(0, eth.recentWarnings()->getCount());
+}
+
+TEST(TriggerLogReplay, binaryStream) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	TriggerEdgeStream stream;
+	ASSERT_TRUE(stream.loadCsv(REPLAY_CAPTURE, 1));
+	ASSERT_GT(stream.size(), 1000u);
+	// first sample of the capture
+	EXPECT_EQ(5'217'579, stream.getStartUs());
+	EXPECT_EQ(1, stream.getStates(0));
+	EXPECT_EQ(550, stream.getDeltaUs(1));
+	EXPECT_EQ(0, stream.getStates(1));
+
+	const char *fileName = TEST_RESULTS_DIR "/4b11-running.edges";
+	ASSERT_TRUE(stream.saveBinary(fileName));
+
+	TriggerEdgeStream copy;
+	ASSERT_TRUE(copy.loadBinary(fileName));
+	ASSERT_EQ(stream.size(), copy.size());
+	EXPECT_EQ(stream.getStartUs(), copy.getStartUs());
+	EXPECT_EQ(stream.getDurationUs(), copy.getDurationUs());
+	for (size_t i = 0; i < stream.size(); i++) {
+		ASSERT_EQ(stream.getDeltaUs(i), copy.getDeltaUs(i)) << i;
+		ASSERT_EQ(stream.getStates(i), copy.getStates(i)) << i;
+	}
+
+	EXPECT_FALSE(copy.loadBinary(REPLAY_CAPTURE));
+}
+
+TEST(TriggerLogReplay, longPause) {
+	const char *fileName = TEST_RESULTS_DIR "/long-pause.csv";
+	{
+		FILE *fp = fopen(fileName, "w");
+		ASSERT_TRUE(fp != nullptr);
+		// key on, then cranking more than an hour later
+		fprintf(fp, "Time [s],Channel 0\n0,1\n0.001,0\n5000.001,1\n5000.002,0\n");
+		fclose(fp);
+	}
+
+	TriggerEdgeStream stream;
+	ASSERT_TRUE(stream.loadCsv(fileName, 1));
+	EXPECT_EQ(5'000'002'000, stream.getDurationUs());
+
+	int64_t durationUs = 0;
+	int edges = 0;
+	for (size_t i = 0; i < stream.size(); i++) {
+		EXPECT_GE(stream.getDeltaUs(i), 0) << i;
+		durationUs += stream.getDeltaUs(i);
+		if (i > 0 && stream.getStates(i) != stream.getStates(i - 1)) {
+			edges++;
+		}
+	}
+	EXPECT_EQ(stream.getDurationUs(), durationUs);
+	EXPECT_EQ(3, edges);
+	EXPECT_EQ(0, stream.getStates(stream.size() - 1));
+}
+
+TEST(TriggerLogReplay, startBeforeNow) {
+	const char *fileName = TEST_RESULTS_DIR "/start-before-now.csv";
+	{
+		FILE *fp = fopen(fileName, "w");
+		ASSERT_TRUE(fp != nullptr);
+		fprintf(fp, "Time [s],Channel 0\n0.001,1\n0.002,0\n");
+		fclose(fp);
+	}
+
+	TriggerEdgeStream stream;
+	ASSERT_TRUE(stream.loadCsv(fileName, 1));
+
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	eth.moveTimeForwardSec(1);
+	efitimeus_t nowUs = getTimeNowUs();
+	ASSERT_GT(nowUs, stream.getStartUs());
+
+	// time never goes back, the rest of the capture keeps its spacing
+	TriggerLogReplay replay(stream, 1, /* vvtCount */ 0);
+	EXPECT_EQ(1u, replay.replay(&eth, 1));
+	EXPECT_EQ(nowUs, getTimeNowUs());
+	EXPECT_EQ(1u, replay.replay(&eth, 1));
+	EXPECT_EQ(nowUs + 1000, getTimeNowUs());
+}
+
+TEST(TriggerLogReplay, decoderOnly) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	eth.setTriggerType(trigger_type_e::TT_36_2_1);
+
+	TriggerEdgeStream stream;
+	ASSERT_TRUE(stream.loadCsv(REPLAY_CAPTURE, 1));
+
+	TriggerDecoderBase decoder("test");
+	TriggerLogDecodeStats stats = decodeTriggerLog(stream, 1, decoder,
+		engine->triggerCentral.triggerShape, engine->triggerCentral.primaryTriggerConfiguration);
+
+	EXPECT_GT(stats.edges, 1000u);
+	EXPECT_GT(stats.synchronizations, 10);
+	EXPECT_EQ(0u, stats.triggerErrors);
+}
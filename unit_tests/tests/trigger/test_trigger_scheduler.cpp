@@ -0,0 +1,91 @@
+/*
+ * @file test_trigger_scheduler.cpp
+ */
+
+#include "pch.h"
+
+static void noopAction(AngleBasedEvent *) {
+}
+
+TEST(TriggerScheduler, firesOnlyEventsWithinToothWindow) {
+	AngleBasedEvent early, late, wrapped;
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engine->rpmCalculator.setRpmValue(1000);
+	auto scheduler = engine->module<TriggerScheduler>();
+
+	scheduler->schedule("early", &early, 10, { noopAction, &early });
+	scheduler->schedule("late", &late, 400, { noopAction, &late });
+	scheduler->schedule("wrapped", &wrapped, 715, { noopAction, &wrapped });
+
+	scheduler->scheduleEventsUntilNextTriggerTooth(1000, 0, 0, 20);
+	EXPECT_EQ(AngleBasedEvent::NOT_QUEUED, early.toothBucket);
+	EXPECT_NE(AngleBasedEvent::NOT_QUEUED, late.toothBucket);
+	EXPECT_NE(AngleBasedEvent::NOT_QUEUED, wrapped.toothBucket);
+
+	// window wraps around the end of the cycle
+	scheduler->scheduleEventsUntilNextTriggerTooth(1000, 0, 710, 5);
+	EXPECT_NE(AngleBasedEvent::NOT_QUEUED, late.toothBucket);
+	EXPECT_EQ(AngleBasedEvent::NOT_QUEUED, wrapped.toothBucket);
+}
+
+TEST(TriggerScheduler, rescheduleMovesEventToNewBucket) {
+	AngleBasedEvent event;
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engine->rpmCalculator.setRpmValue(1000);
+	auto scheduler = engine->module<TriggerScheduler>();
+
+	scheduler->schedule("first", &event, 100, { noopAction, &event });
+	scheduler->schedule("second", &event, 500, { noopAction, &event });
+
+	// nothing left at the old angle
+	scheduler->scheduleEventsUntilNextTriggerTooth(1000, 0, 90, 110);
+	EXPECT_NE(AngleBasedEvent::NOT_QUEUED, event.toothBucket);
+
+	scheduler->scheduleEventsUntilNextTriggerTooth(1000, 0, 490, 510);
+	EXPECT_EQ(AngleBasedEvent::NOT_QUEUED, event.toothBucket);
+}
+
+/**
+ * 12 cylinders worth of pending events on a 60-2 wheel: compare how many pending events
+ * are visited per tooth against scanning the whole list like we used to
+ */
+TEST(TriggerScheduler, scannedEventsPerTooth) {
+	AngleBasedEvent events[36];
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+	engine->rpmCalculator.setRpmValue(8000);
+	auto scheduler = engine->module<TriggerScheduler>();
+
+	for (size_t i = 0; i < efi::size(events); i++) {
+		scheduler->schedule("test", &events[i], i * 20 + 3, { noopAction, &events[i] });
+	}
+
+	const int toothCount = 120;
+	const float toothAngle = 720.0f / toothCount;
+	uint32_t fullScanCounter = 0;
+	int firedCounter = 0;
+	scheduler->scannedEventsCounter = 0;
+
+	for (int tooth = 0; tooth < toothCount; tooth++) {
+		// the whole list used to be visited on every tooth
+		fullScanCounter += efi::size(events);
+
+		float currentPhase = tooth * toothAngle;
+		float nextPhase = (tooth + 1) % toothCount * toothAngle;
+		scheduler->scheduleEventsUntilNextTriggerTooth(8000, 0, currentPhase, nextPhase);
+
+		// put fired events back for the next cycle
+		for (size_t i = 0; i < efi::size(events); i++) {
+			if (events[i].toothBucket == AngleBasedEvent::NOT_QUEUED) {
+				firedCounter++;
+				scheduler->schedule("test", &events[i], i * 20 + 3, { noopAction, &events[i] });
+			}
+		}
+	}
+
+	// every event fired exactly once per cycle
+	EXPECT_EQ((int)efi::size(events), firedCounter);
+
+	// about 1.4 events per tooth instead of all 36
+	EXPECT_EQ(4320u, fullScanCounter);
+	EXPECT_EQ(172u, scheduler->scannedEventsCounter);
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "adc_decimator.h"
+
+TEST(AdcDecimator, burstSum) {
+	// three channels, burst of four
+	uint16_t samples[] = {
+		100, 2000, 7,
+		101, 2001, 7,
+		102, 2002, 7,
+		103, 2003, 7,
+	};
+
+	EXPECT_EQ(406u, sumAdcBurst(samples, 0, 3, 4));
+	EXPECT_EQ(8006u, sumAdcBurst(samples, 1, 3, 4));
+	EXPECT_EQ(28u, sumAdcBurst(samples, 2, 3, 4));
+	// depth of one is a plain read
+	EXPECT_EQ(2000u, sumAdcBurst(samples, 1, 3, 1));
+}
+
+TEST(AdcDecimator, passthru) {
+	AdcDecimator<2> decimator;
+	EXPECT_EQ(0, decimator.getLatency());
+
+	for (uint32_t sample : { 5, 4095, 0, 17 }) {
+		ASSERT_TRUE(decimator.add(sample));
+		EXPECT_EQ(sample, decimator.get());
+	}
+}
+
+TEST(AdcDecimator, dcGain) {
+	AdcDecimator<2> decimator;
+	// MAP at 1.6V, burst of four
+	decimator.configure(8, 4);
+
+	int outputs = 0;
+	for (int i = 0; i < 8 * 10; i++) {
+		if (decimator.add(4 * 1985)) {
+			outputs++;
+			if (outputs > 2) {
+				// settled after TOrder outputs
+				EXPECT_FLOAT_EQ(1985, decimator.get());
+			}
+		}
+	}
+	EXPECT_EQ(10, outputs);
+}
+
+TEST(AdcDecimator, resolution) {
+	AdcDecimator<1> decimator;
+	decimator.configure(16);
+
+	// dithered 1000.25: a quarter of the samples one LSB up
+	for (int i = 0; i < 16; i++) {
+		bool hasOutput = decimator.add(i % 4 == 0 ? 1001 : 1000);
+		EXPECT_EQ(i == 15, hasOutput);
+	}
+	EXPECT_FLOAT_EQ(1000.25f, decimator.get());
+}
+
+TEST(AdcDecimator, latency) {
+	for (uint32_t ratio : { 2, 4, 5, 16 }) {
+		AdcDecimator<2> decimator;
+		decimator.configure(ratio);
+		EXPECT_FLOAT_EQ(ratio - 1, decimator.getLatency());
+
+		// linear phase: a ramp comes out delayed by exactly the group delay
+		for (uint32_t n = 0; n < 20 * ratio; n++) {
+			if (decimator.add(3 * n) && n >= 2 * ratio) {
+				EXPECT_FLOAT_EQ(3 * (n - decimator.getLatency()), decimator.get()) << ratio << "/" << n;
+			}
+		}
+	}
+}
+
+TEST(AdcDecimator, wrapAround) {
+	AdcDecimator<2> decimator;
+	decimator.configure(64, 4);
+
+	// integrators wrap around many times over, output does not care
+	for (int i = 0; i < 1'000'000; i++) {
+		decimator.add(4 * 4095);
+	}
+	decimator.add(4 * 4095);
+	EXPECT_FLOAT_EQ(4095, decimator.get());
+}
@@ -0,0 +1,58 @@
+#include "pch.h"
+#include "biquad_bank.h"
+
+#define CHANNEL_COUNT 16
+
+// same spread of cutoffs as AdcSubscription users, from fuel level to TPS
+static float getCutoff(size_t channel) {
+	static const float cutoffs[] = { 0.05f, 2, 10, 20, 50, 100, 200 };
+	return cutoffs[channel % efi::size(cutoffs)];
+}
+
+static float getSample(size_t channel, int step) {
+	// something noisy around a per channel level
+	uint32_t seed = (channel + 1) * 2654435761u + step * 40503u;
+	return 0.3f * channel + (seed >> 20) / 4096.0f;
+}
+
+TEST(BiquadBank, matchesBiquad) {
+	EngineTestHelper eth(engine_type_e::TEST_ENGINE);
+
+	Biquad reference[CHANNEL_COUNT];
+	BiquadBank<CHANNEL_COUNT> bank;
+
+	for (size_t i = 0; i < CHANNEL_COUNT; i++) {
+		reference[i].configureLowpass(SLOW_ADC_RATE, getCutoff(i));
+		bank.configure(i, reference[i]);
+
+		float steadyState = getSample(i, 0);
+		reference[i].cookSteadyState(steadyState);
+		bank.cookSteadyState(i, steadyState);
+	}
+
+	float input[CHANNEL_COUNT];
+	float output[CHANNEL_COUNT];
+	for (int step = 0; step < 2000; step++) {
+		for (size_t i = 0; i < CHANNEL_COUNT; i++) {
+			input[i] = getSample(i, step);
+		}
+
+		bank.filter(input, output);
+
+		for (size_t i = 0; i < CHANNEL_COUNT; i++) {
+			// same operations, only FMA contraction could tell them apart: the 0.05Hz one is that sensitive to rounding
+			ASSERT_NEAR(reference[i].filter(input[i]), output[i], 1e-3) << "channel " << i << " step " << step;
+		}
+	}
+}
+
+TEST(BiquadBank, defaultIsPassthru) {
+	BiquadBank<2> bank;
+
+	float input[] = { 1.5f, -3 };
+	float output[2];
+	bank.filter(input, output);
+
+	EXPECT_EQ(1.5f, output[0]);
+	EXPECT_EQ(-3, output[1]);
+}
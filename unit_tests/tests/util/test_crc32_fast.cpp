@@ -0,0 +1,55 @@
+#include "pch.h"
+#include "crc32_fast.h"
+
+static void fillPseudoRandom(uint8_t* buffer, size_t size) {
+	uint32_t seed = 12345;
+	for (size_t i = 0; i < size; i++) {
+		seed = seed * 1664525 + 1013904223;
+		buffer[i] = seed >> 24;
+	}
+}
+
+TEST(util, crc32FastKnownValues) {
+	EXPECT_EQ(0u, crc32Fast(nullptr, 0));
+	EXPECT_EQ(0xd3d99e8bu, crc32Fast("A", 1));
+	EXPECT_EQ(0x4775a7b1u, crc32Fast("AbcDEFGF", 8));
+	EXPECT_EQ(0xCBF43926u, crc32Fast("123456789", 9));
+}
+
+TEST(util, crc32FastMatchesReference) {
+	static uint8_t buffer[4096 + 16];
+	fillPseudoRandom(buffer, sizeof(buffer));
+
+	// every alignment and every tail length of the 8 byte slices
+	for (size_t offset = 0; offset < 8; offset++) {
+		for (size_t size : { 0, 1, 3, 7, 8, 9, 15, 16, 17, 63, 64, 65, 255, 1000, 4096 }) {
+			const uint8_t* data = buffer + offset;
+			uint32_t expected = crc32inc(data, 0, size);
+
+			EXPECT_EQ(expected, crc32Fast(data, size)) << offset << "/" << size;
+			EXPECT_EQ(expected, crc32SoftwareInc(data, 0, size)) << offset << "/" << size;
+			EXPECT_EQ(expected, crc32BytewiseInc(data, 0, size)) << offset << "/" << size;
+		}
+	}
+}
+
+TEST(util, crc32FastIncremental) {
+	static uint8_t buffer[1024];
+	fillPseudoRandom(buffer, sizeof(buffer));
+
+	uint32_t expected = crc32(buffer, sizeof(buffer));
+
+	// any split, including the way TS frames a response: code byte first, then the payload
+	for (size_t split : { 0, 1, 5, 8, 333, 1023, 1024 }) {
+		uint32_t crc = crc32Fast(buffer, split);
+		crc = crc32FastInc(buffer + split, crc, sizeof(buffer) - split);
+		EXPECT_EQ(expected, crc) << split;
+	}
+
+	// scattered read feeds small pieces one at a time
+	uint32_t crc = 0;
+	for (size_t position = 0; position < sizeof(buffer); position += 4) {
+		crc = crc32FastInc(buffer + position, crc, 4);
+	}
+	EXPECT_EQ(expected, crc);
+}
@@ -0,0 +1,42 @@
+#include "pch.h"
+#include "input_tracker.h"
+
+TEST(InputTracker, deadband) {
+	InputTracker<2> tracker{{0.5f, 0}};
+
+	// first call always recomputes
+	EXPECT_TRUE(tracker.update(0, {20, 100}));
+	EXPECT_FALSE(tracker.update(0, {20, 100}));
+	EXPECT_FALSE(tracker.update(0, {20.3f, 100}));
+
+	// drift adds up against the last recomputed input, not the last sample
+	EXPECT_TRUE(tracker.update(0, {20.6f, 100}));
+	EXPECT_FALSE(tracker.update(0, {20.9f, 100}));
+	EXPECT_FALSE(tracker.update(0, {20.2f, 100}));
+
+	// zero deadband, any change counts
+	EXPECT_TRUE(tracker.update(0, {20.6f, 101}));
+
+	EXPECT_EQ(3u, tracker.recomputeCounter);
+	EXPECT_EQ(4u, tracker.skipCounter);
+}
+
+TEST(InputTracker, version) {
+	InputTracker<1> tracker{{1}};
+
+	EXPECT_TRUE(tracker.update(3, {20}));
+	EXPECT_FALSE(tracker.update(3, {20}));
+	// tune has changed, same inputs
+	EXPECT_TRUE(tracker.update(4, {20}));
+	EXPECT_FALSE(tracker.update(4, {20}));
+}
+
+TEST(InputTracker, nan) {
+	InputTracker<1> tracker{{1}};
+
+	EXPECT_TRUE(tracker.update(0, {20}));
+	// sensor has failed
+	EXPECT_TRUE(tracker.update(0, {NAN}));
+	EXPECT_FALSE(tracker.update(0, {NAN}));
+	EXPECT_TRUE(tracker.update(0, {20}));
+}